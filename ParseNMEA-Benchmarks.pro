@@ -0,0 +1,103 @@
+TEMPLATE = app
+CONFIG += console c++2a release
+CONFIG -= app_bundle
+CONFIG -= qt
+
+QMAKE_CXXFLAGS += -std=c++20 -O2 -fvect-cost-model=dynamic -Wall -Wfatal-errors
+
+HEADERS += \
+    benchmarks/benchmark.h \
+    headers/asyncParse.h \
+    headers/blockReading.h \
+    headers/boundedQueue.h \
+    headers/cartesian.h \
+    headers/columnarExport.h \
+    headers/compressedLog.h \
+    headers/compressedTrack.h \
+    headers/densityGrid.h \
+    headers/earth.h \
+    headers/encodeNMEA.h \
+    headers/fix.h \
+    headers/fixFilter.h \
+    headers/fixRuns.h \
+    headers/fixedPosition.h \
+    headers/generator.h \
+    headers/geodesic.h \
+    headers/geofence.h \
+    headers/geometry.h \
+    headers/logIndex.h \
+    headers/logs.h \
+    headers/parseNMEA.h \
+    headers/position.h \
+    headers/replay.h \
+    headers/resample.h \
+    headers/route.h \
+    headers/sharedFix.h \
+    headers/similarity.h \
+    headers/stops.h \
+    headers/trackAnalytics.h \
+    headers/trackStore.h \
+    headers/types.h \
+    headers/workStealing.h
+
+SOURCES += \
+    src/asyncParse.cpp \
+    src/cartesian.cpp \
+    src/columnarExport.cpp \
+    src/compressedLog.cpp \
+    src/compressedTrack.cpp \
+    src/densityGrid.cpp \
+    src/earth.cpp \
+    src/encodeNMEA.cpp \
+    src/fixFilter.cpp \
+    src/fixRuns.cpp \
+    src/fixedPosition.cpp \
+    src/geodesic.cpp \
+    src/geofence.cpp \
+    src/geometry.cpp \
+    src/logIndex.cpp \
+    src/logs.cpp \
+    src/parseNMEA.cpp \
+    src/position.cpp \
+    src/replay.cpp \
+    src/resample.cpp \
+    src/route.cpp \
+    src/sharedFix.cpp \
+    src/similarity.cpp \
+    src/stops.cpp \
+    src/trackAnalytics.cpp \
+    src/trackStore.cpp \
+    src/workStealing.cpp \
+
+SOURCES += \
+    benchmarks/benchmark.cpp \
+    benchmarks/asyncParse-benchmarks.cpp \
+    benchmarks/trackAnalytics-benchmarks.cpp \
+    benchmarks/fixedPosition-benchmarks.cpp \
+    benchmarks/geofence-benchmarks.cpp \
+    benchmarks/route-benchmarks.cpp \
+    benchmarks/fixFilter-benchmarks.cpp \
+    benchmarks/geometry-benchmarks.cpp \
+    benchmarks/cartesian-benchmarks.cpp \
+    benchmarks/geodesic-benchmarks.cpp \
+    benchmarks/lazySentence-benchmarks.cpp \
+    benchmarks/logIndex-benchmarks.cpp \
+    benchmarks/compressedLog-benchmarks.cpp \
+    benchmarks/fixRuns-benchmarks.cpp \
+    benchmarks/columnarExport-benchmarks.cpp \
+    benchmarks/densityGrid-benchmarks.cpp \
+    benchmarks/stops-benchmarks.cpp \
+    benchmarks/resample-benchmarks.cpp \
+    benchmarks/encodeNMEA-benchmarks.cpp \
+    benchmarks/sharedFix-benchmarks.cpp \
+    benchmarks/trackStore-benchmarks.cpp \
+    benchmarks/compressedTrack-benchmarks.cpp \
+    benchmarks/similarity-benchmarks.cpp
+
+INCLUDEPATH += headers/ benchmarks/
+
+OBJECTS_DIR = $$_PRO_FILE_PWD_/bin/benchmarks/
+DESTDIR = $$_PRO_FILE_PWD_/bin/
+TARGET = parseNMEA-benchmarks
+
+LIBS += -lpthread -lrt -lz
@@ -0,0 +1,33 @@
+TEMPLATE = app
+CONFIG += console c++2a release
+CONFIG -= app_bundle
+CONFIG -= qt
+
+QMAKE_CXXFLAGS += -std=c++20 -O2 -fvect-cost-model=dynamic -Wall -Wfatal-errors
+
+HEADERS += \
+    headers/cartesian.h \
+    headers/earth.h \
+    headers/encodeNMEA.h \
+    headers/fix.h \
+    headers/geometry.h \
+    headers/position.h \
+    headers/replay.h \
+    headers/types.h
+
+SOURCES += \
+    src/cartesian.cpp \
+    src/earth.cpp \
+    src/encodeNMEA.cpp \
+    src/geometry.cpp \
+    src/position.cpp \
+    src/replay.cpp
+
+SOURCES += \
+    tools/replayNMEA.cpp
+
+INCLUDEPATH += headers/
+
+OBJECTS_DIR = $$_PRO_FILE_PWD_/bin/replay/
+DESTDIR = $$_PRO_FILE_PWD_/bin/
+TARGET = replayNMEA
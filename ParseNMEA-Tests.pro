@@ -1,27 +1,99 @@
 TEMPLATE = app
-CONFIG += console c++17
+CONFIG += console c++2a
 CONFIG -= app_bundle
 CONFIG -= qt
 
-QMAKE_CXXFLAGS += -std=c++17 -Wall -Wfatal-errors
+QMAKE_CXXFLAGS += -std=c++20 -fvect-cost-model=dynamic -Wall -Wfatal-errors
 
 HEADERS += \
+    headers/asyncParse.h \
+    headers/blockReading.h \
+    headers/boundedQueue.h \
+    headers/cartesian.h \
+    headers/columnarExport.h \
+    headers/compressedLog.h \
+    headers/compressedTrack.h \
+    headers/densityGrid.h \
     headers/earth.h \
+    headers/encodeNMEA.h \
+    headers/fix.h \
+    headers/fixFilter.h \
+    headers/fixRuns.h \
+    headers/fixedPosition.h \
+    headers/generator.h \
+    headers/geodesic.h \
+    headers/geofence.h \
     headers/geometry.h \
+    headers/logIndex.h \
     headers/logs.h \
     headers/parseNMEA.h \
     headers/position.h \
-    headers/types.h
+    headers/replay.h \
+    headers/resample.h \
+    headers/route.h \
+    headers/sharedFix.h \
+    headers/similarity.h \
+    headers/stops.h \
+    headers/trackAnalytics.h \
+    headers/trackStore.h \
+    headers/types.h \
+    headers/workStealing.h
 
 SOURCES += \
+    src/asyncParse.cpp \
+    src/cartesian.cpp \
+    src/columnarExport.cpp \
+    src/compressedLog.cpp \
+    src/compressedTrack.cpp \
+    src/densityGrid.cpp \
     src/earth.cpp \
+    src/encodeNMEA.cpp \
+    src/fixFilter.cpp \
+    src/fixRuns.cpp \
+    src/fixedPosition.cpp \
+    src/geodesic.cpp \
+    src/geofence.cpp \
     src/geometry.cpp \
+    src/logIndex.cpp \
     src/logs.cpp \
     src/parseNMEA.cpp \
     src/position.cpp \
+    src/replay.cpp \
+    src/resample.cpp \
+    src/route.cpp \
+    src/sharedFix.cpp \
+    src/similarity.cpp \
+    src/stops.cpp \
+    src/trackAnalytics.cpp \
+    src/trackStore.cpp \
+    src/workStealing.cpp \
     
 SOURCES += \
-    tests/parseNMEA-tests.cpp
+    tests/parseNMEA-tests.cpp \
+    tests/batchParser-tests.cpp \
+    tests/asyncParse-tests.cpp \
+    tests/trackAnalytics-tests.cpp \
+    tests/fixedPosition-tests.cpp \
+    tests/geofence-tests.cpp \
+    tests/route-tests.cpp \
+    tests/fixFilter-tests.cpp \
+    tests/geometry-tests.cpp \
+    tests/cartesian-tests.cpp \
+    tests/geodesic-tests.cpp \
+    tests/lazySentence-tests.cpp \
+    tests/logIndex-tests.cpp \
+    tests/compressedLog-tests.cpp \
+    tests/fixRuns-tests.cpp \
+    tests/columnarExport-tests.cpp \
+    tests/densityGrid-tests.cpp \
+    tests/stops-tests.cpp \
+    tests/resample-tests.cpp \
+    tests/encodeNMEA-tests.cpp \
+    tests/replay-tests.cpp \
+    tests/sharedFix-tests.cpp \
+    tests/trackStore-tests.cpp \
+    tests/compressedTrack-tests.cpp \
+    tests/similarity-tests.cpp
 
 INCLUDEPATH += headers/
 
@@ -29,4 +101,4 @@ OBJECTS_DIR = $$_PRO_FILE_PWD_/bin/
 DESTDIR = $$_PRO_FILE_PWD_/bin/
 TARGET = parseNMEA-tests
 
-LIBS += -lboost_unit_test_framework
+LIBS += -lboost_unit_test_framework -lpthread -lrt -lz
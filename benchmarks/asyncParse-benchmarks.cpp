@@ -0,0 +1,37 @@
+#include <sstream>
+
+#include "parseNMEA.h"
+#include "asyncParse.h"
+#include "benchmark.h"
+
+using namespace NMEA;
+
+BENCHMARK( AsyncVersusSynchronousParsing )
+{
+  const std::string contents = Benchmark::repeatToSize(Benchmark::readNMEALog("gga_rmc-1.log")
+                                                       + Benchmark::readNMEALog("gll.log"), 32 << 20);
+
+  std::size_t count = 0;
+  std::stringstream syncLog(contents);
+  double seconds = Benchmark::timeOnce([&]{ count = positionsFromLog(syncLog).size(); });
+  Benchmark::report("positionsFromLog", seconds, contents.size() / 1e6, "MB");
+
+  for (std::size_t blockSize : {4096, 65536, 1 << 20})
+  {
+      std::stringstream asyncLog(contents);
+      AsyncParseOptions options;
+      options.blockSize = blockSize;
+      std::size_t asyncCount = 0;
+      seconds = Benchmark::timeOnce([&]
+      {
+          for (const GPS::Position & pos : asyncPositionsFromLog(asyncLog, options))
+          {
+              Benchmark::keep(pos);
+              ++asyncCount;
+          }
+      });
+      Benchmark::report("asyncPositionsFromLog, " + std::to_string(blockSize / 1024) + " KiB blocks",
+                        seconds, contents.size() / 1e6, "MB");
+  }
+  Benchmark::keep(count);
+}
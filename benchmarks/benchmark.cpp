@@ -0,0 +1,72 @@
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "logs.h"
+#include "benchmark.h"
+
+namespace Benchmark
+{
+  namespace
+  {
+      std::vector<std::pair<const char *, Function>> & registry()
+      {
+          static std::vector<std::pair<const char *, Function>> benchmarks;
+          return benchmarks;
+      }
+  }
+
+  Registrar::Registrar(const char * name, Function function)
+  {
+      registry().emplace_back(name, function);
+  }
+
+  void report(const std::string & label, double seconds, double items, const std::string & units)
+  {
+      std::printf("  %-48s %10.3f ms %14.1f %s/s\n", label.c_str(), seconds * 1e3, items / seconds, units.c_str());
+  }
+
+  void reportValue(const std::string & label, double value, const std::string & units)
+  {
+      std::printf("  %-48s %14.3f %s\n", label.c_str(), value, units.c_str());
+  }
+
+  std::string readNMEALog(const std::string & filename)
+  {
+      std::ifstream log{GPS::LogFiles::NMEALogsDir + filename};
+      if (!log.good())
+          throw std::runtime_error("Could not open log file: " + GPS::LogFiles::NMEALogsDir + filename
+                                   + " (run the benchmarks from the 'bin/' directory)");
+      std::stringstream contents;
+      contents << log.rdbuf();
+      return contents.str();
+  }
+
+  std::string repeatToSize(const std::string & text, std::size_t bytes)
+  {
+      std::string result;
+      result.reserve(bytes + text.size());
+      while (result.size() < bytes) result += text;
+      return result;
+  }
+}
+
+int main(int argc, char * argv[])
+{
+  for (const auto & [name, function] : Benchmark::registry())
+  {
+      bool selected = (argc == 1);
+      for (int i = 1; i < argc; ++i)
+      {
+          if (std::string(name).find(argv[i]) != std::string::npos) selected = true;
+      }
+      if (!selected) continue;
+
+      std::printf("%s\n", name);
+      function();
+  }
+  return 0;
+}
@@ -0,0 +1,65 @@
+#ifndef BENCHMARK_H_191026
+#define BENCHMARK_H_191026
+
+#include <chrono>
+#include <string>
+
+/* A minimal benchmark harness.
+ *
+ * Define a benchmark with:
+ *
+ *   BENCHMARK( Name )
+ *   {
+ *       ...
+ *       Benchmark::report("what was measured", seconds, items, "items");
+ *   }
+ *
+ * The benchmark executable runs every benchmark, or only those whose names contain
+ * one of its command-line arguments.  Like the tests, it expects to be run from the
+ * 'bin/' directory so that the log files can be found.
+ */
+namespace Benchmark
+{
+  using Function = void (*)();
+
+  struct Registrar
+  {
+      Registrar(const char * name, Function);
+  };
+
+  // Run 'f' once, returning the elapsed wall-clock time in seconds.
+  template <typename F>
+  double timeOnce(F && f)
+  {
+      const auto start = std::chrono::steady_clock::now();
+      f();
+      const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+      return elapsed.count();
+  }
+
+  // Prevent the compiler from discarding a computed value.
+  template <typename T>
+  void keep(const T & value)
+  {
+      asm volatile("" : : "g"(&value) : "memory");
+  }
+
+  // Print a result line: label, time, and throughput in 'units' per second.
+  void report(const std::string & label, double seconds, double items, const std::string & units);
+
+  // Print a result line that is a quantity rather than a rate, e.g. a size in bytes.
+  void reportValue(const std::string & label, double value, const std::string & units);
+
+  // The contents of a file in the NMEA logs directory.
+  std::string readNMEALog(const std::string & filename);
+
+  // 'text' repeated until it is at least 'bytes' long.
+  std::string repeatToSize(const std::string & text, std::size_t bytes);
+}
+
+#define BENCHMARK(name) \
+    static void name(); \
+    static const Benchmark::Registrar name##Registrar(#name, name); \
+    static void name()
+
+#endif
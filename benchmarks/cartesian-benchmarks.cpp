@@ -0,0 +1,53 @@
+#include <random>
+#include <vector>
+
+#include "geometry.h"
+#include "earth.h"
+#include "cartesian.h"
+#include "benchmark.h"
+
+using namespace GPS;
+
+BENCHMARK( HaversineVersusPrecomputedCartesian )
+{
+  // Nearest-neighbour style workload: distances between all pairs of a small cluster.
+  std::mt19937 random(11);
+  std::uniform_real_distribution<double> dLat(-0.01, 0.01), dLon(-0.01, 0.01);
+  std::vector<Position> positions;
+  for (int i = 0; i < 2000; ++i)
+  {
+      positions.emplace_back(Earth::CliftonCampus.latitude() + dLat(random), Earth::CliftonCampus.longitude() + dLon(random));
+  }
+  const double pairs = double(positions.size()) * positions.size();
+
+  metres total = 0;
+  double seconds = Benchmark::timeOnce([&]
+  {
+      for (const Position & p1 : positions)
+          for (const Position & p2 : positions) total += Position::horizontalDistanceBetween(p1, p2);
+  });
+  Benchmark::report("horizontalDistanceBetween", seconds, pairs, "pairs");
+
+  std::vector<ECEF> ecef(positions.size());
+  seconds = Benchmark::timeOnce([&]
+  {
+      toECEF(positions.data(), ecef.data(), positions.size());
+      for (const ECEF & p1 : ecef)
+          for (const ECEF & p2 : ecef) total += distanceBetween(p1, p2);
+  });
+  Benchmark::report("ECEF (including conversion)", seconds, pairs, "pairs");
+
+  const LocalFrame frame(Earth::CliftonCampus);
+  std::vector<ENU> enu(positions.size());
+  seconds = Benchmark::timeOnce([&]
+  {
+      frame.toENU(positions.data(), enu.data(), positions.size());
+      for (const ENU & p1 : enu)
+          for (const ENU & p2 : enu) total += pythagoras(p2.east - p1.east, p2.north - p1.north);
+  });
+  Benchmark::report("ENU (including conversion)", seconds, pairs, "pairs");
+
+  seconds = Benchmark::timeOnce([&]{ frame.toENU(positions.data(), enu.data(), positions.size()); });
+  Benchmark::report("LocalFrame::toENU batch", seconds, positions.size(), "positions");
+  Benchmark::keep(total);
+}
@@ -0,0 +1,47 @@
+#include <iomanip>
+#include <sstream>
+
+#include "parseNMEA.h"
+#include "columnarExport.h"
+#include "benchmark.h"
+
+using namespace GPS;
+
+BENCHMARK( ColumnarExport )
+{
+  const std::string contents = Benchmark::repeatToSize(Benchmark::readNMEALog("gga_rmc-1.log"), 16 << 20);
+  std::stringstream log(contents);
+  const std::vector<Fix> fixes = NMEA::fixesFromLog(log);
+
+  // The writer alone, from already-parsed fixes.
+  std::stringstream columnar;
+  double seconds = Benchmark::timeOnce([&]
+  {
+      NMEA::ColumnarWriter writer(columnar);
+      for (std::size_t i = 0; i < fixes.size(); ++i) writer.append(fixes[i], (i % 2) ? "RMC" : "GGA");
+      writer.finish();
+  });
+  Benchmark::report("ColumnarWriter", seconds, columnar.str().size() / 1e6, "MB written");
+  Benchmark::report("ColumnarWriter", seconds, fixes.size(), "fixes");
+
+  std::stringstream csv;
+  seconds = Benchmark::timeOnce([&]
+  {
+      csv << std::setprecision(10);
+      for (std::size_t i = 0; i < fixes.size(); ++i)
+      {
+          csv << fixes[i].position.latitude() << ',' << fixes[i].position.longitude() << ','
+              << fixes[i].position.elevation() << ',' << fixes[i].time << ',' << ((i % 2) ? "RMC" : "GGA") << '\n';
+      }
+  });
+  Benchmark::report("CSV via ostream (for comparison)", seconds, csv.str().size() / 1e6, "MB written");
+  Benchmark::report("CSV via ostream (for comparison)", seconds, fixes.size(), "fixes");
+
+  // The whole parse-and-export loop.
+  std::stringstream log2(contents), exported;
+  seconds = Benchmark::timeOnce([&]{ NMEA::exportColumnar(log2, exported); });
+  Benchmark::report("exportColumnar, from log text", seconds, contents.size() / 1e6, "MB read");
+
+  Benchmark::reportValue("columnar size", columnar.str().size() / double(fixes.size()), "bytes/fix");
+  Benchmark::reportValue("CSV size", csv.str().size() / double(fixes.size()), "bytes/fix");
+}
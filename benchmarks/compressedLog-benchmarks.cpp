@@ -0,0 +1,66 @@
+#include <sstream>
+
+#include <zlib.h>
+
+#include "parseNMEA.h"
+#include "compressedLog.h"
+#include "benchmark.h"
+
+using namespace GPS;
+
+namespace
+{
+  std::string gzip(const std::string & text)
+  {
+      z_stream z {};
+      deflateInit2(&z, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 16 + MAX_WBITS, 8, Z_DEFAULT_STRATEGY);
+      std::string compressed(deflateBound(&z, text.size()), '\0');
+      z.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(text.data()));
+      z.avail_in = text.size();
+      z.next_out = reinterpret_cast<Bytef *>(compressed.data());
+      z.avail_out = compressed.size();
+      deflate(&z, Z_FINISH);
+      compressed.resize(z.total_out);
+      deflateEnd(&z);
+      return compressed;
+  }
+}
+
+BENCHMARK( CompressedLogIngestion )
+{
+  // Throughput is in megabytes of uncompressed log.
+  const std::string contents = Benchmark::repeatToSize(Benchmark::readNMEALog("gga_rmc-1.log") +
+                                                       Benchmark::readNMEALog("gll.log"), 16 << 20);
+  const std::string compressed = gzip(contents);
+  const double megabytes = contents.size() / 1e6;
+  Benchmark::reportValue("compression ratio", double(contents.size()) / compressed.size(), ":1");
+
+  std::size_t count = 0;
+  std::stringstream plain(contents);
+  double seconds = Benchmark::timeOnce([&]{ count += NMEA::positionsFromLog(plain).size(); });
+  Benchmark::report("positionsFromLog, uncompressed", seconds, megabytes, "MB");
+
+  std::stringstream source1(compressed);
+  seconds = Benchmark::timeOnce([&]
+  {
+      for (const std::string & block : NMEA::decompressedBlocks(source1)) count += block.size();
+  });
+  Benchmark::report("decompression only", seconds, megabytes, "MB");
+
+  std::stringstream source2(compressed);
+  seconds = Benchmark::timeOnce([&]
+  {
+      NMEA::DecompressingStream log(source2);
+      count += NMEA::positionsFromLog(log).size();
+  });
+  Benchmark::report("positionsFromLog(DecompressingStream)", seconds, megabytes, "MB");
+
+  std::stringstream source3(compressed);
+  seconds = Benchmark::timeOnce([&]
+  {
+      for (const Position & pos : NMEA::asyncPositionsFromCompressedLog(source3)) count += pos.latitude() > 0;
+  });
+  Benchmark::report("asyncPositionsFromCompressedLog", seconds, megabytes, "MB");
+
+  Benchmark::keep(count);
+}
@@ -0,0 +1,112 @@
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "parseNMEA.h"
+#include "compressedTrack.h"
+#include "benchmark.h"
+
+using namespace GPS;
+
+namespace
+{
+  // A log's fixes repeated, with times laid end to end so the track runs continuously.
+  std::vector<Fix> repeatedLog(const std::string & filename, std::size_t count)
+  {
+      std::istringstream log(Benchmark::readNMEALog(filename));
+      const std::vector<Fix> logFixes = NMEA::fixesFromLog(log);
+      std::vector<Fix> fixes;
+      seconds offset = 0;
+      while (fixes.size() < count)
+      {
+          for (const Fix & fix : logFixes) fixes.push_back({fix.position, fix.time + offset});
+          offset = fixes.back().time + 1 - logFixes.front().time;
+      }
+      fixes.erase(fixes.begin() + count, fixes.end());
+      return fixes;
+  }
+}
+
+BENCHMARK( CompressedTrackStorage )
+{
+  const std::size_t n = 1 << 21;
+  for (std::string filename : {"gga_rmc-1.log", "gga_rmc-2.log", "gll.log"})
+  {
+      const std::vector<Fix> fixes = repeatedLog(filename, n);
+      CompressedTrack track;
+      double seconds = Benchmark::timeOnce([&]
+      {
+          for (const Fix & fix : fixes) track.append(fix);
+          track.seal();
+      });
+      Benchmark::report(filename + ": append", seconds, n, "fixes");
+      Benchmark::reportValue(filename + ": size", static_cast<double>(track.bytesUsed()) / n, "bytes/fix");
+
+      std::vector<Fix> decoded;
+      decoded.reserve(n);
+      seconds = Benchmark::timeOnce([&]
+      {
+          for (std::size_t chunk = 0; chunk < track.chunkCount(); ++chunk) track.decodeChunk(chunk, decoded);
+      });
+      Benchmark::report(filename + ": decode", seconds, decoded.size(), "fixes");
+      Benchmark::keep(decoded);
+
+      FixColumns columns;
+      columns.latitudes.reserve(n);
+      columns.longitudes.reserve(n);
+      columns.elevations.reserve(n);
+      columns.times.reserve(n);
+      seconds = Benchmark::timeOnce([&]
+      {
+          for (std::size_t chunk = 0; chunk < track.chunkCount(); ++chunk) track.decodeChunkColumns(chunk, columns);
+      });
+      Benchmark::report(filename + ": decode columns", seconds, columns.size(), "fixes");
+      Benchmark::keep(columns);
+
+      // As the range queries decode: chunk by chunk, reusing the buffers.
+      std::size_t scanned = 0;
+      seconds = Benchmark::timeOnce([&]
+      {
+          for (std::size_t chunk = 0; chunk < track.chunkCount(); ++chunk)
+          {
+              columns.clear();
+              track.decodeChunkColumns(chunk, columns);
+              scanned += columns.size();
+          }
+      });
+      Benchmark::report(filename + ": decode columns by chunk", seconds, scanned, "fixes");
+      Benchmark::keep(columns);
+  }
+  Benchmark::reportValue("for comparison, a std::vector<Fix>", sizeof(Fix), "bytes/fix");
+}
+
+BENCHMARK( CompressedTrackRangeScan )
+{
+  const std::vector<Fix> fixes = repeatedLog("gga_rmc-2.log", 1 << 21);
+  CompressedTrack track;
+  for (const Fix & fix : fixes) track.append(fix);
+  track.seal();
+
+  // An hour of a track that covers about two years.
+  const seconds from = fixes[fixes.size() / 2].time, to = from + 3600;
+  std::size_t found = 0;
+  const int queries = 100;
+  double seconds = Benchmark::timeOnce([&]
+  {
+      for (int q = 0; q < queries; ++q) found += track.fixesBetween(from + q, to + q).size();
+  });
+  Benchmark::report("fixesBetween, an hour, skipping chunks", seconds, queries, "queries");
+  Benchmark::reportValue("fixes per query", static_cast<double>(found) / queries, "fixes");
+
+  seconds = Benchmark::timeOnce([&]
+  {
+      for (int q = 0; q < queries / 10; ++q)
+      {
+          std::size_t count = 0;
+          for (const Fix & fix : track.fixes()) count += fix.time >= from + q && fix.time <= to + q;
+          found += count;
+      }
+  });
+  Benchmark::report("decoding everything and filtering", seconds, queries / 10, "queries");
+  Benchmark::keep(found);
+}
@@ -0,0 +1,44 @@
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "earth.h"
+#include "densityGrid.h"
+#include "benchmark.h"
+
+using namespace GPS;
+
+BENCHMARK( DensityGridThreadScaling )
+{
+  // A day's fixes scattered over a 20km square, binned into 25m cells (an 800x800 grid).
+  const std::size_t n = 1 << 24;
+  std::mt19937 random(43);
+  std::normal_distribution<double> dLat(0, 0.03), dLon(0, 0.05);
+  std::vector<Position> positions;
+  positions.reserve(n);
+  for (std::size_t i = 0; i < n; ++i)
+  {
+      positions.emplace_back(Earth::CliftonCampus.latitude() + dLat(random), Earth::CliftonCampus.longitude() + dLon(random));
+  }
+  const Position southWest(Earth::CliftonCampus.latitude() - 0.09, Earth::CliftonCampus.longitude() - 0.15);
+  const Position northEast(Earth::CliftonCampus.latitude() + 0.09, Earth::CliftonCampus.longitude() + 0.15);
+
+  const unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+  Benchmark::reportValue("hardware threads", cores, "threads");
+  for (unsigned threads = 1; threads <= std::max(4u, cores); threads *= 2)
+  {
+      DensityGrid grid(southWest, northEast, 25);
+      double seconds = Benchmark::timeOnce([&]{ grid.add(positions, threads); });
+      Benchmark::report(std::to_string(threads) + " thread(s)", seconds, n, "points");
+      Benchmark::keep(grid);
+  }
+
+  DensityGrid grid(southWest, northEast, 25);
+  grid.add(positions);
+  std::ostringstream image;
+  double seconds = Benchmark::timeOnce([&]{ grid.writePGM(image); });
+  Benchmark::report("writePGM", seconds, grid.rows() * grid.columns(), "cells");
+  Benchmark::reportValue("PGM size", image.str().size() / 1e6, "MB");
+}
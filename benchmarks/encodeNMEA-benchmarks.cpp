@@ -0,0 +1,106 @@
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "earth.h"
+#include "cartesian.h"
+#include "encodeNMEA.h"
+#include "replay.h"
+#include "benchmark.h"
+
+using namespace GPS;
+
+namespace
+{
+  // The obvious implementation: snprintf of the fields, then a checksum pass.
+  std::size_t encodeWithSnprintf(const Fix & fix, char * buffer)
+  {
+      const double lat = std::abs(fix.position.latitude()), lon = std::abs(fix.position.longitude());
+      const int latDegrees = static_cast<int>(lat), lonDegrees = static_cast<int>(lon);
+      const long ms = std::lround(fix.time * 1000);
+      int length = std::snprintf(buffer, NMEA::maxEncodedSentenceLength,
+          "$GPGGA,%02ld%02ld%02ld.%03ld,%02d%07.4f,%c,%03d%07.4f,%c,1,08,1.0,%.1f,M,0.0,M,,",
+          ms / 3600000, ms / 60000 % 60, ms / 1000 % 60, ms % 1000,
+          latDegrees, (lat - latDegrees) * 60, fix.position.latitude() < 0 ? 'S' : 'N',
+          lonDegrees, (lon - lonDegrees) * 60, fix.position.longitude() < 0 ? 'W' : 'E',
+          fix.position.elevation());
+      char checksum[2];
+      NMEA::writeChecksum(std::string_view(buffer + 1, length - 1), checksum);
+      length += std::snprintf(buffer + length, 5, "*%c%c\n", checksum[0], checksum[1]);
+      return length;
+  }
+}
+
+BENCHMARK( SentenceEncoding )
+{
+  std::vector<Fix> fixes;
+  const LocalFrame frame(Earth::CliftonCampus);
+  for (int i = 0; i < 1 << 20; ++i)
+  {
+      const double angle = i * 1e-4;
+      fixes.push_back({frame.toPosition({2000 * std::cos(angle), 2000 * std::sin(angle), 0}), i * 0.1});
+  }
+  std::vector<char> output(fixes.size() * NMEA::maxEncodedSentenceLength);
+
+  std::size_t bytes = 0;
+  double seconds = Benchmark::timeOnce([&]
+  {
+      for (const Fix & fix : fixes) bytes += encodeWithSnprintf(fix, output.data() + bytes);
+  });
+  Benchmark::report("GGA with snprintf", seconds, fixes.size(), "sentences");
+
+  for (const char * format : {"GLL", "GGA", "RMC"})
+  {
+      bytes = 0;
+      seconds = Benchmark::timeOnce([&]
+      {
+          for (const Fix & fix : fixes) bytes += NMEA::encodeSentence(format, fix, 12.5, output.data() + bytes);
+      });
+      Benchmark::report(std::string(format) + " with encodeSentence", seconds, fixes.size(), "sentences");
+      Benchmark::report(std::string(format) + " with encodeSentence", seconds, bytes / 1e6, "MB");
+  }
+  Benchmark::keep(output);
+}
+
+BENCHMARK( ReplayThroughput )
+{
+  const NMEA::ReplayOptions options {0, 64, 4 << 20};
+
+  const int devNull = ::open("/dev/null", O_WRONLY);
+  {
+      NMEA::ReplaySink sink = NMEA::ReplaySink::toFileDescriptor(devNull);
+      const NMEA::ReplayStats stats = NMEA::replay(NMEA::syntheticSource(Earth::CliftonCampus, 500, 15, 10), sink, options);
+      Benchmark::report("synthetic to /dev/null", stats.elapsed.count(), stats.sentences, "sentences");
+  }
+  ::close(devNull);
+
+  int fds[2];
+  if (::pipe(fds) != 0) return;
+  std::thread reader([fd = fds[0]]
+  {
+      char buffer[1 << 16];
+      while (::read(fd, buffer, sizeof(buffer)) > 0) {}
+  });
+  {
+      const std::string log = Benchmark::readNMEALog("gga_rmc-1.log");
+      NMEA::ReplaySink sink = NMEA::ReplaySink::toFileDescriptor(fds[1]);
+      const NMEA::ReplayStats stats = NMEA::replay(NMEA::logSource(log, 100000), sink, options);
+      Benchmark::report("gga_rmc-1.log through a pipe", stats.elapsed.count(), stats.sentences, "sentences");
+      Benchmark::report("gga_rmc-1.log through a pipe", stats.elapsed.count(), stats.bytes / 1e6, "MB");
+  }
+  ::close(fds[1]);
+  reader.join();
+  ::close(fds[0]);
+
+  {
+      // Nothing listens on the discard port; the datagrams are sent and dropped.
+      NMEA::ReplaySink sink = NMEA::ReplaySink::toUDP("127.0.0.1", 9);
+      const NMEA::ReplayStats stats = NMEA::replay(NMEA::syntheticSource(Earth::CliftonCampus, 500, 15, 10), sink, options);
+      Benchmark::report("synthetic to UDP loopback, 1472-byte datagrams", stats.elapsed.count(), stats.sentences, "sentences");
+  }
+}
@@ -0,0 +1,42 @@
+#include <functional>
+#include <sstream>
+
+#include "parseNMEA.h"
+#include "fixFilter.h"
+#include "benchmark.h"
+
+using namespace GPS;
+
+BENCHMARK( JumpFilterAndKalmanSmoother )
+{
+  const std::string contents = Benchmark::repeatToSize(Benchmark::readNMEALog("gga_rmc-1.log"), 8 << 20);
+  std::stringstream log(contents);
+  const std::vector<Fix> fixes = NMEA::fixesFromLog(log);
+
+  JumpFilter filter(100);
+  std::size_t accepted = 0;
+  double seconds = Benchmark::timeOnce([&]
+  {
+      for (const Fix & fix : fixes) accepted += filter.accept(fix);
+  });
+  Benchmark::report("JumpFilter::accept", seconds, fixes.size(), "fixes");
+
+  KalmanSmoother smoother(1, 5);
+  degrees sum = 0;
+  seconds = Benchmark::timeOnce([&]
+  {
+      for (const Fix & fix : fixes) sum += smoother.smooth(fix).position.latitude();
+  });
+  Benchmark::report("KalmanSmoother::smooth", seconds, fixes.size(), "fixes");
+
+  std::stringstream log1(contents), log2(contents);
+  seconds = Benchmark::timeOnce([&]{ Benchmark::keep(NMEA::fixesFromLog(log1)); });
+  Benchmark::report("fixesFromLog, unfiltered", seconds, fixes.size(), "fixes");
+
+  JumpFilter parseFilter(100);
+  seconds = Benchmark::timeOnce([&]{ Benchmark::keep(NMEA::fixesFromLog(log2, std::ref(parseFilter))); });
+  Benchmark::report("fixesFromLog, with JumpFilter", seconds, fixes.size(), "fixes");
+
+  Benchmark::keep(accepted);
+  Benchmark::keep(sum);
+}
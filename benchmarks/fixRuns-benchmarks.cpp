@@ -0,0 +1,53 @@
+#include <sstream>
+#include <string>
+
+#include "parseNMEA.h"
+#include "fixRuns.h"
+#include "benchmark.h"
+
+using namespace GPS;
+
+namespace
+{
+  // A receiver that reports from the same place for ten seconds at a time.
+  std::string stationaryLog(std::size_t bytes)
+  {
+      const std::string log = Benchmark::readNMEALog("gga_rmc-1.log");
+      std::istringstream lines(log);
+      std::string line, result;
+      while (result.size() < bytes)
+      {
+          if (!std::getline(lines, line))
+          {
+              lines.clear();
+              lines.seekg(0);
+              continue;
+          }
+          for (int i = 0; i < 10; ++i) result += line + '\n';
+      }
+      return result;
+  }
+}
+
+BENCHMARK( RunLengthDeduplication )
+{
+  const std::string contents = stationaryLog(16 << 20);
+  const double megabytes = contents.size() / 1e6;
+
+  std::stringstream log1(contents), log2(contents), log3(contents);
+  std::vector<Fix> fixes;
+  double seconds = Benchmark::timeOnce([&]{ fixes = NMEA::fixesFromLog(log1); });
+  Benchmark::report("fixesFromLog", seconds, megabytes, "MB");
+
+  std::vector<NMEA::FixRun> runs;
+  seconds = Benchmark::timeOnce([&]{ runs = NMEA::fixRunsFromLog(log2); });
+  Benchmark::report("fixRunsFromLog, exact", seconds, megabytes, "MB");
+
+  std::vector<NMEA::FixRun> looseRuns;
+  seconds = Benchmark::timeOnce([&]{ looseRuns = NMEA::fixRunsFromLog(log3, 10); });
+  Benchmark::report("fixRunsFromLog, within 10m", seconds, megabytes, "MB");
+
+  Benchmark::reportValue("fixes", fixes.size() * sizeof(Fix) / 1e6, "MB");
+  Benchmark::reportValue("runs, exact", runs.size() * sizeof(NMEA::FixRun) / 1e6, "MB");
+  Benchmark::reportValue("runs, within 10m", looseRuns.size() * sizeof(NMEA::FixRun) / 1e6, "MB");
+}
@@ -0,0 +1,51 @@
+#include <sstream>
+
+#include "parseNMEA.h"
+#include "fixedPosition.h"
+#include "benchmark.h"
+
+using namespace NMEA;
+
+BENCHMARK( FixedVersusFloatingPointParsing )
+{
+  const std::string contents = Benchmark::repeatToSize(Benchmark::readNMEALog("gga_rmc-1.log"), 16 << 20);
+
+  std::stringstream log1(contents), log2(contents);
+  std::size_t count = 0;
+
+  double seconds = Benchmark::timeOnce([&]{ count = positionsFromLog(log1).size(); });
+  Benchmark::report("positionsFromLog", seconds, count, "fixes");
+  Benchmark::reportValue("  memory for result", count * sizeof(GPS::Position) / 1e6, "MB");
+
+  seconds = Benchmark::timeOnce([&]{ count = fixedPositionsFromLog(log2).size(); });
+  Benchmark::report("fixedPositionsFromLog", seconds, count, "fixes");
+  Benchmark::reportValue("  memory for result", count * sizeof(GPS::FixedPosition) / 1e6, "MB");
+}
+
+BENCHMARK( DDMConversion )
+{
+  const int n = 2000000;
+  double sum = 0;
+  double seconds = Benchmark::timeOnce([&]
+  {
+      for (int i = 0; i < n; ++i)
+      {
+          GPS::Position pos("3723.1622", 'N', "00559.5788", 'W', "30.0");
+          sum += pos.latitude();
+      }
+  });
+  Benchmark::report("Position from DDM strings", seconds, n, "conversions");
+
+  long units = 0;
+  seconds = Benchmark::timeOnce([&]
+  {
+      for (int i = 0; i < n; ++i)
+      {
+          GPS::FixedPosition pos("3723.1622", 'N', "00559.5788", 'W', "30.0");
+          units += pos.latitudeUnits();
+      }
+  });
+  Benchmark::report("FixedPosition from DDM strings", seconds, n, "conversions");
+  Benchmark::keep(sum);
+  Benchmark::keep(units);
+}
@@ -0,0 +1,65 @@
+#include <random>
+#include <vector>
+
+#include "geodesic.h"
+#include "benchmark.h"
+
+using namespace GPS;
+
+BENCHMARK( GeodesicVersusSpherical )
+{
+  std::mt19937 random(36);
+  std::uniform_real_distribution<double> lat(-85, 85), lon(-180, 180), step(-0.001, 0.001);
+
+  // A walking-pace track, and a set of long random lines.
+  std::vector<Position> track { Position(51.45, -2.6) };
+  for (int i = 1; i < 200000; ++i)
+  {
+      track.emplace_back(track.back().latitude() + step(random), track.back().longitude() + step(random));
+  }
+  std::vector<Position> from, to;
+  for (int i = 0; i < 100000; ++i)
+  {
+      from.emplace_back(lat(random), lon(random));
+      to.emplace_back(lat(random), lon(random));
+  }
+  std::vector<metres> legs(track.size() - 1);
+  metres total = 0;
+
+  double seconds = Benchmark::timeOnce([&]
+  {
+      for (std::size_t i = 1; i < track.size(); ++i) total += Position::horizontalDistanceBetween(track[i-1], track[i]);
+  });
+  Benchmark::report("spherical, track legs", seconds, legs.size(), "legs");
+
+  seconds = Benchmark::timeOnce([&]
+  {
+      for (std::size_t i = 1; i < track.size(); ++i) total += geodesicDistanceBetween(track[i-1], track[i]);
+  });
+  Benchmark::report("geodesicDistanceBetween, track legs", seconds, legs.size(), "legs");
+
+  seconds = Benchmark::timeOnce([&]{ geodesicLegDistances(track.data(), track.size(), legs.data()); });
+  Benchmark::report("geodesicLegDistances", seconds, legs.size(), "legs");
+
+  seconds = Benchmark::timeOnce([&]
+  {
+      for (std::size_t i = 0; i < from.size(); ++i) total += Position::horizontalDistanceBetween(from[i], to[i]);
+  });
+  Benchmark::report("spherical, random lines", seconds, from.size(), "lines");
+
+  seconds = Benchmark::timeOnce([&]
+  {
+      for (std::size_t i = 0; i < from.size(); ++i) total += geodesicDistanceBetween(from[i], to[i]);
+  });
+  Benchmark::report("geodesicDistanceBetween, random lines", seconds, from.size(), "lines");
+
+  // The fallback solvers are much slower, so fewer of these.
+  std::vector<Position> antipodes;
+  for (const Position & p : std::vector<Position>(from.begin(), from.begin() + 10000)) antipodes.emplace_back(-p.latitude() + 0.2, p.longitude() > 0 ? p.longitude() - 179.8 : p.longitude() + 179.8);
+  seconds = Benchmark::timeOnce([&]
+  {
+      for (std::size_t i = 0; i < antipodes.size(); ++i) total += geodesicDistanceBetween(from[i], antipodes[i]);
+  });
+  Benchmark::report("geodesicDistanceBetween, near-antipodal", seconds, antipodes.size(), "lines");
+  Benchmark::keep(total);
+}
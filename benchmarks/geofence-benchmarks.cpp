@@ -0,0 +1,84 @@
+#include <random>
+#include <vector>
+
+#include "geofence.h"
+#include "benchmark.h"
+
+using namespace GPS;
+
+BENCHMARK( GeofenceEvaluation10kFences )
+{
+  std::mt19937 random(1);
+  std::uniform_real_distribution<double> lat(50.0, 56.0), lon(-5.0, 1.0), radius(50, 500), size(0.001, 0.005);
+
+  GeofenceSet fences(0.01);
+  for (int i = 0; i < 10000; ++i)
+  {
+      const Position centre(lat(random), lon(random));
+      if (i % 2 == 0)
+      {
+          fences.addCircle(centre, radius(random));
+      }
+      else
+      {
+          const degrees d = size(random);
+          fences.addPolygon({ Position(centre.latitude() - d, centre.longitude() - d),
+                              Position(centre.latitude() - d, centre.longitude() + d),
+                              Position(centre.latitude() + d, centre.longitude() + d),
+                              Position(centre.latitude() + d, centre.longitude() - d) });
+      }
+  }
+
+  // A random walk, so that fixes move in and out of fences like a real track.
+  const int numFixes = 2000000;
+  std::vector<Position> fixes;
+  fixes.reserve(numFixes);
+  std::normal_distribution<double> step(0, 0.0005);
+  degrees walkLat = 53, walkLon = -1.2;
+  for (int i = 0; i < numFixes; ++i)
+  {
+      if (i % 10000 == 0) { walkLat = lat(random); walkLon = lon(random); }
+      walkLat += step(random);
+      walkLon += step(random);
+      fixes.emplace_back(walkLat, walkLon);
+  }
+
+  std::vector<GeofenceSet::FenceId> found;
+  std::size_t matches = 0;
+  double seconds = Benchmark::timeOnce([&]
+  {
+      for (const Position & pos : fixes)
+      {
+          fences.fencesContaining(pos, found);
+          matches += found.size();
+      }
+  });
+  Benchmark::report("fencesContaining, 10k fences", seconds, numFixes, "fixes");
+  Benchmark::reportValue("  average per fix", seconds / numFixes * 1e9, "ns");
+
+  GeofenceMonitor monitor(fences);
+  std::vector<GeofenceEvent> events;
+  seconds = Benchmark::timeOnce([&]
+  {
+      for (const Position & pos : fixes)
+      {
+          events.clear();
+          monitor.update(pos, events);
+      }
+  });
+  Benchmark::report("GeofenceMonitor::update, 10k fences", seconds, numFixes, "fixes");
+
+  const int bruteForceFixes = 2000;
+  seconds = Benchmark::timeOnce([&]
+  {
+      for (int i = 0; i < bruteForceFixes; ++i)
+      {
+          for (GeofenceSet::FenceId id = 0; id < fences.size(); ++id)
+          {
+              matches += fences.contains(id, fixes[i]);
+          }
+      }
+  });
+  Benchmark::report("brute force over all fences", seconds, bruteForceFixes, "fixes");
+  Benchmark::keep(matches);
+}
@@ -0,0 +1,125 @@
+#include <random>
+#include <vector>
+
+#include "geometry.h"
+#include "earth.h"
+#include "benchmark.h"
+
+using namespace GPS;
+
+BENCHMARK( BatchVersusScalarGeometry )
+{
+  const std::size_t n = 1 << 20;
+  const int repeats = 20;
+  std::mt19937 random(5);
+  std::uniform_real_distribution<double> angle(-720, 720), lat(-90, 90), ele(0, 500);
+
+  std::vector<degrees> in(n), latitudes(n), longitudes(n);
+  std::vector<metres> elevations(n), x(n), y(n), z(n);
+  std::vector<double> out(n);
+  for (std::size_t i = 0; i < n; ++i)
+  {
+      in[i] = angle(random);
+      latitudes[i] = lat(random);
+      longitudes[i] = angle(random) / 4;
+      elevations[i] = ele(random);
+  }
+
+  // The scalar loops call through a function pointer, as an out-of-line call would.
+  degrees (* volatile scalarNormalise)(degrees) = &normaliseDeg;
+  radians (* volatile scalarDegToRad)(degrees) = [](degrees d){ return degToRad(d); };
+
+  double seconds = Benchmark::timeOnce([&]
+  {
+      for (int r = 0; r < repeats; ++r)
+          for (std::size_t i = 0; i < n; ++i) out[i] = scalarDegToRad(in[i]);
+  });
+  Benchmark::report("degToRad, out-of-line scalar calls", seconds, n * repeats, "values");
+
+  seconds = Benchmark::timeOnce([&]
+  {
+      for (int r = 0; r < repeats; ++r)
+          for (std::size_t i = 0; i < n; ++i) out[i] = degToRad(in[i]);
+  });
+  Benchmark::report("degToRad, inline scalar", seconds, n * repeats, "values");
+
+  seconds = Benchmark::timeOnce([&]{ for (int r = 0; r < repeats; ++r) degToRad(in.data(), out.data(), n); });
+  Benchmark::report("degToRad, batch", seconds, n * repeats, "values");
+  Benchmark::keep(out);
+
+  seconds = Benchmark::timeOnce([&]
+  {
+      for (int r = 0; r < repeats; ++r)
+          for (std::size_t i = 0; i < n; ++i) out[i] = scalarNormalise(in[i]);
+  });
+  Benchmark::report("normaliseDeg, out-of-line scalar calls", seconds, n * repeats, "values");
+
+  seconds = Benchmark::timeOnce([&]{ for (int r = 0; r < repeats; ++r) normaliseDeg(in.data(), out.data(), n); });
+  Benchmark::report("normaliseDeg, batch", seconds, n * repeats, "values");
+  Benchmark::keep(out);
+
+  seconds = Benchmark::timeOnce([&]
+  {
+      for (std::size_t i = 0; i < n; ++i)
+      {
+          const radians phi = degToRad(latitudes[i]), lambda = degToRad(longitudes[i]);
+          const metres r = Earth::meanRadius + elevations[i];
+          x[i] = r * std::cos(phi) * std::cos(lambda);
+          y[i] = r * std::cos(phi) * std::sin(lambda);
+          z[i] = r * std::sin(phi);
+      }
+  });
+  Benchmark::report("lat/lon to ECEF, scalar loop", seconds, n, "positions");
+
+  seconds = Benchmark::timeOnce([&]
+  {
+      Earth::toECEF(latitudes.data(), longitudes.data(), elevations.data(), x.data(), y.data(), z.data(), n);
+  });
+  Benchmark::report("lat/lon to ECEF, Earth::toECEF", seconds, n, "positions");
+  Benchmark::keep(x);
+}
+
+namespace
+{
+  // Equirectangular distance: accurate at short range, and foldable for a fixed 'site'.
+  inline metres distanceFrom(const Position & site, const Position & pos)
+  {
+      const double metresPerDegree = degToRad(1) * Earth::meanRadius;
+      const double x = (pos.longitude() - site.longitude()) * std::cos(degToRad(site.latitude())) * metresPerDegree;
+      const double y = (pos.latitude() - site.latitude()) * metresPerDegree;
+      return pythagoras(x, y);
+  }
+}
+
+BENCHMARK( ConstexprFixedSiteDistance )
+{
+  const std::size_t n = 1 << 20;
+  std::mt19937 random(42);
+  std::uniform_real_distribution<double> offset(-0.05, 0.05);
+  std::vector<Position> positions;
+  for (std::size_t i = 0; i < n; ++i)
+  {
+      positions.emplace_back(Earth::CliftonCampus.latitude() + offset(random), Earth::CliftonCampus.longitude() + offset(random));
+  }
+
+  // A copy whose value the compiler cannot know, as it could not for the former extern
+  // const Earth::CliftonCampus defined in another translation unit.
+  volatile degrees runtimeLat = Earth::CliftonCampus.latitude();
+  volatile degrees runtimeLon = Earth::CliftonCampus.longitude();
+  const Position runtimeSite(runtimeLat, runtimeLon);
+
+  metres total = 0;
+  double seconds = Benchmark::timeOnce([&]
+  {
+      for (const Position & pos : positions) total += distanceFrom(runtimeSite, pos);
+  });
+  Benchmark::report("distance to a run-time site", seconds, n, "positions");
+
+  seconds = Benchmark::timeOnce([&]
+  {
+      for (const Position & pos : positions) total += distanceFrom(Earth::CliftonCampus, pos);
+  });
+  Benchmark::report("distance to constexpr Earth::CliftonCampus", seconds, n, "positions");
+
+  Benchmark::keep(total);
+}
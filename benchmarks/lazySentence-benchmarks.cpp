@@ -0,0 +1,30 @@
+#include <sstream>
+
+#include "parseNMEA.h"
+#include "benchmark.h"
+
+using namespace GPS;
+
+BENCHMARK( TimeWindowExtraction )
+{
+  // A one-minute window of a log which spans over two hours.
+  const std::string contents = Benchmark::repeatToSize(Benchmark::readNMEALog("gga_rmc-1.log"), 8 << 20);
+  const seconds from = 10*3600, to = 10*3600 + 60;
+  const double bytes = contents.size();
+
+  std::stringstream log1(contents), log2(contents);
+  std::size_t kept = 0;
+  double seconds = Benchmark::timeOnce([&]
+  {
+      for (const Fix & fix : NMEA::fixesFromLog(log1, [&](Fix & f){ return f.time >= from && f.time <= to; }))
+      {
+          kept += fix.time > 0;
+      }
+  });
+  Benchmark::report("fixesFromLog, then filter by time", seconds, bytes / 1e6, "MB");
+
+  seconds = Benchmark::timeOnce([&]{ kept += NMEA::fixesInTimeWindow(log2, from, to).size(); });
+  Benchmark::report("fixesInTimeWindow (lazy)", seconds, bytes / 1e6, "MB");
+
+  Benchmark::keep(kept);
+}
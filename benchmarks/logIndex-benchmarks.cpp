@@ -0,0 +1,66 @@
+#include <cstdio>
+#include <sstream>
+#include <string>
+
+#include "parseNMEA.h"
+#include "logIndex.h"
+#include "benchmark.h"
+
+using namespace GPS;
+
+namespace
+{
+  // A day-long log: a GGA and an RMC sentence every second.
+  std::string dayLongLog()
+  {
+      std::string log;
+      char body[128], line[160];
+      for (int t = 0; t < 86400; ++t)
+      {
+          const int hhmmss = (t / 3600) * 10000 + (t / 60 % 60) * 100 + t % 60;
+          for (const char * format : {"GPGGA,%06d.000,3723.1622,N,00559.5788,W,1,0,,30.0,M,,M,,",
+                                      "GPRMC,%06d.000,A,3723.1622,N,00559.5788,W,0.000,0.00,150914,,A"})
+          {
+              std::snprintf(body, sizeof(body), format, hhmmss);
+              unsigned checksum = 0;
+              for (const char * c = body; *c; ++c) checksum ^= static_cast<unsigned char>(*c);
+              std::snprintf(line, sizeof(line), "$%s*%02X\n", body, checksum);
+              log += line;
+          }
+      }
+      return log;
+  }
+}
+
+BENCHMARK( TimeIndexedLogAccess )
+{
+  const std::string contents = dayLongLog();
+  const double megabytes = contents.size() / 1e6;
+
+  std::stringstream raw(contents);
+  std::string block(1 << 20, '\0');
+  std::size_t read = 0;
+  double seconds = Benchmark::timeOnce([&]{ while (raw.read(block.data(), block.size()) || raw.gcount()) read += raw.gcount(); });
+  Benchmark::report("reading the log (baseline)", seconds, megabytes, "MB");
+
+  std::stringstream log(contents);
+  NMEA::LogIndex index = NMEA::LogIndex::build(log);
+  log.clear();
+  log.seekg(0);
+  seconds = Benchmark::timeOnce([&]{ index = NMEA::LogIndex::build(log); });
+  Benchmark::report("LogIndex::build", seconds, megabytes, "MB");
+  Benchmark::reportValue("index entries", index.entries().size(), "entries");
+
+  // A ten-minute window in the middle of the day.
+  const GPS::seconds from = 12*3600, to = 12*3600 + 600;
+  std::stringstream full(contents);
+  std::size_t fixes = 0;
+  seconds = Benchmark::timeOnce([&]{ fixes += NMEA::fixesInTimeWindow(full, from, to).size(); });
+  Benchmark::report("fixesInTimeWindow, whole log", seconds, 1, "queries");
+
+  seconds = Benchmark::timeOnce([&]{ fixes += index.fixesBetween(log, from, to).size(); });
+  Benchmark::report("LogIndex::fixesBetween", seconds, 1, "queries");
+
+  Benchmark::keep(read);
+  Benchmark::keep(fixes);
+}
@@ -0,0 +1,48 @@
+#include <cmath>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "earth.h"
+#include "parseNMEA.h"
+#include "resample.h"
+#include "benchmark.h"
+
+using namespace GPS;
+
+BENCHMARK( FixedRateResampling )
+{
+  // gll.log repeated, with times laid end to end so the track runs continuously.
+  std::istringstream log(Benchmark::readNMEALog("gll.log"));
+  const std::vector<Fix> logFixes = NMEA::fixesFromLog(log);
+  std::vector<Fix> fixes;
+  seconds offset = 0;
+  while (fixes.size() < (1 << 16))
+  {
+      for (const Fix & fix : logFixes) fixes.push_back({fix.position, std::fmod(fix.time + offset, 86400.0)});
+      // Start the next copy a second after this one ends.
+      offset = fixes.back().time + 1 - logFixes.front().time;
+  }
+
+  for (seconds interval : {10.0, 1.0})
+  {
+      const std::string label = "interval " + std::to_string(static_cast<int>(interval)) + "s, ";
+      Resampler resampler(interval, 120, GapPolicy::Interpolate);
+      std::vector<Fix> samples;
+      std::size_t count = 0;
+      double seconds = Benchmark::timeOnce([&]
+      {
+          for (const Fix & fix : fixes)
+          {
+              resampler.add(fix, samples);
+              count += samples.size();
+              samples.clear(); // a streaming consumer: constant memory
+          }
+      });
+      Benchmark::report(label + "Resampler", seconds, count, "samples");
+
+      std::vector<Fix> batch;
+      seconds = Benchmark::timeOnce([&]{ batch = resampleTrack(fixes, interval, 120, GapPolicy::Interpolate); });
+      Benchmark::report(label + "resampleTrack", seconds, batch.size(), "samples");
+  }
+}
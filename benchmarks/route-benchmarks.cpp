@@ -0,0 +1,51 @@
+#include <random>
+#include <vector>
+
+#include "earth.h"
+#include "route.h"
+#include "benchmark.h"
+
+using namespace GPS;
+
+BENCHMARK( RouteDeviationPerFix )
+{
+  // A winding 100k-point route with points about 20m apart.
+  std::mt19937 random(7);
+  std::normal_distribution<double> turn(0, 0.2);
+  std::vector<Position> route;
+  degrees lat = 52.0, lon = -1.5, heading = 0.5;
+  for (int i = 0; i < 100000; ++i)
+  {
+      route.emplace_back(lat, lon);
+      heading += turn(random);
+      lat += Earth::latitudeSubtendedBy(20 * std::cos(heading));
+      lon += Earth::longitudeSubtendedBy(20 * std::sin(heading), lat);
+  }
+
+  // A track following the route with a few metres of noise, four fixes per segment,
+  // and an occasional excursion of a few hundred metres.
+  std::normal_distribution<double> noise(0, 0.00003);
+  std::vector<Position> track;
+  for (std::size_t i = 0; i + 1 < route.size(); ++i)
+  {
+      for (int k = 0; k < 4; ++k)
+      {
+          const double t = k / 4.0;
+          const degrees excursion = (i % 5000 < 20) ? 0.004 : 0;
+          track.emplace_back(route[i].latitude() + t * (route[i+1].latitude() - route[i].latitude()) + noise(random) + excursion,
+                             route[i].longitude() + t * (route[i+1].longitude() - route[i].longitude()) + noise(random));
+      }
+  }
+
+  RouteDeviationMonitor monitor(route, 30);
+  std::size_t deviations = 0;
+  const double seconds = Benchmark::timeOnce([&]
+  {
+      for (const Position & pos : track)
+      {
+          deviations += monitor.update(pos).deviating;
+      }
+  });
+  Benchmark::report("RouteDeviationMonitor::update, 100k-point route", seconds, track.size(), "fixes");
+  Benchmark::reportValue("  fixes flagged as deviating", deviations, "fixes");
+}
@@ -0,0 +1,145 @@
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "sharedFix.h"
+#include "benchmark.h"
+
+using namespace GPS;
+
+namespace
+{
+  const std::string segment = "/parseNMEA-benchmarks-" + std::to_string(::getpid());
+
+  const std::size_t maxLatencies = 1 << 20;
+
+  struct ReaderResult
+  {
+      unsigned long long copies = 0;   // consistent copies taken
+      unsigned long long retries = 0;  // copies spoiled by a concurrent publish
+      unsigned long long observed = 0; // distinct fixes seen
+      double medianLatency = 0;        // from publish to first copy, in nanoseconds
+      double p99Latency = 0;
+  };
+
+  /* Forks a process that copies the latest fix as fast as it can until 'last' fixes have
+   * been published, then reports to 'fd' what it saw.
+   */
+  pid_t forkReader(unsigned long long last, int fd)
+  {
+      const pid_t child = ::fork();
+      if (child != 0) return child;
+
+      FixSubscriber subscriber(segment);
+      ReaderResult result;
+      std::vector<double> latencies;
+      latencies.reserve(maxLatencies);
+      // The first fix was published before the reader started.
+      unsigned long long seen = 1;
+      while (seen < last)
+      {
+          const std::optional<PublishedFix> copy = subscriber.tryLatest();
+          if (!copy)
+          {
+              ++result.retries;
+              continue;
+          }
+          ++result.copies;
+          if (copy->sequence != seen)
+          {
+              const auto now = std::chrono::steady_clock::now().time_since_epoch();
+              if (latencies.size() < maxLatencies)
+                  latencies.push_back(std::chrono::duration<double, std::nano>(now - copy->publishedAt).count());
+              ++result.observed;
+              seen = copy->sequence;
+          }
+      }
+      std::sort(latencies.begin(), latencies.end());
+      if (!latencies.empty())
+      {
+          result.medianLatency = latencies[latencies.size() / 2];
+          result.p99Latency = latencies[latencies.size() * 99 / 100];
+      }
+      [[maybe_unused]] const ssize_t written = ::write(fd, &result, sizeof(result));
+      ::_exit(0);
+  }
+
+  /* Publishes 'fixes' fixes to 'readers' reader processes, one every 'interval' (or as fast
+   * as possible if it is zero), and reports what the publisher and readers achieved.
+   */
+  void publishToReaders(const std::string & label, unsigned readers, unsigned long long fixes,
+                        std::chrono::microseconds interval)
+  {
+      FixPublisher publisher(segment);
+      publisher.publish({Position(0, 0), 0});
+
+      int fds[2];
+      if (::pipe(fds) != 0) return;
+      std::vector<pid_t> children;
+      for (unsigned r = 0; r < readers; ++r) children.push_back(forkReader(fixes, fds[1]));
+      // Let the readers attach and start spinning.
+      std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+      const auto start = std::chrono::steady_clock::now();
+      const double seconds = Benchmark::timeOnce([&]
+      {
+          for (unsigned long long i = 2; i <= fixes; ++i)
+          {
+              if (interval.count() > 0) std::this_thread::sleep_until(start + interval * i);
+              publisher.publish({Position(52.9, -1.2, 58), static_cast<GPS::seconds>(i)}, 12.5);
+          }
+      });
+      Benchmark::report(label + ": publisher", seconds, fixes - 1, "fixes");
+
+      for (unsigned r = 0; r < readers; ++r)
+      {
+          ReaderResult result;
+          if (::read(fds[0], &result, sizeof(result)) != sizeof(result)) break;
+          const std::string reader = label + ": reader " + std::to_string(r + 1);
+          Benchmark::report(reader, seconds, result.copies, "copies");
+          Benchmark::reportValue(reader + " fixes seen", result.observed, "fixes");
+          Benchmark::reportValue(reader + " copies retried", 100.0 * result.retries / (result.copies + result.retries), "%");
+          Benchmark::reportValue(reader + " median latency", result.medianLatency / 1000, "us");
+          Benchmark::reportValue(reader + " 99th percentile latency", result.p99Latency / 1000, "us");
+      }
+      for (pid_t child : children) ::waitpid(child, nullptr, 0);
+      ::close(fds[0]);
+      ::close(fds[1]);
+  }
+}
+
+BENCHMARK( SharedFixOneProcess )
+{
+  FixPublisher publisher(segment);
+  FixSubscriber subscriber(segment);
+  const unsigned long long n = 20000000;
+
+  double seconds = Benchmark::timeOnce([&]
+  {
+      for (unsigned long long i = 1; i <= n; ++i) publisher.publish({Position(52.9, -1.2, 58), static_cast<GPS::seconds>(i)}, 12.5);
+  });
+  Benchmark::report("publish", seconds, n, "fixes");
+
+  double sum = 0;
+  seconds = Benchmark::timeOnce([&]
+  {
+      for (unsigned long long i = 0; i < n; ++i) sum += subscriber.tryLatest()->fix.time;
+  });
+  Benchmark::report("tryLatest, no publisher running", seconds, n, "copies");
+  Benchmark::keep(sum);
+}
+
+BENCHMARK( SharedFixAcrossProcesses )
+{
+  // A receiver-like rate, where latency matters, and a flood, where throughput does.
+  publishToReaders("1 reader, 1 kHz", 1, 1000, std::chrono::microseconds(1000));
+  publishToReaders("4 readers, 1 kHz", 4, 1000, std::chrono::microseconds(1000));
+  publishToReaders("1 reader, flat out", 1, 5000000, std::chrono::microseconds(0));
+  publishToReaders("4 readers, flat out", 4, 5000000, std::chrono::microseconds(0));
+}
@@ -0,0 +1,143 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "earth.h"
+#include "similarity.h"
+#include "benchmark.h"
+
+using namespace GPS;
+
+namespace
+{
+  // A winding route of 'n' points about 10m apart, from near Clifton Campus.
+  std::vector<Position> route(std::size_t n, unsigned seed)
+  {
+      std::mt19937 random(seed);
+      std::normal_distribution<double> turn(0, 0.15);
+      std::uniform_real_distribution<double> start(-0.01, 0.01);
+      std::vector<Position> positions;
+      degrees lat = Earth::CliftonCampus.latitude() + start(random);
+      degrees lon = Earth::CliftonCampus.longitude() + start(random);
+      double heading = start(random) * 300;
+      for (std::size_t i = 0; i < n; ++i)
+      {
+          positions.emplace_back(lat, lon);
+          heading += turn(random);
+          lat += Earth::latitudeSubtendedBy(10 * std::cos(heading));
+          lon += Earth::longitudeSubtendedBy(10 * std::sin(heading), lat);
+      }
+      return positions;
+  }
+
+  // A run along a route, with 'n' fixes spread along it and a few metres of noise.
+  std::vector<Position> run(const std::vector<Position> & route, std::size_t n, unsigned seed)
+  {
+      std::mt19937 random(seed);
+      std::normal_distribution<double> noise(0, 0.00003);
+      std::vector<Position> positions;
+      for (std::size_t i = 0; i < n; ++i)
+      {
+          const Position & p = route[i * (route.size() - 1) / std::max<std::size_t>(n - 1, 1)];
+          positions.emplace_back(p.latitude() + noise(random), p.longitude() + noise(random));
+      }
+      return positions;
+  }
+
+  // DTW over the whole cost matrix, calling Position::horizontalDistanceBetween() for every cell.
+  metres naiveDTW(const std::vector<Position> & a, const std::vector<Position> & b)
+  {
+      const metres infinity = std::numeric_limits<metres>::infinity();
+      std::vector<metres> previous(b.size() + 1, infinity), current(b.size() + 1, infinity);
+      previous[0] = 0;
+      for (const Position & p : a)
+      {
+          current[0] = infinity;
+          for (std::size_t j = 0; j < b.size(); ++j)
+          {
+              current[j+1] = Position::horizontalDistanceBetween(p, b[j])
+                           + std::min({previous[j], previous[j+1], current[j]});
+          }
+          std::swap(previous, current);
+      }
+      return previous.back();
+  }
+}
+
+BENCHMARK( TrajectoryDistance )
+{
+  const std::vector<Position> reference = route(20000, 1);
+  const std::vector<Position> a = run(reference, 20000, 2), b = run(reference, 17000, 3);
+  const Trajectory ta(a), tb(b);
+
+  // Shorter tracks, so that the whole matrix takes seconds.
+  const std::size_t n = 4000;
+  const std::vector<Position> shortA(a.begin(), a.begin() + n), shortB(b.begin(), b.begin() + n);
+  const Trajectory shortTA(shortA), shortTB(shortB);
+  const double cells = static_cast<double>(n) * n;
+
+  metres distance = 0;
+  double seconds = Benchmark::timeOnce([&]{ distance += naiveDTW(shortA, shortB); });
+  Benchmark::report("4k x 4k naive DTW (haversine per cell)", seconds, cells, "cells");
+  seconds = Benchmark::timeOnce([&]{ distance += trajectoryDistance(shortTA, shortTB, {SimilarityMeasure::DTW, 1}); });
+  Benchmark::report("4k x 4k DTW, cached unit vectors", seconds, cells, "cells");
+  seconds = Benchmark::timeOnce([&]{ distance += trajectoryDistance(shortTA, shortTB, {SimilarityMeasure::DiscreteFrechet, 1}); });
+  Benchmark::report("4k x 4k discrete Frechet, cached unit vectors", seconds, cells, "cells");
+
+  seconds = Benchmark::timeOnce([&]{ Benchmark::keep(Trajectory(a)); Benchmark::keep(Trajectory(b)); });
+  Benchmark::report("preparing Trajectories", seconds, a.size() + b.size(), "points");
+
+  for (double band : {0.1, 0.02})
+  {
+      const std::string label = "20k x 17k, band " + std::to_string(band).substr(0, 4) + ", ";
+      seconds = Benchmark::timeOnce([&]{ distance += trajectoryDistance(ta, tb, {SimilarityMeasure::DTW, band}); });
+      Benchmark::report(label + "DTW", seconds, 1, "pairs");
+      seconds = Benchmark::timeOnce([&]{ distance += trajectoryDistance(ta, tb, {SimilarityMeasure::DiscreteFrechet, band}); });
+      Benchmark::report(label + "discrete Frechet", seconds, 1, "pairs");
+      seconds = Benchmark::timeOnce([&]{ distance += trajectoryLowerBound(ta, tb, {SimilarityMeasure::DTW, band}); });
+      Benchmark::report(label + "lower bound", seconds, 1, "pairs");
+  }
+  Benchmark::keep(distance);
+}
+
+BENCHMARK( TrajectoryNearestSearch )
+{
+  // Each day's runs against a library of reference routes.
+  const std::size_t routes = 32, points = 2000;
+  std::vector<Trajectory> references;
+  std::vector<std::vector<Position>> routePositions;
+  for (unsigned r = 0; r < routes; ++r)
+  {
+      routePositions.push_back(route(points, 100 + r));
+      references.emplace_back(routePositions.back());
+  }
+  std::vector<Trajectory> runs;
+  for (unsigned q = 0; q < 16; ++q) runs.emplace_back(run(routePositions[(q * 7) % routes], points - 150 * (q % 4), 500 + q));
+
+  const SimilarityOptions options {SimilarityMeasure::DTW, 0.1};
+  const double pairs = static_cast<double>(runs.size()) * references.size();
+
+  std::vector<TrajectoryMatch> matches;
+  double seconds = Benchmark::timeOnce([&]
+  {
+      for (const std::vector<metres> & distances : distanceMatrix(runs, references, options, 1))
+          matches.push_back({static_cast<std::size_t>(std::min_element(distances.begin(), distances.end()) - distances.begin()), 0});
+  });
+  Benchmark::report("exhaustive, distanceMatrix, 1 thread", seconds, pairs, "pairs");
+
+  seconds = Benchmark::timeOnce([&]{ matches = nearestTrajectories(runs, references, options, 1); });
+  Benchmark::report("pruned, nearestTrajectories, 1 thread", seconds, pairs, "pairs");
+
+  const unsigned cores = std::thread::hardware_concurrency();
+  seconds = Benchmark::timeOnce([&]{ matches = nearestTrajectories(runs, references, options, cores); });
+  Benchmark::report("pruned, nearestTrajectories, " + std::to_string(cores) + " threads", seconds, pairs, "pairs");
+
+  std::size_t correct = 0;
+  for (std::size_t q = 0; q < runs.size(); ++q) correct += matches[q].index == (q * 7) % routes;
+  Benchmark::reportValue("runs matched to their own route", correct, "runs");
+  Benchmark::keep(matches);
+}
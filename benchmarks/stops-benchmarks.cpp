@@ -0,0 +1,129 @@
+#include <cmath>
+#include <random>
+#include <sstream>
+#include <vector>
+
+#include "earth.h"
+#include "cartesian.h"
+#include "parseNMEA.h"
+#include "stops.h"
+#include "benchmark.h"
+
+using namespace GPS;
+
+namespace
+{
+  // A vehicle's day: drives of random length at ~15m/s, with stops of 1-20 minutes, one fix per second.
+  std::vector<Fix> syntheticDay(std::size_t n)
+  {
+      const LocalFrame frame(Earth::CliftonCampus);
+      std::mt19937 random(44);
+      std::uniform_int_distribution<int> legLength(60, 1200);
+      std::normal_distribution<double> jitter(0, 4);
+      std::uniform_real_distribution<double> heading(0, 2 * pi);
+
+      std::vector<Fix> fixes;
+      fixes.reserve(n);
+      metres east = 0, north = 0;
+      bool moving = true;
+      while (fixes.size() < n)
+      {
+          const double direction = heading(random);
+          for (int i = legLength(random); i > 0 && fixes.size() < n; --i)
+          {
+              if (moving)
+              {
+                  east = std::fmod(east + 15 * std::cos(direction), 20000);
+                  north = std::fmod(north + 15 * std::sin(direction), 20000);
+              }
+              const ENU enu {east + jitter(random), north + jitter(random), 0};
+              fixes.push_back({frame.toPosition(enu), static_cast<seconds>(fixes.size())});
+          }
+          moving = !moving;
+      }
+      return fixes;
+  }
+
+  std::vector<Position> positionsOf(const std::vector<Fix> & fixes)
+  {
+      std::vector<Position> positions;
+      for (const Fix & fix : fixes) positions.push_back(fix.position);
+      return positions;
+  }
+
+  // Stay points by scanning forward from each fix with horizontalDistanceBetween: O(n^2) at worst.
+  std::size_t quadraticStopCount(const std::vector<Fix> & fixes, metres radius, seconds minimumDwell)
+  {
+      std::size_t stops = 0;
+      for (std::size_t i = 0; i < fixes.size();)
+      {
+          std::size_t j = i + 1;
+          while (j < fixes.size() &&
+                 Position::horizontalDistanceBetween(fixes[i].position, fixes[j].position) <= radius) ++j;
+          if (j - 1 > i && fixes[j-1].time - fixes[i].time >= minimumDwell) { ++stops; i = j; }
+          else ++i;
+      }
+      return stops;
+  }
+
+  // The O(n^2) DBSCAN neighbour count, for comparison (core points only).
+  std::size_t bruteForceCorePoints(const std::vector<Position> & positions, metres epsilon, std::size_t minimumPoints)
+  {
+      std::size_t cores = 0;
+      for (const Position & p1 : positions)
+      {
+          std::size_t neighbours = 0;
+          for (const Position & p2 : positions)
+              if (Position::horizontalDistanceBetween(p1, p2) <= epsilon) ++neighbours;
+          if (neighbours >= minimumPoints) ++cores;
+      }
+      return cores;
+  }
+}
+
+BENCHMARK( StopDetection )
+{
+  const std::vector<Fix> fixes = syntheticDay(1 << 20);
+
+  std::vector<Stop> stops;
+  double seconds = Benchmark::timeOnce([&]{ stops = stopsFromFixes(fixes, 50, 300); });
+  Benchmark::report("StopDetector, synthetic", seconds, fixes.size(), "fixes");
+  Benchmark::reportValue("stops found", stops.size(), "stops");
+
+  std::size_t count = 0;
+  seconds = Benchmark::timeOnce([&]{ count = quadraticStopCount(fixes, 50, 300); });
+  Benchmark::report("haversine scan from each fix, synthetic", seconds, fixes.size(), "fixes");
+  Benchmark::keep(count);
+
+  std::istringstream log(Benchmark::repeatToSize(Benchmark::readNMEALog("gga_rmc-1.log"), 4 << 20));
+  const std::vector<Fix> logFixes = NMEA::fixesFromLog(log);
+  seconds = Benchmark::timeOnce([&]{ stops = stopsFromFixes(logFixes, 50, 120); });
+  Benchmark::report("StopDetector, gga_rmc-1.log", seconds, logFixes.size(), "fixes");
+  seconds = Benchmark::timeOnce([&]{ count = quadraticStopCount(logFixes, 50, 120); });
+  Benchmark::report("haversine scan from each fix, gga_rmc-1.log", seconds, logFixes.size(), "fixes");
+  Benchmark::keep(count);
+}
+
+BENCHMARK( GridDBSCAN )
+{
+  const std::vector<Position> positions = positionsOf(syntheticDay(1 << 20));
+
+  Clustering clustering;
+  double seconds = Benchmark::timeOnce([&]{ clustering = clusterPositions(positions, 20, 30); });
+  Benchmark::report("clusterPositions, 1M synthetic", seconds, positions.size(), "positions");
+  Benchmark::reportValue("clusters", clustering.clusterCount, "clusters");
+
+  const std::vector<Position> sample(positions.begin(), positions.begin() + 5000);
+  seconds = Benchmark::timeOnce([&]{ clustering = clusterPositions(sample, 20, 30); });
+  Benchmark::report("clusterPositions, 5k synthetic", seconds, sample.size(), "positions");
+  std::size_t cores = 0;
+  seconds = Benchmark::timeOnce([&]{ cores = bruteForceCorePoints(sample, 20, 30); });
+  Benchmark::report("brute-force neighbours, 5k synthetic", seconds, sample.size(), "positions");
+  Benchmark::keep(cores);
+
+  std::istringstream log(Benchmark::readNMEALog("gga_rmc-1.log"));
+  const std::vector<Position> logPositions = NMEA::positionsFromLog(log);
+  seconds = Benchmark::timeOnce([&]{ clustering = clusterPositions(logPositions, 20, 10); });
+  Benchmark::report("clusterPositions, gga_rmc-1.log", seconds, logPositions.size(), "positions");
+  Benchmark::reportValue("clusters in gga_rmc-1.log", clustering.clusterCount, "clusters");
+}
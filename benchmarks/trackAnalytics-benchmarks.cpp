@@ -0,0 +1,74 @@
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+#include "parseNMEA.h"
+#include "trackAnalytics.h"
+#include "benchmark.h"
+
+using namespace GPS;
+
+namespace
+{
+  /* A corpus of log files with a heavily skewed size distribution: file i holds roughly
+   * 1/(i+1) of the largest file's sentences, so a handful of files dominate the work.
+   */
+  std::vector<std::string> writeSkewedCorpus(const std::filesystem::path & dir, unsigned numFiles)
+  {
+      const std::string sample = Benchmark::readNMEALog("gga_rmc-1.log") + Benchmark::readNMEALog("gll.log");
+      std::filesystem::create_directories(dir);
+
+      std::vector<std::string> paths;
+      for (unsigned i = 0; i < numFiles; ++i)
+      {
+          const std::string path = (dir / ("log-" + std::to_string(i) + ".log")).string();
+          std::ofstream file{path};
+          file << Benchmark::repeatToSize(sample, (16u << 20) / (i + 1));
+          paths.push_back(path);
+      }
+      return paths;
+  }
+
+  // Each thread takes a fixed, contiguous share of the files.
+  void summariseStatically(const std::vector<std::string> & paths, unsigned threads)
+  {
+      std::vector<TrackSummary> summaries(paths.size());
+      std::vector<std::thread> workers;
+      const std::size_t share = (paths.size() + threads - 1) / threads;
+      for (unsigned t = 0; t < threads; ++t)
+      {
+          workers.emplace_back([&, t]
+          {
+              for (std::size_t i = t * share; i < std::min(paths.size(), (t + 1) * share); ++i)
+              {
+                  std::ifstream log{paths[i]};
+                  summaries[i] = summariseTrack(NMEA::positionsFromLog(log));
+              }
+          });
+      }
+      for (std::thread & worker : workers) worker.join();
+      Benchmark::keep(summaries);
+  }
+}
+
+BENCHMARK( SkewedCorpusStaticVersusWorkStealing )
+{
+  const std::filesystem::path dir = std::filesystem::temp_directory_path() / "nmea-skewed-corpus";
+  const std::vector<std::string> paths = writeSkewedCorpus(dir, 64);
+
+  std::uintmax_t bytes = 0;
+  for (const std::string & path : paths) bytes += std::filesystem::file_size(path);
+
+  const unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+  for (unsigned threads = 1; threads <= std::max(4u, cores); threads *= 2)
+  {
+      double seconds = Benchmark::timeOnce([&]{ summariseStatically(paths, threads); });
+      Benchmark::report("static split, " + std::to_string(threads) + " threads", seconds, bytes / 1e6, "MB");
+
+      seconds = Benchmark::timeOnce([&]{ Benchmark::keep(summariseLogs(paths, threads)); });
+      Benchmark::report("work stealing, " + std::to_string(threads) + " threads", seconds, bytes / 1e6, "MB");
+  }
+
+  std::filesystem::remove_all(dir);
+}
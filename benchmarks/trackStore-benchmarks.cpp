@@ -0,0 +1,152 @@
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "trackStore.h"
+#include "benchmark.h"
+
+using namespace GPS;
+
+namespace
+{
+  const std::size_t trackLength = 4000000;
+  const seconds queryWindow = 600; // a dashboard's "last ten minutes"
+
+  Fix fixAt(std::size_t i)
+  {
+      return {Position(52.9 + (i % 1000) * 1e-5, -1.2), static_cast<seconds>(i)};
+  }
+
+  // The baseline: a vector, guarded by a mutex for both appending and querying.
+  struct LockedTrack
+  {
+      std::mutex mutex;
+      std::vector<Fix> fixes;
+
+      void append(const Fix & fix)
+      {
+          std::lock_guard lock(mutex);
+          fixes.push_back(fix);
+      }
+
+      double recentLatitudeSum()
+      {
+          std::lock_guard lock(mutex);
+          if (fixes.empty()) return 0;
+          const seconds from = fixes.back().time - queryWindow;
+          const auto first = std::lower_bound(fixes.begin(), fixes.end(), from,
+                                              [](const Fix & fix, seconds t) { return fix.time < t; });
+          double sum = 0;
+          for (auto it = first; it != fixes.end(); ++it) sum += it->position.latitude();
+          return sum;
+      }
+  };
+
+  struct LockFreeTrack
+  {
+      TrackStore store;
+
+      void append(const Fix & fix)
+      {
+          store.append(fix);
+      }
+
+      double recentLatitudeSum()
+      {
+          const TrackSnapshot snapshot = store.snapshot();
+          if (snapshot.empty()) return 0;
+          const seconds latest = snapshot[snapshot.size() - 1].time;
+          const auto [first, last] = snapshot.indicesBetween(latest - queryWindow, latest);
+          double sum = 0;
+          snapshot.forEachSpan(first, last, [&sum](std::span<const Fix> span)
+          {
+              for (const Fix & fix : span) sum += fix.position.latitude();
+          });
+          return sum;
+      }
+  };
+
+  /* Appends a whole track while 'readers' threads repeatedly query its latest ten minutes,
+   * and reports the rates of both.
+   */
+  template <typename Track>
+  void appendWhileQuerying(const std::string & label, unsigned readers)
+  {
+      Track track;
+      std::atomic<bool> writing {true};
+      std::atomic<unsigned long long> queries {0};
+      std::vector<std::thread> threads;
+      for (unsigned r = 0; r < readers; ++r)
+      {
+          threads.emplace_back([&]
+          {
+              unsigned long long n = 0;
+              double sum = 0;
+              while (writing.load(std::memory_order_relaxed))
+              {
+                  sum += track.recentLatitudeSum();
+                  ++n;
+              }
+              Benchmark::keep(sum);
+              queries += n;
+          });
+      }
+
+      const double seconds = Benchmark::timeOnce([&]
+      {
+          for (std::size_t i = 0; i < trackLength; ++i) track.append(fixAt(i));
+      });
+      writing = false;
+      for (std::thread & thread : threads) thread.join();
+
+      const std::string name = label + ", " + std::to_string(readers) + " reader(s)";
+      Benchmark::report(name + ": appends", seconds, trackLength, "fixes");
+      if (readers > 0) Benchmark::report(name + ": queries", seconds, queries, "queries");
+  }
+}
+
+BENCHMARK( TrackStoreContention )
+{
+  Benchmark::reportValue("hardware threads", std::max(1u, std::thread::hardware_concurrency()), "threads");
+  for (unsigned readers : {0, 1, 4})
+  {
+      appendWhileQuerying<LockedTrack>("mutex and vector", readers);
+      appendWhileQuerying<LockFreeTrack>("TrackStore", readers);
+  }
+}
+
+BENCHMARK( TrackStoreScan )
+{
+  TrackStore store;
+  for (std::size_t i = 0; i < trackLength; ++i) store.append(fixAt(i));
+  const TrackSnapshot snapshot = store.snapshot();
+
+  double sum = 0;
+  double seconds = Benchmark::timeOnce([&]
+  {
+      snapshot.forEachSpan(0, snapshot.size(), [&sum](std::span<const Fix> span)
+      {
+          for (const Fix & fix : span) sum += fix.position.latitude();
+      });
+  });
+  Benchmark::report("scan by span", seconds, snapshot.size(), "fixes");
+
+  seconds = Benchmark::timeOnce([&]
+  {
+      for (std::size_t i = 0; i < snapshot.size(); ++i) sum += snapshot[i].position.latitude();
+  });
+  Benchmark::report("scan by index", seconds, snapshot.size(), "fixes");
+
+  const std::size_t lookups = 1000000;
+  std::size_t found = 0;
+  seconds = Benchmark::timeOnce([&]
+  {
+      for (std::size_t i = 0; i < lookups; ++i) found += snapshot.indicesBetween((i * 7919) % trackLength, (i * 7919) % trackLength + 60).second;
+  });
+  Benchmark::report("time range lookup", seconds, lookups, "lookups");
+  Benchmark::keep(sum);
+  Benchmark::keep(found);
+}
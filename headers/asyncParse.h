@@ -0,0 +1,56 @@
+#ifndef ASYNCPARSE_H_191026
+#define ASYNCPARSE_H_191026
+
+#include <cstddef>
+#include <istream>
+#include <string>
+#include <string_view>
+
+#include "generator.h"
+#include "position.h"
+
+namespace NMEA
+{
+  /* A pipeline equivalent to positionsFromLog(), built from coroutine generators:
+   *
+   *   readBlocks()  ->  sentencesIn()  ->  positionsIn()  ->  consumer
+   *
+   * readBlocks() reads the stream on a background task (std::async) so that I/O overlaps
+   * with parsing.  Blocks are passed to the parsing stages through a BoundedQueue, so a
+   * slow consumer stalls the reader rather than letting it buffer the whole file.
+   * The remaining stages run on the consumer's thread, one element at a time, as the
+   * consumer iterates:
+   *
+   *   for (const GPS::Position & pos : asyncPositionsFromLog(log)) { ... }
+   */
+
+  struct AsyncParseOptions
+  {
+      std::size_t blockSize  = 64 * 1024; // bytes per read
+      std::size_t queueDepth = 4;         // blocks read ahead of the parser
+  };
+
+
+  /* Yields the contents of the stream in blocks of (at most) options.blockSize bytes,
+   * read ahead on a background task.
+   */
+  GPS::Generator<std::string> readBlocks(std::istream &, AsyncParseOptions = {});
+
+
+  /* Yields the whitespace-separated tokens (one per sentence in a well-formed log)
+   * of a sequence of blocks, including those that straddle block boundaries.
+   */
+  GPS::Generator<std::string_view> sentencesIn(GPS::Generator<std::string> blocks);
+
+
+  /* Yields the Positions of the valid sentences in a sequence of sentences.
+   * Validity is as defined by positionsFromLog().
+   */
+  GPS::Generator<GPS::Position> positionsIn(GPS::Generator<std::string_view> sentences);
+
+
+  // Yields the same Positions as positionsFromLog() would return.
+  GPS::Generator<GPS::Position> asyncPositionsFromLog(std::istream &, AsyncParseOptions = {});
+}
+
+#endif
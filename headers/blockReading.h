@@ -0,0 +1,67 @@
+#ifndef BLOCKREADING_H_191026
+#define BLOCKREADING_H_191026
+
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <istream>
+#include <optional>
+#include <string>
+
+#include "boundedQueue.h"
+#include "generator.h"
+
+namespace NMEA
+{
+  /* The parts of the background block-reading pipelines shared by readBlocks() and the
+   * decompressing readers (compressedLog.h).  Internal to the library.
+   */
+
+
+  // Closes the queue when it goes out of scope, releasing a blocked producer or consumer.
+  struct CloseOnExit
+  {
+      GPS::BoundedQueue<std::string> & queue;
+      ~CloseOnExit() { queue.close(); }
+  };
+
+
+  /* The next block of at most 'blockSize' bytes from the stream; empty at the end of it.
+   */
+  inline std::string readBlock(std::istream & source, std::size_t blockSize)
+  {
+      std::string block(blockSize, '\0');
+      source.read(block.data(), blockSize);
+      block.resize(source.gcount());
+      return block;
+  }
+
+
+  /* Runs 'produce' on a background task (std::async), yielding the blocks it pushes to a
+   * BoundedQueue of the given depth.  If the consumer stops early, the queue is closed so
+   * that a blocked push() fails and 'produce' can return.  Any exception thrown by
+   * 'produce' is rethrown to the consumer once the queue is drained.
+   */
+  inline GPS::Generator<std::string> blocksFromTask(std::size_t queueDepth,
+      std::function<void(GPS::BoundedQueue<std::string> &)> produce)
+  {
+      GPS::BoundedQueue<std::string> blocks(queueDepth);
+
+      std::future<void> producer = std::async(std::launch::async, [&]
+      {
+          CloseOnExit closeWhenDone{blocks};
+          produce(blocks);
+      });
+      // Declared after 'producer', so if the consumer stops early the queue is closed
+      // (unblocking the producer) before the future waits for it.
+      CloseOnExit closeOnExit{blocks};
+
+      while (std::optional<std::string> block = blocks.pop())
+      {
+          co_yield *block;
+      }
+      producer.get(); // propagates any exception thrown by 'produce'
+  }
+}
+
+#endif
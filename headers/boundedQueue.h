@@ -0,0 +1,71 @@
+#ifndef BOUNDEDQUEUE_H_191026
+#define BOUNDEDQUEUE_H_191026
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <optional>
+
+namespace GPS
+{
+  /* A fixed-capacity FIFO queue for handing work between pipeline stages running on
+   * different threads.
+   *
+   * A producer that gets ahead of its consumer blocks in push() until there is room,
+   * which bounds the memory held between the stages (backpressure).  Either side may
+   * close() the queue: push() then fails, and pop() drains the remaining elements before
+   * reporting that the queue is exhausted.
+   */
+  template <typename T>
+  class BoundedQueue
+  {
+    public:
+      explicit BoundedQueue(std::size_t capacity) : capacity(capacity > 0 ? capacity : 1) {}
+
+      /* Blocks until there is room for the element.
+       * Returns false (discarding the element) if the queue has been closed.
+       */
+      bool push(T element)
+      {
+          std::unique_lock<std::mutex> lock(mutex);
+          notFull.wait(lock, [this]{ return closed || elements.size() < capacity; });
+          if (closed) return false;
+          elements.push_back(std::move(element));
+          notEmpty.notify_one();
+          return true;
+      }
+
+      /* Blocks until an element is available.
+       * Returns nothing once the queue has been closed and all elements have been popped.
+       */
+      std::optional<T> pop()
+      {
+          std::unique_lock<std::mutex> lock(mutex);
+          notEmpty.wait(lock, [this]{ return closed || !elements.empty(); });
+          if (elements.empty()) return std::nullopt;
+          std::optional<T> element(std::move(elements.front()));
+          elements.pop_front();
+          notFull.notify_one();
+          return element;
+      }
+
+      void close()
+      {
+          std::lock_guard<std::mutex> lock(mutex);
+          closed = true;
+          notEmpty.notify_all();
+          notFull.notify_all();
+      }
+
+    private:
+      const std::size_t capacity;
+      std::deque<T> elements;
+      bool closed = false;
+      std::mutex mutex;
+      std::condition_variable notEmpty;
+      std::condition_variable notFull;
+  };
+}
+
+#endif
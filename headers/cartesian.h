@@ -0,0 +1,76 @@
+#ifndef CARTESIAN_H_191026
+#define CARTESIAN_H_191026
+
+#include <cstddef>
+
+#include "types.h"
+#include "position.h"
+
+namespace GPS
+{
+  /* Earth-centred, Earth-fixed Cartesian coordinates, in metres, on the same sphere (of
+   * Earth::meanRadius) as Position::horizontalDistanceBetween():
+   * x towards (0,0), y towards (0,90), z towards the NorthPole.
+   */
+  struct ECEF
+  {
+      metres x, y, z;
+  };
+
+
+  // East-North-Up coordinates, in metres, in a LocalFrame.
+  struct ENU
+  {
+      metres east, north, up;
+  };
+
+
+  ECEF toECEF(const Position &);
+
+  // Convert ECEF coordinates back to a Position (the inverse of toECEF()).
+  Position fromECEF(const ECEF &);
+
+  // Batch version of toECEF(), over 'n' Positions.
+  void toECEF(const Position * in, ECEF * out, std::size_t n);
+
+
+  /* The straight-line distance between two points.
+   * For Positions at the same elevation this is the chord, which is shorter than the
+   * great-circle distance by a relative error of about (d/R)^2/24: under 1e-9 for d < 1km.
+   */
+  metres distanceBetween(const ECEF &, const ECEF &);
+
+
+  /* A local tangent plane anchored at a reference Position: 'east' and 'north' lie in the
+   * horizontal plane at the origin, and 'up' is along the Earth's radius.
+   *
+   * Within a few kilometres of the origin, pythagoras(east, north) approximates the
+   * horizontal distance from the origin to relative accuracy (d/R)^2, and
+   * pythagoras(e2-e1, n2-n1) the horizontal distance between two nearby Positions,
+   * without trigonometry per pair.
+   *
+   * At the poles east and north are taken as if approaching along the origin's meridian.
+   */
+  class LocalFrame
+  {
+    public:
+      explicit LocalFrame(Position origin);
+
+      const Position & origin() const;
+
+      ENU toENU(const Position &) const;
+      ENU toENU(const ECEF &) const;
+
+      Position toPosition(const ENU &) const;
+
+      // Batch version of toENU(), over 'n' Positions.
+      void toENU(const Position * in, ENU * out, std::size_t n) const;
+
+    private:
+      Position originPos;
+      ECEF originECEF;
+      double sinLat, cosLat, sinLon, cosLon;
+  };
+}
+
+#endif
@@ -0,0 +1,110 @@
+#ifndef COLUMNAREXPORT_H_191026
+#define COLUMNAREXPORT_H_191026
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "fix.h"
+
+namespace NMEA
+{
+  /* A columnar file format for parsed fixes, laid out like Parquet (column chunks in
+   * row batches, with the schema-level metadata in a footer) for loading into analytics
+   * tools without going through text.
+   *
+   *   file   := magic batch* footer
+   *   batch  := rows:u32 pad:u32 latitude:f64[rows] longitude:f64[rows]
+   *             elevation:f64[rows] time:f64[rows] format:u8[rows] (padded to 8 bytes)
+   *   footer := dictionarySize:u32 (length:u8 chars)*           -- sentence formats
+   *             batchCount:u32 (offset:u64)*                     -- of each batch
+   *             totalRows:u64 footerLength:u32 magic
+   *
+   * 'magic' is the 8 characters "NMEACOL1".  Latitude and longitude are in degrees,
+   * elevation in metres, time in seconds since midnight UTC; each format entry is an index
+   * into the dictionary of sentence formats.  Numbers are in the host's byte order
+   * (little-endian on all supported platforms).
+   */
+
+
+  /* Writes fixes to a columnar file, buffering a batch of rows per column and writing each
+   * column of a batch with a single write.
+   */
+  class ColumnarWriter
+  {
+    public:
+      explicit ColumnarWriter(std::ostream &, std::size_t batchRows = 64 * 1024);
+
+      // Finishes the file, if finish() has not been called.
+      ~ColumnarWriter();
+
+      ColumnarWriter(const ColumnarWriter &) = delete;
+      ColumnarWriter & operator=(const ColumnarWriter &) = delete;
+
+      /* Appends a row.  'format' is the sentence format, e.g. "GGA".
+       * Throws a std::invalid_argument exception if there would be more than 256 distinct
+       * formats, or if the writer has been finished.
+       */
+      void append(const GPS::Fix &, std::string_view format);
+
+      // Writes any partial batch and the footer.  No rows may be appended afterwards.
+      void finish();
+
+      std::uint64_t rowsWritten() const;
+
+    private:
+      void writeBatch();
+
+      std::ostream & out;
+      std::size_t batchRows;
+      std::vector<double> latitudes, longitudes, elevations, times;
+      std::vector<std::uint8_t> formats;
+      std::vector<std::string> dictionary;
+      std::vector<std::uint64_t> batchOffsets;
+      std::uint64_t offset = 0;
+      std::uint64_t totalRows = 0;
+      bool finished = false;
+  };
+
+
+  // One batch of rows read back from a columnar file.
+  struct ColumnBatch
+  {
+      std::vector<double> latitudes, longitudes, elevations, times;
+      std::vector<std::uint8_t> formats;
+  };
+
+
+  /* Reads a columnar file written by ColumnarWriter.
+   * Throws a std::invalid_argument exception if the data is not a valid columnar file.
+   */
+  class ColumnarReader
+  {
+    public:
+      explicit ColumnarReader(std::istream &);
+
+      std::uint64_t rows() const;
+      std::size_t batchCount() const;
+      const std::vector<std::string> & formatDictionary() const;
+
+      ColumnBatch readBatch(std::size_t);
+
+    private:
+      std::istream & in;
+      std::vector<std::string> dictionary;
+      std::vector<std::uint64_t> batchOffsets;
+      std::uint64_t totalRows;
+  };
+
+
+  /* Parses a log (as fixesFromLog() does) and writes its fixes, with their sentence formats,
+   * straight to a columnar file.  Returns the number of rows written.
+   */
+  std::uint64_t exportColumnar(std::istream & log, std::ostream & out, std::size_t batchRows = 64 * 1024);
+}
+
+#endif
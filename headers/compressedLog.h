@@ -0,0 +1,81 @@
+#ifndef COMPRESSEDLOG_H_191026
+#define COMPRESSEDLOG_H_191026
+
+#include <future>
+#include <istream>
+#include <streambuf>
+#include <string>
+
+#include "asyncParse.h"
+#include "boundedQueue.h"
+#include "generator.h"
+#include "position.h"
+
+namespace NMEA
+{
+  /* Reading of gzip-compressed logs without decompressing them to a file first.
+   *
+   * The compressed stream is decompressed on a background task, in blocks handed to the
+   * parser through a BoundedQueue, so that decompression and parsing overlap.  Streams
+   * that are not gzip-compressed are passed through unchanged, so callers need not know
+   * whether a log is compressed.  Concatenated gzip members (e.g. from appending to a .gz
+   * file) are decompressed in sequence.
+   *
+   * Only gzip (and zlib) compression is supported: a zstd-compressed stream is reported as
+   * an error rather than being passed through as text.
+   */
+
+
+  /* A stream buffer yielding the decompressed contents of 'source', which must outlive it.
+   * Errors (corrupt or truncated data) are thrown from the read that reaches them.
+   */
+  class DecompressingStreambuf : public std::streambuf
+  {
+    public:
+      explicit DecompressingStreambuf(std::istream & source, AsyncParseOptions = {});
+      ~DecompressingStreambuf();
+
+      DecompressingStreambuf(const DecompressingStreambuf &) = delete;
+      DecompressingStreambuf & operator=(const DecompressingStreambuf &) = delete;
+
+    protected:
+      int_type underflow() override;
+
+    private:
+      GPS::BoundedQueue<std::string> blocks;
+      std::string current;
+      std::future<void> decompressor;
+  };
+
+
+  /* An input stream over a DecompressingStreambuf, for passing to positionsFromLog() and the
+   * other stream-based parsers, e.g.
+   *
+   *   std::ifstream file("log.nmea.gz", std::ios::binary);
+   *   DecompressingStream log(file);
+   *   std::vector<GPS::Position> positions = positionsFromLog(log);
+   *
+   * Decompression errors are thrown as std::invalid_argument exceptions from the parser
+   * (the stream's exception mask includes badbit).
+   */
+  class DecompressingStream : public std::istream
+  {
+    public:
+      explicit DecompressingStream(std::istream & source, AsyncParseOptions = {});
+
+    private:
+      DecompressingStreambuf buffer;
+  };
+
+
+  /* As readBlocks(), but yields the decompressed contents of the stream.
+   * Compose with sentencesIn() and positionsIn(), as asyncPositionsFromCompressedLog() does.
+   */
+  GPS::Generator<std::string> decompressedBlocks(std::istream &, AsyncParseOptions = {});
+
+
+  // As asyncPositionsFromLog(), for a possibly compressed log.
+  GPS::Generator<GPS::Position> asyncPositionsFromCompressedLog(std::istream &, AsyncParseOptions = {});
+}
+
+#endif
@@ -0,0 +1,153 @@
+#ifndef COMPRESSEDTRACK_H_191026
+#define COMPRESSEDTRACK_H_191026
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "types.h"
+#include "position.h"
+#include "fix.h"
+
+namespace GPS
+{
+  // The extent of the Fixes in one chunk of a CompressedTrack.
+  struct ChunkSummary
+  {
+      std::size_t count;
+      seconds earliest, latest;
+      degrees minLatitude, maxLatitude;
+      degrees minLongitude, maxLongitude;
+      metres  minElevation, maxElevation;
+  };
+
+
+  /* Fixes held column by column, as decoded by CompressedTrack::decodeChunkColumns():
+   * the values of Fix 'i' are at index 'i' of each array.  No Positions are constructed,
+   * so scans that need only some of the values avoid their cost.
+   */
+  struct FixColumns
+  {
+      std::vector<degrees> latitudes, longitudes;
+      std::vector<metres>  elevations;
+      std::vector<seconds> times;
+
+      std::size_t size() const { return times.size(); }
+
+      void clear()
+      {
+          latitudes.clear();
+          longitudes.clear();
+          elevations.clear();
+          times.clear();
+      }
+
+      Fix fix(std::size_t i) const
+      {
+          return { Position(latitudes[i], longitudes[i], elevations[i]), times[i] };
+      }
+  };
+
+
+  /* An in-memory store of a track's Fixes, compressed in the style of Gorilla (Pelkonen et
+   * al., 2015) to a few bytes per Fix.
+   *
+   * Each Fix is held to a fixed resolution: latitude and longitude to 1e-5 minutes of arc
+   * (about 2 cm; finer than NMEA receivers report), elevation to the centimetre, and time
+   * to the millisecond.  Fixes decode to the nearest values at that resolution.
+   *
+   * Fixes are compressed in chunks of 1024, each column separately, as the delta-of-delta
+   * of successive whole-number values.  These are packed in blocks of 64 (in the style of
+   * PFor), each at the fewest bits that hold its largest, recorded in a byte before the
+   * block; so a run of zeros costs a byte per block, and decoding a block takes no branches
+   * on its contents.  Before encoding, a column's values are divided by their greatest common difference, so
+   * a log written to 4 decimal places of a minute, or to whole seconds, costs no more than
+   * one written to that resolution.  Each column also chooses whether to predict from the
+   * Fix before or the Fix before that (a stride of 1 or 2), whichever is smaller: a receiver
+   * interleaving GGA and RMC sentences repeats each time and position (and alternates
+   * elevation with the 0 of an RMC sentence), which a stride of 2 predicts exactly.
+   *
+   * Each chunk keeps a summary of its Fixes' extent, so that range queries decode only the
+   * chunks that can contain matches.  The Fixes not yet making up a full chunk are held
+   * uncompressed until it fills, or until seal() is called.
+   */
+  class CompressedTrack
+  {
+    public:
+      static constexpr std::size_t chunkSize = 1024;
+
+      void append(const Fix &);
+
+      /* Compresses any Fixes held uncompressed into a (short) chunk, and frees the storage
+       * they were held in.
+       */
+      void seal();
+
+      std::size_t size() const;
+
+      // The memory used, in bytes, including that of Fixes held uncompressed.
+      std::size_t bytesUsed() const;
+
+      // The number of chunks, including a final one of Fixes held uncompressed.
+      std::size_t chunkCount() const;
+
+      ChunkSummary summary(std::size_t chunk) const;
+
+      // Appends the Fixes of a chunk to 'fixes'.
+      void decodeChunk(std::size_t chunk, std::vector<Fix> & fixes) const;
+
+      /* Appends the values of a chunk's Fixes to 'columns'.  The values are not checked
+       * as a Position's are, but every value appended by a CompressedTrack is in range.
+       */
+      void decodeChunkColumns(std::size_t chunk, FixColumns & columns) const;
+
+      std::vector<Fix> fixes() const;
+
+      FixColumns columns() const;
+
+      // The Fixes recorded between 'from' and 'to' inclusive, in order.
+      std::vector<Fix> fixesBetween(seconds from, seconds to) const;
+
+      /* The Fixes within the latitude and longitude bounds of two corners, in order.
+       * Boxes spanning the anti-meridian are not supported.
+       */
+      std::vector<Fix> fixesWithin(const Position & southWest, const Position & northEast) const;
+
+    private:
+      static constexpr std::size_t columnCount = 4; // latitude, longitude, elevation, time
+
+      struct Column
+      {
+          std::int64_t first;       // the first value
+          std::int64_t scale;       // the common difference the values were divided by
+          std::uint32_t byteOffset; // of the encoded values in the chunk's data
+          std::uint8_t stride;
+          bool small;               // whether every value is less than 2^51 in magnitude
+      };
+
+      struct Chunk
+      {
+          ChunkSummary summary;
+          std::array<Column, columnCount> columns;
+          std::vector<std::uint8_t> data;
+      };
+
+      // The columns of the Fixes not yet compressed, at the stored resolution.
+      using Columns = std::array<std::vector<std::int64_t>, columnCount>;
+
+      static ChunkSummary summarise(const Columns &);
+      static Chunk compress(const Columns &);
+
+      // Writes the values of each Fix, in order, to the four arrays.
+      static void decode(const Chunk &, degrees * latitudes, degrees * longitudes,
+                         metres * elevations, seconds * times);
+      static void decode(const Columns &, degrees * latitudes, degrees * longitudes,
+                         metres * elevations, seconds * times);
+
+      std::vector<Chunk> chunks;
+      Columns pending;
+  };
+}
+
+#endif
@@ -0,0 +1,70 @@
+#ifndef DENSITYGRID_H_191026
+#define DENSITYGRID_H_191026
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+#include "types.h"
+#include "position.h"
+
+namespace GPS
+{
+  /* A coverage heatmap: counts of Positions binned into a regular latitude/longitude grid.
+   *
+   * The grid covers the box between 'southWest' and 'northEast' (which must not cross the
+   * anti-meridian), extended north and east to a whole number of cells.  Cells are
+   * 'cellSize' metres north-south, and 'cellSize' metres east-west at the latitude of the
+   * centre of the box, so cells are narrower towards the pole and wider towards the
+   * equator.  Row 0 is the southernmost row, and column 0 the westernmost column.
+   * A Position on the northern or eastern edge of the grid falls in the last row or column;
+   * Positions outside the grid are counted separately, not binned.
+   */
+  class DensityGrid
+  {
+    public:
+      using Count = std::uint32_t;
+
+      DensityGrid(Position southWest, Position northEast, metres cellSize);
+
+      std::size_t rows() const;
+      std::size_t columns() const;
+
+      void add(const Position &);
+
+      /* Adds all of the Positions, on the given number of threads (0 for one per core).
+       * Each thread bins a contiguous share of the Positions into its own histogram; the
+       * histograms are then summed into this grid, again split across the threads.
+       */
+      void add(const std::vector<Position> &, unsigned threads = 0);
+
+      // The count of cell ('row','column'), or std::out_of_range.
+      Count count(std::size_t row, std::size_t column) const;
+
+      // The number of Positions binned, and the number that fell outside the grid.
+      unsigned long long total() const;
+      unsigned long long outside() const;
+
+      /* Writes the grid as a binary ("P5") PGM image, north at the top.  Counts are scaled
+       * linearly so that the busiest cell is white; the image uses 8-bit samples when the
+       * busiest cell has at most 255 Positions (counts are then written unscaled), and
+       * 16-bit samples otherwise.
+       */
+      void writePGM(std::ostream &) const;
+
+    private:
+      // The index of the cell containing the Position, or 'counts.size()' if it is outside the grid.
+      std::size_t cellIndex(degrees lat, degrees lon) const;
+
+      degrees south, west;
+      degrees latitudePerCell, longitudePerCell;
+      double cellsPerDegreeLatitude, cellsPerDegreeLongitude;
+      std::size_t rowCount, columnCount;
+
+      std::vector<Count> counts; // row-major, row 0 first
+      unsigned long long outsideCount = 0;
+  };
+}
+
+#endif
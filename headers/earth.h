@@ -1,25 +1,48 @@
 #ifndef EARTH_H_120218
 #define EARTH_H_120218
 
+#include <cstddef>
+
+#include "geometry.h"
 #include "position.h"
 
 namespace GPS
 {
   namespace Earth
   {
-      extern const Position NorthPole;
-      extern const Position EquatorialMeridian;
-      extern const Position EquatorialAntiMeridian;
-      extern const Position CliftonCampus;
-      extern const Position CityCampus;
-      extern const Position Pontianak;
-
-      extern const metres meanRadius;
-      extern const metres equatorialCircumference;
-      extern const metres polarCircumference;
-
-      degrees latitudeSubtendedBy(metres);
+      // Constructed at compile time, so they are safe to use during static initialisation.
+      inline constexpr Position NorthPole = Position(poleLatitude,0,0);
+      inline constexpr Position EquatorialMeridian = Position(0,0,0);
+      inline constexpr Position EquatorialAntiMeridian = Position(0,antiMeridianLongitude,0);
+      inline constexpr Position CliftonCampus = Position(52.91249953,-1.18402513,58);
+      inline constexpr Position CityCampus = Position(52.9581383,-1.1542364,53);
+      inline constexpr Position Pontianak = Position(0,109.322134,0);
+
+      inline constexpr metres meanRadius = 6371008.8;
+      inline constexpr metres equatorialCircumference = 40075160;
+      inline constexpr metres polarCircumference = 40008000;
+
+      constexpr degrees latitudeSubtendedBy(metres distance)
+      {
+          return (distance / polarCircumference) * fullRotation;
+      }
+
       degrees longitudeSubtendedBy(metres,degrees lat);
+
+      /* The angle subtended at the centre by an arc of the given length on a sphere of
+       * meanRadius: the span to use with Position::horizontalDistanceBetween().
+       */
+      constexpr degrees angleSubtendedBy(metres distance)
+      {
+          return radToDeg(distance / meanRadius);
+      }
+
+      /* Converts arrays of 'n' latitudes, longitudes and elevations to Earth-centred,
+       * Earth-fixed Cartesian coordinates (in metres) on a sphere of meanRadius:
+       * x towards (0,0), y towards (0,90), z towards the NorthPole.
+       */
+      void toECEF(const degrees * lat, const degrees * lon, const metres * ele,
+                  metres * x, metres * y, metres * z, std::size_t n);
   }
 }
 
@@ -0,0 +1,39 @@
+#ifndef ENCODENMEA_H_191026
+#define ENCODENMEA_H_191026
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include "types.h"
+#include "fix.h"
+
+namespace NMEA
+{
+  // The longest sentence that encodeSentence() writes, including the terminating newline.
+  const std::size_t maxEncodedSentenceLength = 96;
+
+  /* Writes a GLL, GGA or RMC sentence reporting a Fix (the inverse of interpreting it), and
+   * a terminating '\n', to 'buffer', which must have room for maxEncodedSentenceLength
+   * characters.  Returns the number of characters written.
+   *
+   * Coordinates are written in DDM to 4 decimal places of a minute (about 0.2m), times to
+   * the millisecond, elevations (GGA only) to the decimetre, and ground speeds (RMC only,
+   * in metres per second) in knots to 3 decimal places.  Fields that do not come from the
+   * Fix are given fixed plausible values (e.g. GGA fix quality 1, RMC status 'A'), except
+   * the RMC date, which is left empty.  The checksum is correct.
+   *
+   * Throws a std::invalid_argument exception for unsupported sentence formats.
+   */
+  std::size_t encodeSentence(std::string_view format, const GPS::Fix &, GPS::speed groundSpeed,
+                             char * buffer);
+
+  // As above, returning the sentence (without the newline) as a string.
+  std::string encodeSentence(std::string_view format, const GPS::Fix &, GPS::speed groundSpeed = 0);
+
+
+  // The two upper-case hexadecimal digits of the checksum of the characters in 'body'.
+  void writeChecksum(std::string_view body, char * digits);
+}
+
+#endif
@@ -0,0 +1,17 @@
+#ifndef FIX_H_191026
+#define FIX_H_191026
+
+#include "types.h"
+#include "position.h"
+
+namespace GPS
+{
+  // A Position, along with the UTC time of day (in seconds since midnight) it was recorded at.
+  struct Fix
+  {
+      Position position;
+      seconds  time;
+  };
+}
+
+#endif
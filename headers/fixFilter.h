@@ -0,0 +1,90 @@
+#ifndef FIXFILTER_H_191026
+#define FIXFILTER_H_191026
+
+#include <optional>
+
+#include "fix.h"
+
+namespace GPS
+{
+  /* Returns the time elapsed from one time of day to a later one, allowing for the day
+   * rolling over at midnight (so the result is in [0, 86400)).
+   */
+  seconds elapsedTime(seconds from, seconds to);
+
+
+  /* A streaming filter that rejects physically impossible jumps in a sequence of fixes.
+   *
+   * A fix is rejected if reaching it from the last accepted fix would require travelling
+   * faster than the maximum speed.  If several consecutive fixes are rejected, the receiver
+   * has probably really moved (e.g. after a gap in coverage), so the next fix is accepted
+   * unconditionally and becomes the new reference.
+   *
+   * Uses constant memory; pass it to NMEA::fixesFromLog() to filter while parsing.
+   */
+  class JumpFilter
+  {
+    public:
+      /* 'maxSpeed' is in metres per second; 'resyncAfter' is the number of consecutive
+       * rejections after which the next fix is accepted regardless.
+       */
+      explicit JumpFilter(speed maxSpeed, unsigned resyncAfter = 5);
+
+      // Returns true if the fix is plausible (and remembers it as the reference).
+      bool accept(const Fix &);
+
+      bool operator()(Fix & fix) { return accept(fix); }
+
+      unsigned long rejectedCount() const;
+
+    private:
+      speed maxSpeed;
+      unsigned resyncAfter;
+      std::optional<Fix> reference;
+      unsigned consecutiveRejects = 0;
+      unsigned long rejected = 0;
+  };
+
+
+  /* Smooths a sequence of fixes with a constant-velocity Kalman filter, run independently
+   * on the east and north axes of a local plane anchored at the first fix.
+   * Elevation and time are passed through unchanged.
+   *
+   * Uses constant memory; pass it to NMEA::fixesFromLog() to smooth while parsing.
+   */
+  class KalmanSmoother
+  {
+    public:
+      /* 'acceleration' is the standard deviation of unmodelled acceleration, in metres per
+       * second squared; 'measurementError' is the standard deviation of the receiver's
+       * position error, in metres.
+       */
+      KalmanSmoother(double acceleration, metres measurementError);
+
+      // Returns the smoothed fix.
+      Fix smooth(const Fix &);
+
+      bool operator()(Fix & fix) { fix = smooth(fix); return true; }
+
+    private:
+      // Position and velocity along one axis, with their covariance.
+      struct AxisState
+      {
+          double position = 0, velocity = 0;
+          double varPos = 0, covPosVel = 0, varVel = 0;
+
+          void predict(seconds dt, double accelerationVariance);
+          void update(double measurement, double measurementVariance);
+      };
+
+      double accelerationVariance;
+      double measurementVariance;
+
+      std::optional<Position> origin;
+      double metresPerDegreeLon = 0;
+      seconds lastTime = 0;
+      AxisState east, north;
+  };
+}
+
+#endif
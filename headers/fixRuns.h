@@ -0,0 +1,62 @@
+#ifndef FIXRUNS_H_191026
+#define FIXRUNS_H_191026
+
+#include <istream>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "parseNMEA.h"
+
+namespace NMEA
+{
+  // A run of consecutive fixes at the same Position.
+  struct FixRun
+  {
+      GPS::Position position; // that of the first fix in the run
+      GPS::seconds firstTime;
+      GPS::seconds lastTime;
+      unsigned long count;
+  };
+
+
+  /* A streaming stage that collapses runs of consecutive sentences reporting the same
+   * Position (e.g. while the receiver is stationary) into FixRuns.
+   *
+   * Sentences are compared by the raw text of their latitude and longitude fields, before
+   * any floating-point conversion.  A sentence with the same text as the run's first extends
+   * the run once its time and elevation are found valid (its coordinates are valid, as the
+   * first sentence's were); any other sentence is interpreted in full.  So a sentence with
+   * invalid data never extends a run, as fixesFromLog() would reject it.  With a positive
+   * 'epsilon', a sentence whose text differs is still added to the run if it lies within
+   * 'epsilon' metres (horizontally) of the run's Position.
+   *
+   * Elevation is not compared: a run keeps the elevation of its first sentence.
+   */
+  class RunLengthDeduplicator
+  {
+    public:
+      explicit RunLengthDeduplicator(GPS::metres epsilon = 0);
+
+      /* Adds a sentence, returning the previous run if this sentence starts a new one.
+       * Sentences without a valid Position and time are ignored, as by fixesFromLog().
+       */
+      std::optional<FixRun> add(const LazySentence &);
+
+      // Returns the run in progress, if any, and starts afresh.
+      std::optional<FixRun> finish();
+
+    private:
+      GPS::metres epsilon;
+      std::optional<FixRun> current;
+      std::string currentCoordinates; // the raw text of the run's first sentence
+  };
+
+
+  /* Reads a stream of NMEA sentences (one sentence per line), and constructs the FixRuns
+   * of the Fixes that fixesFromLog() would return.
+   */
+  std::vector<FixRun> fixRunsFromLog(std::istream &, GPS::metres epsilon = 0);
+}
+
+#endif
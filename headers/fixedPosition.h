@@ -0,0 +1,74 @@
+#ifndef FIXEDPOSITION_H_191026
+#define FIXEDPOSITION_H_191026
+
+#include <cstdint>
+#include <string_view>
+
+#include "types.h"
+#include "position.h"
+
+namespace GPS
+{
+  /* A compact, exact alternative to Position for holding large numbers of fixes.
+   *
+   * Latitude and longitude are stored as whole numbers of 1e-7 degrees (about 1.1 cm at
+   * the equator) and elevation as whole centimetres, in three 32-bit integers: 12 bytes
+   * rather than the 24 of a Position.
+   */
+  class FixedPosition
+  {
+    public:
+      using units = std::int32_t;
+
+      static constexpr units unitsPerDegree = 10000000;
+      static constexpr units centimetresPerMetre = 100;
+
+      /* Construct a FixedPosition from latitude and longitude in 1e-7 degrees, and
+       * (optionally) elevation in centimetres.
+       */
+      FixedPosition(units latUnits, units lonUnits, units eleCentimetres = 0);
+
+
+      /* Construct a FixedPosition from a Position, rounding each coordinate to the
+       * nearest unit.  Converting a FixedPosition to a Position and back is exact.
+       */
+      explicit FixedPosition(const Position &);
+
+
+      /* Construct a FixedPosition from strings containing a positive DDM (degrees and
+       * decimal minutes) representation of latitude and longitude, along with 'N'/'S'
+       * and 'E'/'W' characters to indicate positive or negative angles, and (optionally)
+       * elevation in metres.
+       *
+       * The strings are converted with integer arithmetic, rounding to the nearest unit,
+       * so the result does not depend on floating-point rounding.  Only plain decimal
+       * notation is accepted (digits with at most one '.', and a leading '-' for the
+       * elevation).  This is stricter than the std::stod() conversion of the Position
+       * constructor, which also accepts exponent forms and ignores trailing characters.
+       */
+      FixedPosition(std::string_view ddmLatStr, char northing,
+                    std::string_view ddmLonStr, char easting,
+                    std::string_view eleStr = "0");
+
+      units latitudeUnits() const    { return lat; }
+      units longitudeUnits() const   { return lon; }
+      units elevationCentimetres() const { return ele; }
+
+      degrees latitude() const;
+      degrees longitude() const;
+      metres  elevation() const;
+
+      Position toPosition() const;
+
+      bool operator==(const FixedPosition &) const = default;
+
+    private:
+      units lat;
+      units lon;
+      units ele;
+  };
+
+  static_assert(sizeof(FixedPosition) == 12, "FixedPosition should pack into 12 bytes");
+}
+
+#endif
@@ -0,0 +1,118 @@
+#ifndef GENERATOR_H_191026
+#define GENERATOR_H_191026
+
+#include <coroutine>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace GPS
+{
+  /* A lazily-evaluated sequence produced by a coroutine that co_yields its elements.
+   *
+   * The coroutine runs only when the next element is requested, so chaining generators
+   * (each taking the previous one as a parameter) builds a pipeline that processes one
+   * element at a time, end to end.  Iterate with a range-based for loop; a Generator can
+   * only be iterated once.
+   *
+   * Exceptions thrown by the coroutine propagate to the consumer.
+   */
+  template <typename T>
+  class Generator
+  {
+    public:
+      using value_type = std::remove_cvref_t<T>;
+
+      struct promise_type
+      {
+          const value_type * current = nullptr;
+          std::exception_ptr exception;
+
+          Generator get_return_object()
+          {
+              return Generator{std::coroutine_handle<promise_type>::from_promise(*this)};
+          }
+
+          std::suspend_always initial_suspend() noexcept { return {}; }
+          std::suspend_always final_suspend() noexcept { return {}; }
+
+          // The yielded object outlives the suspension, so storing its address is safe.
+          std::suspend_always yield_value(const value_type & value) noexcept
+          {
+              current = std::addressof(value);
+              return {};
+          }
+
+          void return_void() {}
+          void unhandled_exception() { exception = std::current_exception(); }
+
+          // Generators only co_yield, they never co_await.
+          template <typename U>
+          void await_transform(U &&) = delete;
+      };
+
+      class iterator
+      {
+        public:
+          using iterator_category = std::input_iterator_tag;
+          using difference_type = std::ptrdiff_t;
+          using value_type = Generator::value_type;
+
+          iterator() = default;
+          explicit iterator(std::coroutine_handle<promise_type> coroutine) : coroutine(coroutine) {}
+
+          const value_type & operator*() const { return *coroutine.promise().current; }
+          const value_type * operator->() const { return coroutine.promise().current; }
+
+          iterator & operator++()
+          {
+              coroutine.resume();
+              rethrowIfFailed(coroutine);
+              return *this;
+          }
+          void operator++(int) { ++*this; }
+
+          bool operator==(std::default_sentinel_t) const { return !coroutine || coroutine.done(); }
+
+        private:
+          std::coroutine_handle<promise_type> coroutine;
+      };
+
+      Generator(Generator && other) noexcept : coroutine(std::exchange(other.coroutine, {})) {}
+
+      Generator & operator=(Generator && other) noexcept
+      {
+          std::swap(coroutine, other.coroutine);
+          return *this;
+      }
+
+      ~Generator()
+      {
+          if (coroutine) coroutine.destroy();
+      }
+
+      iterator begin()
+      {
+          coroutine.resume();
+          rethrowIfFailed(coroutine);
+          return iterator{coroutine};
+      }
+
+      std::default_sentinel_t end() const { return {}; }
+
+    private:
+      explicit Generator(std::coroutine_handle<promise_type> coroutine) : coroutine(coroutine) {}
+
+      static void rethrowIfFailed(std::coroutine_handle<promise_type> coroutine)
+      {
+          if (coroutine.done() && coroutine.promise().exception)
+              std::rethrow_exception(coroutine.promise().exception);
+      }
+
+      std::coroutine_handle<promise_type> coroutine;
+  };
+}
+
+#endif
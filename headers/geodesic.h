@@ -0,0 +1,65 @@
+#ifndef GEODESIC_H_191026
+#define GEODESIC_H_191026
+
+#include <cstddef>
+
+#include "types.h"
+#include "position.h"
+
+namespace GPS
+{
+  /* An ellipsoid of revolution, from its equatorial radius and flattening.
+   * The derived constants are computed once, at compile time for the ellipsoids below.
+   */
+  struct Ellipsoid
+  {
+      constexpr Ellipsoid(metres equatorialRadius, double flattening)
+          : a(equatorialRadius),
+            f(flattening),
+            b(equatorialRadius * (1 - flattening)),
+            secondEccentricitySqr((a*a - b*b) / (b*b))
+      {}
+
+      metres a; // equatorial (semi-major) radius
+      double f; // flattening
+      metres b; // polar (semi-minor) radius
+      double secondEccentricitySqr;
+  };
+
+  namespace Earth
+  {
+      inline constexpr Ellipsoid WGS84 { 6378137.0, 1 / 298.257223563 };
+  }
+
+
+  // The shortest path between two Positions on an Ellipsoid.
+  struct Geodesic
+  {
+      metres  distance;
+      degrees initialAzimuth; // clockwise from North, in (-180,180]
+      degrees finalAzimuth;   // the forward azimuth on arrival
+  };
+
+
+  /* Computes the geodesic between two Positions on the ellipsoid, using Vincenty's inverse
+   * method (accurate to about 0.5mm). Does not take into account elevation.
+   *
+   * Near-antipodal Positions, where Vincenty's iteration fails to converge, are solved by
+   * bracketing and bisecting the same equation instead; exactly antipodal Positions on the
+   * Equator give the meridional geodesic through the poles.
+   */
+  Geodesic geodesicBetween(const Position &, const Position &,
+                           const Ellipsoid & = Earth::WGS84);
+
+  metres geodesicDistanceBetween(const Position &, const Position &,
+                                 const Ellipsoid & = Earth::WGS84);
+
+  /* Batch version of geodesicDistanceBetween(), over the 'n - 1' legs of a track of 'n'
+   * Positions: legs[i] is the distance from track[i] to track[i+1].
+   * Each Position's reduced latitude is computed once and shared by its two legs.
+   */
+  void geodesicLegDistances(const Position * track, std::size_t n, metres * legs,
+                            const Ellipsoid & = Earth::WGS84);
+}
+
+#endif
@@ -0,0 +1,119 @@
+#ifndef GEOFENCE_H_191026
+#define GEOFENCE_H_191026
+
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+#include "position.h"
+
+namespace GPS
+{
+  /* A set of geofences (circular or polygonal regions), indexed for fast
+   * point-in-region queries against thousands of fences.
+   *
+   * Each fence's latitude/longitude bounding box is registered in a uniform grid of cells;
+   * a query examines only the fences registered in the cell containing the Position, and
+   * does the exact test only for those whose bounding box contains it.  (Fences too large
+   * to register cell by cell are tested on every query.)
+   *
+   * Polygons are treated as planar in latitude/longitude, which is accurate for site-sized
+   * regions (such as Earth::CliftonCampus) away from the poles; they must not cross the
+   * anti-meridian.  Circles use Position::horizontalDistanceBetween().
+   */
+  class GeofenceSet
+  {
+    public:
+      using FenceId = std::size_t;
+
+      // 'cellSize' is the width and height of a grid cell, in degrees.
+      explicit GeofenceSet(degrees cellSize = 0.01);
+
+      /* Adds a circular fence of the given radius (in metres) around a centre Position.
+       * Throws a std::invalid_argument exception if the radius is not positive.
+       */
+      FenceId addCircle(Position centre, metres radius);
+
+      /* Adds a polygonal fence with the given vertices (in order, without repeating the
+       * first vertex at the end).
+       * Throws a std::invalid_argument exception if there are fewer than three vertices.
+       */
+      FenceId addPolygon(std::vector<Position> vertices);
+
+      std::size_t size() const;
+
+      // Determine whether a Position lies within a fence (boundaries count as inside).
+      bool contains(FenceId, Position) const;
+
+      /* Finds every fence that contains the Position, in increasing order of FenceId.
+       * The vector is cleared first; reusing it across calls avoids reallocating.
+       */
+      void fencesContaining(Position, std::vector<FenceId> & result) const;
+
+    private:
+      struct BoundingBox
+      {
+          degrees minLat, maxLat, minLon, maxLon;
+          bool contains(degrees lat, degrees lon) const;
+      };
+
+      struct Fence
+      {
+          BoundingBox bounds;
+          Position centre;               // circles only
+          metres radius;                 // circles only; 0 for polygons
+          std::vector<Position> vertices;// polygons only
+      };
+
+      using CellKey = long long;
+      CellKey cellKey(long row, long col) const;
+      long cellIndex(degrees) const;
+
+      void index(FenceId);
+
+      // Fences covering more than this many cells are not put in the grid, but tested for every query.
+      static const long maxCellsPerFence = 4096;
+
+      degrees cellSize;
+      std::vector<Fence> fences;
+      std::unordered_map<CellKey, std::vector<FenceId>> grid;
+      std::vector<FenceId> largeFences;
+  };
+
+
+  // A fence being entered or exited.
+  struct GeofenceEvent
+  {
+      enum class Type { Enter, Exit };
+
+      Type type;
+      GeofenceSet::FenceId fence;
+  };
+
+
+  /* Tracks a single moving object (a stream of fixes) against a GeofenceSet, reporting
+   * the fences it enters and exits.
+   */
+  class GeofenceMonitor
+  {
+    public:
+      // The GeofenceSet must outlive the monitor, and must not be modified while in use.
+      explicit GeofenceMonitor(const GeofenceSet &);
+
+      /* Processes the next fix, appending an event to 'events' for every fence that
+       * changed state since the previous fix: Exit events first, then Enter events.
+       * 'events' is not cleared.
+       */
+      void update(Position, std::vector<GeofenceEvent> & events);
+
+      // The fences containing the most recent fix, in increasing order of FenceId.
+      const std::vector<GeofenceSet::FenceId> & insideFences() const;
+
+    private:
+      const GeofenceSet & fences;
+      std::vector<GeofenceSet::FenceId> inside;
+      std::vector<GeofenceSet::FenceId> current;
+  };
+}
+
+#endif
@@ -1,33 +1,76 @@
 #ifndef GEOMETRY_H_211217
 #define GEOMETRY_H_211217
 
+#include <cmath>
+#include <cstddef>
+
 #include "types.h"
 
 namespace GPS
 {
-  extern const double pi;
-  extern const degrees fullRotation;
-  extern const degrees halfRotation;
-  extern const degrees poleLatitude;
-  extern const degrees antiMeridianLongitude;
+  inline constexpr double pi = 3.141592653589793;
+  inline constexpr degrees fullRotation = 360;
+  inline constexpr degrees halfRotation = fullRotation/2;
+  inline constexpr degrees poleLatitude = fullRotation/4;
+  inline constexpr degrees antiMeridianLongitude = fullRotation/2;
 
   // Compute hypotenuse of right-angled triangle in two dimensions.
-  double pythagoras(double,double);
+  inline double pythagoras(double x, double y)
+  {
+      return std::sqrt(x*x + y*y);
+  }
 
   // Compute hypotenuse of right-angled triangle in three dimensions.
-  double pythagoras(double,double,double);
+  inline double pythagoras(double x, double y, double z)
+  {
+      return std::sqrt(x*x + y*y + z*z);
+  }
 
   // Convert from degrees to radians.
-  radians degToRad(degrees);
+  constexpr radians degToRad(degrees d)
+  {
+      return d * pi / halfRotation;
+  }
 
   // Convert from radians to degrees.
-  radians radToDeg(degrees);
+  constexpr degrees radToDeg(radians r)
+  {
+      return r * halfRotation / pi;
+  }
 
   // Sine squared function: sin^2(x)
-  double sinSqr(radians);
+  inline double sinSqr(radians x)
+  {
+      const double sx = std::sin(x);
+      return sx * sx;
+  }
 
   // Ensure degrees are in (-180,180] range.
-  degrees normaliseDeg(degrees);
+  inline degrees normaliseDeg(degrees d)
+  {
+      d = std::fmod(d,fullRotation); // results in range (-360,360)
+      if (d <= -halfRotation) d += fullRotation; // results in range (-180,360)
+      if (d > halfRotation) d -= fullRotation; // results in range (-180,180]
+      return d;
+  }
+
+
+  /* Batch versions of the above, over contiguous arrays of 'n' elements.
+   * The loops are branch-free so that the compiler can vectorise them (GCC does so at -O3,
+   * or at -O2 with -fvect-cost-model=dynamic as set in the project files).
+   * The output array may be the same as the input array, but must not otherwise overlap it.
+   */
+
+  void degToRad(const degrees * in, radians * out, std::size_t n);
+
+  void radToDeg(const radians * in, degrees * out, std::size_t n);
+
+  /* Ensures degrees are in the (-180,180] range.
+   * For angles beyond a few turns, results may differ from normaliseDeg() in the last bit;
+   * beyond 2^51 turns (about 8e17 degrees), where the input is no longer resolved to the
+   * degree, they are not normalised.  NaNs and infinities give NaN, as in normaliseDeg().
+   */
+  void normaliseDeg(const degrees * in, degrees * out, std::size_t n);
 }
 
 #endif
@@ -0,0 +1,79 @@
+#ifndef LOGINDEX_H_191026
+#define LOGINDEX_H_191026
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "fix.h"
+
+namespace NMEA
+{
+  /* A sparse index from UTC time of day to byte offset in a NMEA log, allowing a time
+   * window to be extracted without parsing the whole log.
+   *
+   * Building the index interprets only the time of each sentence (after checking that
+   * the sentence is well-formed with a correct checksum), and records the offset of the
+   * first sentence at or after each multiple of the interval.
+   *
+   * Seeking assumes that times do not decrease through the log.  If the log does go back in
+   * time (e.g. it runs past midnight, or is several logs concatenated), the index records this
+   * and queries fall back to scanning the whole log.
+   */
+  class LogIndex
+  {
+    public:
+      struct Entry
+      {
+          GPS::seconds time;
+          std::uint64_t offset; // of the start of the line
+      };
+
+      // Scans a log, recording an entry at least every 'interval' seconds of log time.
+      static LogIndex build(std::istream & log, GPS::seconds interval = 60);
+
+      /* Reads and writes the index in a compact binary form (in the host's byte order),
+       * for storing as a sidecar file alongside the log.
+       * load() throws a std::invalid_argument exception if the data is not a valid index.
+       */
+      static LogIndex load(std::istream & sidecar);
+      void save(std::ostream & sidecar) const;
+
+      /* Loads the index stored alongside the log file (at sidecarPath()), or builds and
+       * stores it if there is none or the log's size or modification time has changed since
+       * it was built.
+       */
+      static LogIndex forFile(const std::string & logPath, GPS::seconds interval = 60);
+
+      static std::string sidecarPath(const std::string & logPath);
+
+      GPS::seconds interval() const;
+      const std::vector<Entry> & entries() const;
+      bool isTimeOrdered() const;
+      std::uint64_t indexedBytes() const; // the length of the log when indexed
+
+      /* The offset from which to read to see every sentence with a time at or after 'time',
+       * i.e. that of the last entry not later than 'time'.
+       */
+      std::uint64_t offsetFor(GPS::seconds time) const;
+
+      /* Reads the Fixes whose times lie in the range [from,to] from the indexed log,
+       * parsing only the sentences from offsetFor(from) up to the first one after 'to'.
+       * Returns the same Fixes as fixesInTimeWindow() over the whole log.
+       */
+      std::vector<GPS::Fix> fixesBetween(std::istream & log, GPS::seconds from, GPS::seconds to) const;
+
+    private:
+      LogIndex(GPS::seconds interval);
+
+      GPS::seconds intervalLength;
+      std::vector<Entry> index;
+      bool timeOrdered = true;
+      std::uint64_t logBytes = 0;
+      std::int64_t logModified = 0; // the log file's modification time, if built by forFile()
+  };
+}
+
+#endif
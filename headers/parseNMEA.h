@@ -10,7 +10,16 @@
 #include <map>
 #include <regex>
 #include <assert.h>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory_resource>
+#include <optional>
+#include <string_view>
 #include "position.h"
+#include "fixedPosition.h"
+#include "fix.h"
 
 namespace NMEA
 {
@@ -18,7 +27,7 @@ namespace NMEA
    * that is currently supported.
    * Currently the only supported sentence formats are "GLL", "GGA" and "RMC".
    */
-  bool isSupportedSentenceFormat(std::string);
+  bool isSupportedSentenceFormat(std::string_view);
 
 
   /* Determine whether the parameter is a well-formed NMEA sentence.
@@ -37,7 +46,7 @@ namespace NMEA
    *
    * Note that this function does NOT check whether the sentence format is supported.
    */
-  bool isWellFormedSentence(std::string);
+  bool isWellFormedSentence(std::string_view);
 
 
   /* Verify whether a sentence has the correct checksum.
@@ -46,7 +55,7 @@ namespace NMEA
    *
    * Pre-condition: the parameter is a well-formed NMEA sentence.
    */
-  bool hasCorrectChecksum(std::string);
+  bool hasCorrectChecksum(std::string_view);
 
 
   // Stores the fields of a NMEA sentence, excluding the checksum.
@@ -81,6 +90,32 @@ namespace NMEA
   GPS::Position interpretSentenceData(SentenceData);
 
 
+  /* As SentenceData, but the format, the fields and the vector that holds them are all
+   * allocated from a std::pmr::memory_resource, typically an arena shared by a whole
+   * batch of sentences (see BatchParser).
+   */
+  struct ArenaSentenceData
+  {
+      using allocator_type = std::pmr::polymorphic_allocator<char>;
+
+      explicit ArenaSentenceData(allocator_type alloc = {})
+          : format(alloc), dataFields(alloc) {}
+
+      std::pmr::string format;
+      std::pmr::vector<std::pmr::string> dataFields;
+  };
+
+
+  /* As parseSentenceData() above, but allocates the result from the given memory resource.
+   *
+   * Pre-condition: the parameter is a well-formed NMEA sentence.
+   */
+  ArenaSentenceData parseSentenceData(std::string_view, std::pmr::memory_resource *);
+
+  // As interpretSentenceData() above, for sentence data allocated from an arena.
+  GPS::Position interpretSentenceData(const ArenaSentenceData &);
+
+
   /* Reads a stream of NMEA sentences (one sentence per line), and constructs a
    * vector of Positions, ignoring any lines that do not contain valid sentences.
    *
@@ -92,6 +127,211 @@ namespace NMEA
    */
   std::vector<GPS::Position> positionsFromLog(std::istream &);
 
+
+  /* Computes the Position for a single line of a log, or returns nothing if the line is
+   * not a valid sentence (by the same rules as positionsFromLog()).
+   */
+  std::optional<GPS::Position> positionFromLine(std::string_view);
+
+
+  /* As positionsFromLog(), but constructs compact FixedPositions, converting the DDM
+   * text of each sentence with integer arithmetic only.
+   *
+   * The numeric fields must be in plain decimal notation (see FixedPosition), so a line
+   * that positionsFromLog() accepts is rejected here if a coordinate or elevation is in
+   * exponent form (e.g. "5.42531e3") or has trailing characters (e.g. "5425.31x").
+   */
+  std::vector<GPS::FixedPosition> fixedPositionsFromLog(std::istream &);
+
+
+  /* Converts a NMEA time field ("hhmmss", optionally followed by decimal fractions of a
+   * second) to seconds since midnight UTC.
+   *
+   * Throws a std::invalid_argument exception if the field is not a valid time.
+   * Leading zeros may be omitted, e.g. "82319" is 08:23:19.
+   */
+  GPS::seconds timeOfDay(std::string_view hhmmss);
+
+
+  /* The index of the data field holding the time, in sentences of the given format.
+   * Throws a std::invalid_argument exception if the format is not supported.
+   */
+  std::size_t timeFieldIndex(std::string_view format);
+
+
+  /* Extracts the UTC time of day from NMEA Sentence Data.
+   * Currently only supports the GLL, GGA and RMC sentence formats.
+   *
+   * Throws a std::invalid_argument exception for unsupported sentence formats, or if the
+   * time field is missing or invalid.
+   */
+  GPS::seconds interpretSentenceTime(const SentenceData &);
+
+
+  /* Computes the Fix (Position and time) for a single line of a log, or returns nothing
+   * if the line is not a valid sentence (as for positionFromLine()) or has no valid time.
+   */
+  std::optional<GPS::Fix> fixFromLine(std::string_view);
+
+
+  /* A processing stage run on each Fix as it is parsed, which may modify the Fix, and
+   * returns false to discard it.  E.g. a GPS::JumpFilter.
+   */
+  using FixStage = std::function<bool(GPS::Fix &)>;
+
+
+  /* Reads a stream of NMEA sentences (one sentence per line), and constructs a vector
+   * of Fixes, ignoring any lines that do not contain valid sentences with valid times.
+   * If a stage is given, each Fix is passed through it before being stored.
+   */
+  std::vector<GPS::Fix> fixesFromLog(std::istream &, const FixStage & stage = nullptr);
+
+
+  /* A sentence whose data fields have been located but not yet interpreted.
+   * The Position, time and speed are each decoded on first access and then cached, so
+   * that a pipeline which discards most sentences (e.g. by time) does not pay for
+   * converting the coordinates of the sentences it discards.
+   */
+  class LazySentence
+  {
+    public:
+      /* Returns nothing if the line is not a well-formed sentence with a correct checksum
+       * and a supported format.  The data fields themselves are not checked until accessed.
+       */
+      static std::optional<LazySentence> fromLine(std::string_view);
+
+      // The sentence format, excluding the 'GP' prefix, e.g. "GLL".
+      std::string_view format() const;
+
+      // The data fields, excluding the format and checksum.
+      std::size_t fieldCount() const;
+      std::string_view field(std::size_t) const;
+
+      /* The raw text of the latitude, N/S, longitude and E/W fields, e.g. for comparing
+       * Positions without interpreting them.
+       * Throws a std::invalid_argument exception if the sentence has the wrong number of fields.
+       */
+      std::string_view coordinateText() const;
+
+      /* These throw a std::invalid_argument exception if the neccessary data fields are
+       * missing or contain invalid data, as interpretSentenceData() and
+       * interpretSentenceTime() do.
+       */
+      const GPS::Position & position() const;
+      GPS::seconds time() const;
+
+      /* The elevation alone (0 for formats without an elevation field), without
+       * interpreting the coordinates.  Throws as position() would for an invalid elevation.
+       */
+      GPS::metres elevation() const;
+
+      /* The speed over ground, in metres per second.
+       * Only RMC sentences record speed: throws a std::invalid_argument exception for other
+       * formats, or if the field is missing or invalid.
+       */
+      GPS::speed groundSpeed() const;
+
+    private:
+      explicit LazySentence(std::string_view);
+
+      // Field locations are offsets rather than views, so that copies remain valid.
+      struct Span
+      {
+          std::uint32_t offset, length;
+      };
+
+      std::string line;
+      std::vector<Span> fields;
+
+      mutable std::optional<GPS::Position> cachedPosition;
+      mutable std::optional<GPS::seconds> cachedTime;
+      mutable std::optional<GPS::speed> cachedSpeed;
+  };
+
+
+  /* As fixesFromLog(), but only returns the Fixes whose times lie in the range [from,to].
+   * Coordinates are only interpreted for sentences within that range.
+   */
+  std::vector<GPS::Fix> fixesInTimeWindow(std::istream &, GPS::seconds from, GPS::seconds to);
+
+
+  /* Reads a log in batches, accepting and rejecting lines exactly as positionsFromLog()
+   * does, but without per-line heap allocation: each batch of sentences is parsed into a
+   * monotonic arena which is released when the next batch starts.
+   *
+   * Once the arena, the line buffer and the output vector have grown to fit (i.e. after
+   * the first batch), parsing performs no heap allocation, provided the arena is large
+   * enough for a batch and no field exceeds the short-string capacity of std::string.
+   */
+  class BatchParser
+  {
+    public:
+      explicit BatchParser(std::size_t arenaBytes = 64 * 1024);
+
+      /* Reads up to 'maxLines' non-blank lines from the log, appending the Positions of
+       * the valid sentences to 'positions'.
+       * Returns false once the log has been exhausted.
+       */
+      bool parseBatch(std::istream &, std::vector<GPS::Position> & positions, std::size_t maxLines);
+
+    private:
+      std::vector<std::byte> buffer;
+      std::pmr::monotonic_buffer_resource arena;
+      std::string line;
+  };
+
+
+  // The reasons for which positionsFromLog() discards a line.
+  enum class RejectReason
+  {
+      IllFormed,         // not a well-formed NMEA sentence
+      BadChecksum,       // the checksum does not match the sentence contents
+      UnsupportedFormat, // the sentence format is not GLL, GGA or RMC
+      InvalidData        // the data fields are missing or contain invalid data
+  };
+
+
+  /* Counters and per-stage timings collected while parsing a log.
+   *
+   * Counters are plain (non-atomic) integers: when parsing on several threads, give
+   * each thread its own ParseStats and combine them with += once the threads finish.
+   */
+  struct ParseStats
+  {
+      unsigned long linesRead = 0; // non-blank lines examined
+      unsigned long bytesRead = 0; // characters in those lines
+      unsigned long accepted  = 0; // lines that produced a Position
+
+      unsigned long illFormed         = 0;
+      unsigned long badChecksum       = 0;
+      unsigned long unsupportedFormat = 0;
+      unsigned long invalidData       = 0;
+
+      // Time spent in each stage of the parse pipeline.
+      std::chrono::nanoseconds validateTime  {0}; // isWellFormedSentence()
+      std::chrono::nanoseconds checksumTime  {0}; // hasCorrectChecksum()
+      std::chrono::nanoseconds splitTime     {0}; // parseSentenceData()
+      std::chrono::nanoseconds interpretTime {0}; // interpretSentenceData()
+
+      unsigned long rejected() const;
+
+      ParseStats & operator+=(const ParseStats &);
+  };
+
+
+  /* Called by positionsFromLog() for every line that it discards, with the reason
+   * for rejection and the offending line.
+   */
+  using RejectCallback = std::function<void(RejectReason, const std::string &)>;
+
+
+  /* As above, but also records counters and stage timings into the ParseStats
+   * (which are added to, not reset), and reports each rejected line to the
+   * callback if one is provided.
+   */
+  std::vector<GPS::Position> positionsFromLog(std::istream &, ParseStats &,
+                                              RejectCallback onReject = nullptr);
+
 }
 
 #endif
@@ -1,9 +1,11 @@
 #ifndef POSITION_H_211217
 #define POSITION_H_211217
 
+#include <stdexcept>
 #include <string>
 
 #include "types.h"
+#include "geometry.h"
 
 namespace GPS
 {
@@ -13,8 +15,17 @@ namespace GPS
 
       /* Construct a Position from degrees latitude, degrees longitude, and
        * (optionally) elevation in metres.
+       * constexpr, so that Positions of fixed sites can be constructed at compile time.
        */
-      Position(degrees lat, degrees lon, metres ele = 0.0);
+      constexpr Position(degrees lat, degrees lon, metres ele = 0.0)
+          : lat(lat), lon(lon), ele(ele)
+      {
+          if (lat > poleLatitude || lat < -poleLatitude)
+              throw std::invalid_argument("Latitude values must not exceed " + std::to_string(poleLatitude) + " degrees.");
+
+          if (lon > antiMeridianLongitude || lon < -antiMeridianLongitude)
+              throw std::invalid_argument("Longitude values must not exceed " + std::to_string(antiMeridianLongitude) + " degrees.");
+      }
 
 
       /* Construct a Position from strings containing a decimal degrees
@@ -35,9 +46,9 @@ namespace GPS
                std::string ddmLonStr, char easting,
                std::string eleSt = "0");
 
-      degrees latitude() const;
-      degrees longitude() const;
-      metres  elevation() const;
+      constexpr degrees latitude() const  { return lat; }
+      constexpr degrees longitude() const { return lon; }
+      constexpr metres  elevation() const { return ele; }
 
       /* Computes an approximation of the horizontal distance between two Positions
        * on the Earth's surface. Does not take into account elevation.
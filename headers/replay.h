@@ -0,0 +1,96 @@
+#ifndef REPLAY_H_191026
+#define REPLAY_H_191026
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "types.h"
+#include "fix.h"
+
+namespace NMEA
+{
+  /* Somewhere to send NMEA traffic: a file descriptor (a pipe, file or socket connected
+   * with connect()), written to in large blocks, or a UDP destination, sent datagrams.
+   */
+  class ReplaySink
+  {
+    public:
+      // Writes to an open file descriptor, which the sink does not close.
+      static ReplaySink toFileDescriptor(int fd);
+
+      /* Sends UDP datagrams to an IPv4 address and port, packing whole sentences into each
+       * datagram up to 'maxDatagramBytes' (by default, the payload of a 1500-byte Ethernet
+       * frame).  With 'maxDatagramBytes' 0 each sentence is sent in its own datagram.
+       * Throws std::runtime_error if the address is invalid or no socket can be opened.
+       */
+      static ReplaySink toUDP(const std::string & address, std::uint16_t port, std::size_t maxDatagramBytes = 1472);
+
+      ~ReplaySink();
+      ReplaySink(ReplaySink &&);
+      ReplaySink & operator=(ReplaySink &&) = delete;
+
+      /* Queues a sentence (which must end with '\n'), sending queued traffic when it fills a
+       * block or datagram.  Throws std::runtime_error if a write or send fails.
+       */
+      void write(std::string_view sentence);
+
+      // Sends any queued traffic.
+      void flush();
+
+    private:
+      ReplaySink(int fd, bool ownsFd, bool datagrams, std::size_t blockBytes);
+      void send(const char *, std::size_t);
+
+      int fd;
+      bool ownsFd;
+      bool datagrams;
+      std::size_t blockBytes;
+      std::vector<char> block;
+  };
+
+
+  /* Options for replay().  With 'sentencesPerSecond' 0 sentences are sent as fast as the
+   * sink accepts them; otherwise the rate is held by sleeping between batches of 'batchSize'
+   * sentences, so that the average rate is accurate while most sentences cost no clock
+   * reads.  'maxSentences' 0 means no limit.
+   */
+  struct ReplayOptions
+  {
+      double sentencesPerSecond = 0;
+      std::size_t batchSize = 64;
+      unsigned long long maxSentences = 0;
+  };
+
+  struct ReplayStats
+  {
+      unsigned long long sentences = 0;
+      unsigned long long bytes = 0;
+      std::chrono::duration<double> elapsed {0};
+  };
+
+
+  /* Sends the sentences produced by 'next' to the sink, at the rate given in the options,
+   * until 'next' returns false (or 'maxSentences' have been sent), then flushes the sink.
+   * 'next' is given a buffer of maxEncodedSentenceLength characters to fill with one
+   * sentence (ending in '\n') and sets its length.
+   */
+  using SentenceSource = std::function<bool(char * buffer, std::size_t & length)>;
+
+  ReplayStats replay(const SentenceSource & next, ReplaySink &, ReplayOptions = {});
+
+  // A SentenceSource reading the lines of a log (which must outlive it), repeating it 'repeats' times.
+  SentenceSource logSource(const std::string & logContents, unsigned repeats = 1);
+
+  /* A SentenceSource producing a synthetic drive: a circuit of 'radius' metres around
+   * 'centre' at 'speed' metres per second, with one GGA and one RMC sentence for each Fix
+   * at 'fixesPerSecond', starting at midnight.  It never ends; limit it with 'maxSentences'.
+   */
+  SentenceSource syntheticSource(GPS::Position centre, GPS::metres radius, GPS::speed speed, double fixesPerSecond);
+}
+
+#endif
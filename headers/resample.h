@@ -0,0 +1,70 @@
+#ifndef RESAMPLE_H_191026
+#define RESAMPLE_H_191026
+
+#include <optional>
+#include <vector>
+
+#include "types.h"
+#include "position.h"
+#include "fix.h"
+
+namespace GPS
+{
+  /* The Position a fraction of the way from one Position to another: along the great
+   * circle for latitude and longitude, and linearly for elevation.
+   * Undefined for antipodal Positions, between which there is no unique great circle.
+   */
+  Position interpolate(const Position & from, const Position & to, double fraction);
+
+
+  // What a Resampler produces for sample times that fall in a gap between two Fixes.
+  enum class GapPolicy
+  {
+      Interpolate, // as for any other sample time
+      Omit,        // nothing
+      HoldLast     // the Position of the Fix before the gap
+  };
+
+
+  /* A streaming stage that resamples an irregular sequence of Fixes onto a fixed time grid.
+   *
+   * Samples are produced at every multiple of 'interval' seconds (counting from midnight)
+   * from the first Fix onwards, by interpolating between the Fixes either side of the
+   * sample time.  Where two consecutive Fixes are more than 'maxGap' seconds apart, the
+   * samples between them follow the GapPolicy.
+   *
+   * Fix times are times of day, so a Fix earlier than the one before it is taken to be on
+   * the following day; the grid continues across midnight.  A Fix at the same time as the
+   * one before it is ignored.  Uses constant memory.
+   */
+  class Resampler
+  {
+    public:
+      // Throws std::invalid_argument if 'interval' is not positive or 'maxGap' is negative.
+      Resampler(seconds interval, seconds maxGap, GapPolicy = GapPolicy::Omit);
+
+      // Adds the next Fix, appending any samples up to and including its time to 'samples'.
+      void add(const Fix &, std::vector<Fix> & samples);
+
+    private:
+      seconds interval;
+      seconds maxGap;
+      GapPolicy policy;
+      std::optional<Fix> previous;
+      seconds previousTime = 0; // the time of 'previous', counted from midnight on the first day
+      long long nextSample = 0; // the next sample time, in intervals from midnight on the first day
+  };
+
+
+  /* Resamples a whole track, producing the same samples as a Resampler.
+   *
+   * The work is done in passes over arrays: every sample is assigned its pair of Fixes,
+   * the Fixes are converted to Cartesian vectors in one batch, and the samples are
+   * interpolated and converted back to latitude and longitude in separate loops.  The
+   * trigonometry of each arc between Fixes is done once, however many samples lie on it.
+   */
+  std::vector<Fix> resampleTrack(const std::vector<Fix> &, seconds interval, seconds maxGap,
+                                 GapPolicy = GapPolicy::Omit);
+}
+
+#endif
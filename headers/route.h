@@ -0,0 +1,75 @@
+#ifndef ROUTE_H_191026
+#define ROUTE_H_191026
+
+#include <cstddef>
+#include <istream>
+#include <unordered_map>
+#include <vector>
+
+#include "position.h"
+
+namespace GPS
+{
+  /* Reads the route points (<rtept> elements, with optional <ele> elevations) of a GPX
+   * document, in order.  Other content is ignored.
+   *
+   * Throws a std::invalid_argument exception if a route point has missing or invalid
+   * "lat"/"lon" attributes, or if there are no route points.
+   */
+  std::vector<Position> routeFromGPX(std::istream &);
+
+
+  /* Follows a track (a stream of fixes) along a planned route, computing each fix's
+   * cross-track distance to the nearest route segment and flagging deviations.
+   *
+   * Distances are computed in a local equirectangular projection around the fix, which is
+   * accurate for route segments up to a few kilometres long.
+   *
+   * The segments near the previously matched one are tried first, so while the track
+   * follows the route each fix costs O(1).  Otherwise, segments are found through a grid
+   * index of their bounding boxes, searching a widening window around the fix.
+   */
+  class RouteDeviationMonitor
+  {
+    public:
+      struct Match
+      {
+          std::size_t segment;       // index i of the nearest segment, from route[i] to route[i+1]
+          metres crossTrackDistance; // distance from the fix to that segment
+          bool deviating;            // whether the distance exceeds the threshold
+      };
+
+      /* 'threshold' is the greatest distance from the route not counted as a deviation;
+       * 'cellSize' is the size of the segment index's grid cells, in degrees.
+       *
+       * Throws a std::invalid_argument exception if the route has fewer than two points,
+       * or the threshold or cell size are not positive.
+       */
+      RouteDeviationMonitor(std::vector<Position> route, metres threshold, degrees cellSize = 0.005);
+
+      Match update(Position);
+
+    private:
+      using CellKey = long long;
+      CellKey cellKey(long row, long col) const;
+      long cellIndex(degrees) const;
+
+      metres distanceToSegment(Position, std::size_t segment) const;
+      // Finds the nearest segment within the radius, if any, setting 'best' to it.
+      bool nearestWithin(Position, metres radius, Match & best) const;
+      bool searchAll(metres radius) const;
+
+      // Segments before and after the previous match that are tried first.
+      static const std::size_t searchBehind = 1;
+      static const std::size_t searchAhead  = 3;
+
+      std::vector<Position> route;
+      metres threshold;
+      degrees cellSize;
+      std::unordered_map<CellKey, std::vector<std::size_t>> grid;
+      std::size_t lastSegment = 0;
+      bool matched = false;
+  };
+}
+
+#endif
@@ -0,0 +1,117 @@
+#ifndef SHAREDFIX_H_191026
+#define SHAREDFIX_H_191026
+
+#include <chrono>
+#include <cstddef>
+#include <istream>
+#include <limits>
+#include <optional>
+#include <string>
+
+#include "types.h"
+#include "fix.h"
+
+namespace GPS
+{
+  struct SharedFixSegment;
+
+  // A Fix as published to shared memory, with what is known about it.
+  struct PublishedFix
+  {
+      Fix fix;
+
+      // The speed over ground in metres per second, or NaN if it is not known.
+      speed groundSpeed;
+
+      // How many fixes had been published when this one was, counting this one.
+      unsigned long long sequence;
+
+      /* When the fix was published, as a std::chrono::steady_clock time since its epoch.
+       * On Linux the steady clock is CLOCK_MONOTONIC, which all processes share, so a
+       * reader can compare this with its own clock to find how stale the fix is.
+       */
+      std::chrono::nanoseconds publishedAt;
+  };
+
+
+  /* Publishes the latest Fix to a named POSIX shared memory segment, from which any number
+   * of FixSubscribers (in this or other processes) can read it.
+   *
+   * Each fix is written under a sequence lock: the sequence number is made odd while the
+   * fields are written and even again afterwards, so readers detect (and discard) a copy
+   * taken while a write was in progress.  Publishing never waits for readers, and reading
+   * never blocks the publisher.  There must be only one publisher for each segment.
+   *
+   * The segment is created when the publisher is constructed (replacing any existing
+   * segment of the same name) and removed when it is destroyed; subscribers that are
+   * still attached keep their mapping, and see no further fixes.
+   */
+  class FixPublisher
+  {
+    public:
+      /* 'name' is a shared memory object name, e.g. "/gps-latest-fix".
+       * Throws a std::runtime_error exception if the segment cannot be created.
+       */
+      explicit FixPublisher(const std::string & name);
+      ~FixPublisher();
+
+      FixPublisher(const FixPublisher &) = delete;
+      FixPublisher & operator=(const FixPublisher &) = delete;
+
+      void publish(const Fix &, speed groundSpeed = std::numeric_limits<speed>::quiet_NaN());
+
+      // The number of fixes published so far.
+      unsigned long long published() const;
+
+    private:
+      std::string name;
+      SharedFixSegment * segment;
+  };
+
+
+  /* Reads the latest Fix published by a FixPublisher, possibly in another process.
+   * Reading costs a few loads from the shared segment and makes no system calls.
+   */
+  class FixSubscriber
+  {
+    public:
+      /* Attaches to a segment created by a FixPublisher.
+       * Throws a std::runtime_error exception if there is no such segment, or it was not
+       * created by a FixPublisher.
+       */
+      explicit FixSubscriber(const std::string & name);
+      ~FixSubscriber();
+
+      FixSubscriber(const FixSubscriber &) = delete;
+      FixSubscriber & operator=(const FixSubscriber &) = delete;
+
+      /* Takes a single copy of the latest fix, in a bounded number of steps.
+       * Returns nothing if no fix has been published yet, or if a fix was being published
+       * while the copy was taken (so the copy could be torn).
+       */
+      std::optional<PublishedFix> tryLatest() const;
+
+      /* As tryLatest(), except that a copy spoiled by a concurrent publish is retried, so
+       * that nothing is returned only if no fix has been published yet.  (It does not return
+       * if the publisher died part way through publishing.)
+       */
+      std::optional<PublishedFix> latest() const;
+
+      /* The number of fixes published so far: a cheap way to poll for a new fix before
+       * copying it.
+       */
+      unsigned long long sequence() const;
+
+    private:
+      const SharedFixSegment * segment;
+  };
+
+
+  /* Publishes the Fix of each valid GLL, GGA or RMC sentence in an NMEA log as it is read,
+   * with the ground speed of RMC sentences.  Lines that are not valid sentences are
+   * skipped.  Returns the number of fixes published.
+   */
+  std::size_t publishFixesFromLog(std::istream &, FixPublisher &);
+}
+
+#endif
@@ -0,0 +1,120 @@
+#ifndef SIMILARITY_H_191026
+#define SIMILARITY_H_191026
+
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include "types.h"
+#include "position.h"
+
+namespace GPS
+{
+  /* Measures of how closely two tracks follow each other, over all monotonic alignments
+   * ("warping paths") of their points, which run from the first points of both tracks to
+   * the last points of both, each step advancing along one track or both:
+   *
+   *   DTW             - the least sum of the distances between aligned points (dynamic time
+   *                     warping): the total divergence of the tracks.
+   *   DiscreteFrechet - the least greatest distance between aligned points: how far apart
+   *                     the tracks get at worst, however either is traversed.
+   *
+   * Distances are horizontal, as Position::horizontalDistanceBetween().
+   */
+  enum class SimilarityMeasure
+  {
+      DTW,
+      DiscreteFrechet
+  };
+
+  struct SimilarityOptions
+  {
+      SimilarityMeasure measure = SimilarityMeasure::DTW;
+
+      /* The half-width of the Sakoe-Chiba band, as a fraction of the length of the longer
+       * track: points may only be aligned if they are within this fraction of the tracks
+       * of the diagonal of the alignment.  The band is always at least one point wide, so
+       * that there is a path; 1 allows every alignment.
+       */
+      double band = 0.1;
+  };
+
+
+  /* A track prepared for repeated comparison.  The trigonometry of each point is done once,
+   * here, by converting it to a unit vector; the distance between two points is then found
+   * from the chord between their vectors with a few multiplications, a square root and
+   * (for DTW) an arcsine.
+   */
+  class Trajectory
+  {
+    public:
+      explicit Trajectory(const std::vector<Position> &);
+
+      std::size_t size() const { return points.size(); }
+      bool empty() const { return points.empty(); }
+
+      struct Vector
+      {
+          double x, y, z;
+      };
+
+      const std::vector<Vector> & vectors() const { return points; }
+
+    private:
+      std::vector<Vector> points;
+  };
+
+
+  /* The DTW or discrete Fréchet distance between two tracks, in metres, within the band.
+   *
+   * Early abandoning: if the distance is certain to exceed 'abandonAbove', the computation
+   * stops and infinity is returned.
+   *
+   * Throws a std::invalid_argument exception if either track is empty, or the band is
+   * negative.
+   */
+  metres trajectoryDistance(const Trajectory &, const Trajectory &, SimilarityOptions = {},
+                            metres abandonAbove = std::numeric_limits<metres>::infinity());
+
+
+  /* A lower bound on trajectoryDistance(), found in time proportional to the lengths of the
+   * tracks, in the style of LB_Keogh: each point of the first track is at least as far from
+   * the points of the second it may be aligned with as from their bounding box, which is
+   * kept for the whole band in one pass.  The ends of the tracks are always aligned.
+   */
+  metres trajectoryLowerBound(const Trajectory &, const Trajectory &, SimilarityOptions = {});
+
+
+  struct TrajectoryMatch
+  {
+      std::size_t index; // of the nearest candidate
+      metres distance;
+  };
+
+  /* The candidate nearest to the query.  Candidates are ranked by lower bound, and then
+   * compared in that order, abandoning each comparison once it exceeds the nearest found so
+   * far; the search stops when the next lower bound exceeds it.
+   *
+   * Throws a std::invalid_argument exception if there are no candidates.
+   */
+  TrajectoryMatch nearestTrajectory(const Trajectory & query, const std::vector<Trajectory> & candidates,
+                                    SimilarityOptions = {});
+
+
+  /* As nearestTrajectory(), for each query, on a WorkStealingPool of the given number of
+   * threads (0 for one per core).
+   */
+  std::vector<TrajectoryMatch> nearestTrajectories(const std::vector<Trajectory> & queries,
+                                                   const std::vector<Trajectory> & candidates,
+                                                   SimilarityOptions = {}, unsigned threads = 0);
+
+
+  /* The distance from every query to every candidate (indexed [query][candidate]), on a
+   * WorkStealingPool of the given number of threads (0 for one per core).
+   */
+  std::vector<std::vector<metres>> distanceMatrix(const std::vector<Trajectory> & queries,
+                                                  const std::vector<Trajectory> & candidates,
+                                                  SimilarityOptions = {}, unsigned threads = 0);
+}
+
+#endif
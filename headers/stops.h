@@ -0,0 +1,106 @@
+#ifndef STOPS_H_191026
+#define STOPS_H_191026
+
+#include <cstddef>
+#include <deque>
+#include <optional>
+#include <vector>
+
+#include "types.h"
+#include "position.h"
+#include "fix.h"
+#include "cartesian.h"
+
+namespace GPS
+{
+  // A period during which a receiver stayed within a small area.
+  struct Stop
+  {
+      Position position; // the mean latitude and longitude of the fixes (at zero elevation)
+      seconds arrival;   // the time of the first fix
+      seconds departure; // the time of the last fix
+      std::size_t fixCount;
+  };
+
+
+  /* A streaming stop (stay-point) detector.
+   *
+   * A Stop is a maximal run of consecutive Fixes that all lie within 'radius' metres
+   * (horizontally) of the first Fix of the run, spanning at least 'minimumDwell' seconds.
+   * When a Fix leaves the radius of a run too short to be a Stop, the run is restarted
+   * from the next Fix of the run that can still begin one, so a Stop is found however the
+   * receiver approached it.
+   *
+   * Distances are the chords between Positions converted to ECEF once each, compared
+   * against the chord of 'radius', which agrees with Position::horizontalDistanceBetween()
+   * without trigonometry per comparison.  Memory is bounded by the number of Fixes that
+   * lie within one run shorter than 'minimumDwell'.  Fix times must not decrease.
+   */
+  class StopDetector
+  {
+    public:
+      // Throws std::invalid_argument if 'radius' is not positive or 'minimumDwell' is negative.
+      StopDetector(metres radius, seconds minimumDwell);
+
+      // Adds the next Fix, returning the Stop that it ended, if any.
+      std::optional<Stop> add(const Fix &);
+
+      // Returns the Stop in progress, if any, and starts afresh.
+      std::optional<Stop> finish();
+
+    private:
+      struct Candidate
+      {
+          Fix fix;
+          ECEF ecef;
+      };
+
+      bool withinRadius(const ECEF &, const ECEF &) const;
+      bool reachesDwell(seconds lastTime) const;
+      void becomeStop();
+      Stop currentStop() const;
+
+      metres chordSqr;
+      seconds minimumDwell;
+      std::deque<Candidate> run; // the current run, first Fix at the front
+
+      /* Once the run is long enough to be a Stop it can only grow until it ends, so only
+       * its first Fix (in 'run') and these totals are kept.
+       */
+      bool isStop = false;
+      seconds lastTime = 0;
+      std::size_t fixCount = 0;
+      double latitudeSum = 0, longitudeSum = 0;
+  };
+
+
+  // The Stops in a sequence of Fixes, as found by a StopDetector.
+  std::vector<Stop> stopsFromFixes(const std::vector<Fix> &, metres radius, seconds minimumDwell);
+
+
+  /* DBSCAN density-based clustering of Positions.
+   *
+   * Two Positions are neighbours if they are within 'epsilon' metres (horizontally) of one
+   * another.  A Position with at least 'minimumPoints' neighbours (counting itself) is a
+   * core point; clusters are the connected groups of core points, together with the
+   * Positions that neighbour them.
+   *
+   * Neighbours are found through a grid of cells at least 'epsilon' wide, so each query
+   * examines only the Positions in the 3x3 cells around a Position; for data of bounded
+   * density the whole clustering takes near-linear time.  The Positions must not span the
+   * anti-meridian or lie within 'epsilon' of a pole.
+   */
+  struct Clustering
+  {
+      static constexpr int noise = -1;
+
+      // For each Position, the number of its cluster (from 0), or 'noise'.
+      std::vector<int> labels;
+      std::size_t clusterCount = 0;
+  };
+
+  // Throws std::invalid_argument if 'epsilon' is not positive.
+  Clustering clusterPositions(const std::vector<Position> &, metres epsilon, std::size_t minimumPoints);
+}
+
+#endif
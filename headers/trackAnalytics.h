@@ -0,0 +1,41 @@
+#ifndef TRACKANALYTICS_H_191026
+#define TRACKANALYTICS_H_191026
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "position.h"
+
+namespace GPS
+{
+  // Summary statistics of a track (a sequence of Positions).
+  struct TrackSummary
+  {
+      std::string logFile;        // the log the track was read from, if any
+      std::size_t numPositions = 0;
+
+      metres totalDistance = 0;   // sum of horizontal distances between consecutive Positions
+
+      // Bounds of the track; all zero for an empty track.
+      degrees minLatitude  = 0, maxLatitude  = 0;
+      degrees minLongitude = 0, maxLongitude = 0;
+      metres  minElevation = 0, maxElevation = 0;
+  };
+
+
+  // Computes the summary statistics of a track.
+  TrackSummary summariseTrack(const std::vector<Position> &);
+
+
+  /* Parses each NMEA log file (as positionsFromLog()) and summarises its track.
+   * Files are processed in parallel on a WorkStealingPool of the given number of threads.
+   * The summaries are returned in the same order as the file paths.
+   *
+   * Throws a std::invalid_argument exception if a log file cannot be opened.
+   */
+  std::vector<TrackSummary> summariseLogs(const std::vector<std::string> & logFilePaths,
+                                          unsigned threads = 0);
+}
+
+#endif
@@ -0,0 +1,143 @@
+#ifndef TRACKSTORE_H_191026
+#define TRACKSTORE_H_191026
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "types.h"
+#include "fix.h"
+
+namespace GPS
+{
+  /* A stable, read-only view of the Fixes that a TrackStore held when the view was taken.
+   * Taking and reading snapshots never blocks the writer, nor is blocked by it, and later
+   * appends do not change a snapshot.  A snapshot must not outlive its store.
+   */
+  class TrackSnapshot
+  {
+    public:
+      static constexpr std::size_t chunkSize = 4096; // Fixes per chunk; a power of 2
+
+      std::size_t size() const { return count; }
+      bool empty() const { return count == 0; }
+
+      // The Fix at 'index', which must be less than size().
+      const Fix & operator[](std::size_t index) const
+      {
+          return chunks[index / chunkSize].fixes[index % chunkSize];
+      }
+
+      /* The time of the Fix at 'index' (which must be less than size()), counted from
+       * midnight on the day of the first Fix: its time of day, plus a day for each midnight
+       * the track has passed since the first Fix.
+       */
+      seconds trackTime(std::size_t index) const
+      {
+          return chunks[index / chunkSize].times[index % chunkSize];
+      }
+
+      /* The indices [first, last) of the Fixes whose trackTime() is between 'from' and 'to'
+       * inclusive.  first == last if there are none.
+       */
+      std::pair<std::size_t, std::size_t> indicesBetween(seconds from, seconds to) const;
+
+      /* Calls 'f' with the Fixes at indices [first, last) (clamped to size()), as a span of
+       * contiguous Fixes for each chunk they lie in.
+       */
+      template <typename F>
+      void forEachSpan(std::size_t first, std::size_t last, F && f) const
+      {
+          last = std::min(last, count);
+          while (first < last)
+          {
+              const std::size_t offset = first % chunkSize;
+              const std::size_t length = std::min(chunkSize - offset, last - first);
+              f(std::span<const Fix>(chunks[first / chunkSize].fixes + offset, length));
+              first += length;
+          }
+      }
+
+      // Calls 'f' with each Fix at indices [first, last), in order.
+      template <typename F>
+      void forEach(std::size_t first, std::size_t last, F && f) const
+      {
+          forEachSpan(first, last, [&f](std::span<const Fix> span) { for (const Fix & fix : span) f(fix); });
+      }
+
+      // Copies the Fixes at indices [first, last).
+      std::vector<Fix> fixes(std::size_t first, std::size_t last) const;
+
+    private:
+      friend class TrackStore;
+
+      // The Fixes of a chunk, and their track times.
+      struct Chunk
+      {
+          Fix * fixes;
+          seconds * times;
+      };
+
+      TrackSnapshot(const Chunk * chunks, std::size_t count) : chunks(chunks), count(count) {}
+
+      const Chunk * chunks;
+      std::size_t count;
+  };
+
+
+  /* An append-only store of a track's Fixes, written by one thread while any number of
+   * others read it through TrackSnapshots, without locks.
+   *
+   * Fixes are stored in fixed-size chunks that never move once allocated, listed in a
+   * directory of chunk pointers.  The writer fills a slot and then publishes the new count
+   * (a release store); a reader's snapshot is the published count and directory (acquire
+   * loads), so every Fix it can index was completely written before it was published.
+   * When the directory fills, the writer publishes a copy twice the size; the old one is
+   * retired rather than freed, as readers may still hold it.  Retired directories total
+   * less than the current one, so they are kept until the store is destroyed.
+   *
+   * Fixes must be appended in time order.  As Fix times are times of day, a Fix whose time
+   * is earlier than the last one's is taken to be on the following day (see elapsedTime()),
+   * and each Fix is stored with its trackTime(), which increases along the track, so that
+   * time ranges can be found by binary search however many midnights the track spans.
+   */
+  class TrackStore
+  {
+    public:
+      static constexpr std::size_t chunkSize = TrackSnapshot::chunkSize;
+
+      TrackStore();
+      ~TrackStore();
+
+      TrackStore(const TrackStore &) = delete;
+      TrackStore & operator=(const TrackStore &) = delete;
+
+      // Appends a Fix.  Only one thread may append.
+      void append(const Fix &);
+
+      // The number of Fixes appended so far.
+      std::size_t size() const { return published.load(std::memory_order_acquire); }
+
+      TrackSnapshot snapshot() const;
+
+    private:
+      void addChunk();
+
+      // Written only by the writer, and read by readers only below the published count.
+      using Chunk = TrackSnapshot::Chunk;
+      std::vector<std::unique_ptr<Chunk []>> directories; // the last is current; the rest are retired
+      std::size_t directoryCapacity = 0;
+      std::vector<Chunk> chunks;
+      seconds lastTrackTime = 0; // of the last Fix appended
+
+      std::atomic<const Chunk *> directory {nullptr};
+      // On its own cache line, as every reader loads it and the writer stores it on every append.
+      alignas(64) std::atomic<std::size_t> published {0};
+  };
+}
+
+#endif
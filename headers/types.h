@@ -7,6 +7,7 @@ namespace GPS
   using radians = double;
   using metres  = double;
   using speed   = double;
+  using seconds = double;
 }
 
 #endif
@@ -0,0 +1,77 @@
+#ifndef WORKSTEALING_H_191026
+#define WORKSTEALING_H_191026
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace GPS
+{
+  /* A fixed-size pool of worker threads that balances load by work stealing.
+   *
+   * Each worker has its own task deque.  A worker takes tasks from the back of its own
+   * deque (most recently submitted first, which keeps related work on one core) and, when
+   * that is empty, steals from the front of another worker's deque.  Tasks submitted from
+   * inside a task go to the submitting worker's deque; other tasks are dealt round-robin.
+   *
+   * The pool suits collections of independent tasks of very uneven cost, such as parsing
+   * log files of very different sizes, where a static split would leave threads idle.
+   */
+  class WorkStealingPool
+  {
+    public:
+      using Task = std::function<void()>;
+
+      explicit WorkStealingPool(unsigned threads = std::thread::hardware_concurrency());
+
+      // Waits for outstanding tasks, then stops the workers.
+      ~WorkStealingPool();
+
+      WorkStealingPool(const WorkStealingPool &) = delete;
+      WorkStealingPool & operator=(const WorkStealingPool &) = delete;
+
+      void submit(Task);
+
+      /* Blocks until every submitted task (including tasks submitted by tasks) has finished.
+       * If any task threw an exception, the first such exception is rethrown here.
+       */
+      void wait();
+
+      unsigned threadCount() const;
+
+      // The number of tasks that were run by a worker other than the one they were queued on.
+      unsigned long stealCount() const;
+
+    private:
+      struct WorkerQueue
+      {
+          std::mutex mutex;
+          std::deque<Task> tasks;
+      };
+
+      bool takeTask(unsigned worker, Task &);
+      void runWorker(unsigned worker);
+
+      std::vector<std::unique_ptr<WorkerQueue>> queues;
+      std::vector<std::thread> workers;
+
+      std::mutex stateMutex;
+      std::condition_variable workAvailable;
+      std::condition_variable allDone;
+      std::atomic<unsigned long> queued {0};  // tasks in the deques, or being pushed to one
+      unsigned long unfinished = 0;           // tasks submitted but not yet finished (guarded by stateMutex)
+      bool stopping = false;                  // guarded by stateMutex
+      std::exception_ptr firstError;          // guarded by stateMutex
+
+      std::atomic<unsigned> nextQueue {0};
+      std::atomic<unsigned long> steals {0};
+  };
+}
+
+#endif
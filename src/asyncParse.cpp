@@ -0,0 +1,77 @@
+#include <optional>
+
+#include "blockReading.h"
+#include "parseNMEA.h"
+#include "asyncParse.h"
+
+namespace NMEA
+{
+  namespace
+  {
+      bool isSpace(char c)
+      {
+          return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\v' || c == '\f';
+      }
+  }
+
+  GPS::Generator<std::string> readBlocks(std::istream & log, AsyncParseOptions options)
+  {
+      return blocksFromTask(options.queueDepth, [&log, options](GPS::BoundedQueue<std::string> & blocks)
+      {
+          std::string block = readBlock(log, options.blockSize);
+          while (!block.empty() && blocks.push(std::move(block)))
+          {
+              block = readBlock(log, options.blockSize);
+          }
+      });
+  }
+
+  GPS::Generator<std::string_view> sentencesIn(GPS::Generator<std::string> blocks)
+  {
+      std::string partial; // a token cut off by the end of the previous block
+
+      for (const std::string & block : blocks)
+      {
+          std::size_t pos = 0;
+          if (!partial.empty())
+          {
+              while (pos < block.size() && !isSpace(block[pos])) ++pos;
+              partial.append(block, 0, pos);
+              if (pos == block.size()) continue; // the token spans the whole block
+              co_yield partial;
+              partial.clear();
+          }
+
+          while (true)
+          {
+              while (pos < block.size() && isSpace(block[pos])) ++pos;
+              const std::size_t start = pos;
+              while (pos < block.size() && !isSpace(block[pos])) ++pos;
+              if (pos == block.size())
+              {
+                  partial.assign(block, start, pos - start);
+                  break;
+              }
+              co_yield std::string_view(block).substr(start, pos - start);
+          }
+      }
+
+      if (!partial.empty()) co_yield partial;
+  }
+
+  GPS::Generator<GPS::Position> positionsIn(GPS::Generator<std::string_view> sentences)
+  {
+      for (std::string_view sentence : sentences)
+      {
+          if (std::optional<GPS::Position> position = positionFromLine(sentence))
+          {
+              co_yield *position;
+          }
+      }
+  }
+
+  GPS::Generator<GPS::Position> asyncPositionsFromLog(std::istream & log, AsyncParseOptions options)
+  {
+      return positionsIn(sentencesIn(readBlocks(log, options)));
+  }
+}
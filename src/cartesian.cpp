@@ -0,0 +1,86 @@
+#include <cmath>
+
+#include "geometry.h"
+#include "earth.h"
+#include "cartesian.h"
+
+namespace GPS
+{
+  ECEF toECEF(const Position & pos)
+  {
+      // A batch of one, so that there is only one conversion to keep right.
+      const degrees lat = pos.latitude(), lon = pos.longitude();
+      const metres ele = pos.elevation();
+      ECEF result;
+      Earth::toECEF(&lat, &lon, &ele, &result.x, &result.y, &result.z, 1);
+      return result;
+  }
+
+  Position fromECEF(const ECEF & p)
+  {
+      const metres horizontal = pythagoras(p.x, p.y);
+      const metres r = pythagoras(horizontal, p.z);
+      const degrees lat = radToDeg(std::atan2(p.z, horizontal));
+      const degrees lon = (horizontal == 0) ? 0 : radToDeg(std::atan2(p.y, p.x));
+      return Position(lat, lon, r - Earth::meanRadius);
+  }
+
+  void toECEF(const Position * in, ECEF * out, std::size_t n)
+  {
+      for (std::size_t i = 0; i < n; ++i)
+      {
+          out[i] = toECEF(in[i]);
+      }
+  }
+
+  metres distanceBetween(const ECEF & p1, const ECEF & p2)
+  {
+      return pythagoras(p2.x - p1.x, p2.y - p1.y, p2.z - p1.z);
+  }
+
+  LocalFrame::LocalFrame(Position origin)
+      : originPos(origin),
+        originECEF(toECEF(origin)),
+        sinLat(std::sin(degToRad(origin.latitude()))),
+        cosLat(std::cos(degToRad(origin.latitude()))),
+        sinLon(std::sin(degToRad(origin.longitude()))),
+        cosLon(std::cos(degToRad(origin.longitude())))
+  {}
+
+  const Position & LocalFrame::origin() const
+  {
+      return originPos;
+  }
+
+  ENU LocalFrame::toENU(const ECEF & p) const
+  {
+      const metres dx = p.x - originECEF.x;
+      const metres dy = p.y - originECEF.y;
+      const metres dz = p.z - originECEF.z;
+      return { -sinLon * dx + cosLon * dy,
+               -sinLat * cosLon * dx - sinLat * sinLon * dy + cosLat * dz,
+                cosLat * cosLon * dx + cosLat * sinLon * dy + sinLat * dz };
+  }
+
+  ENU LocalFrame::toENU(const Position & pos) const
+  {
+      return toENU(toECEF(pos));
+  }
+
+  Position LocalFrame::toPosition(const ENU & enu) const
+  {
+      // The transpose of the rotation in toENU().
+      const ECEF p { originECEF.x - sinLon * enu.east - sinLat * cosLon * enu.north + cosLat * cosLon * enu.up,
+                     originECEF.y + cosLon * enu.east - sinLat * sinLon * enu.north + cosLat * sinLon * enu.up,
+                     originECEF.z + cosLat * enu.north + sinLat * enu.up };
+      return fromECEF(p);
+  }
+
+  void LocalFrame::toENU(const Position * in, ENU * out, std::size_t n) const
+  {
+      for (std::size_t i = 0; i < n; ++i)
+      {
+          out[i] = toENU(toECEF(in[i]));
+      }
+  }
+}
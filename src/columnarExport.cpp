@@ -0,0 +1,253 @@
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include "parseNMEA.h"
+#include "columnarExport.h"
+
+namespace NMEA
+{
+  namespace
+  {
+      const char magic[8] = {'N','M','E','A','C','O','L','1'};
+      const std::size_t alignment = 8;
+
+      template <typename T>
+      void writeValue(std::ostream & out, const T & value)
+      {
+          out.write(reinterpret_cast<const char *>(&value), sizeof(T));
+      }
+
+      template <typename T>
+      void writeColumn(std::ostream & out, const std::vector<T> & column)
+      {
+          out.write(reinterpret_cast<const char *>(column.data()), column.size() * sizeof(T));
+      }
+
+      template <typename T>
+      T readValue(std::istream & in)
+      {
+          T value;
+          if (!in.read(reinterpret_cast<char *>(&value), sizeof(T))){
+              throw std::invalid_argument("Truncated columnar file.");
+          }
+          return value;
+      }
+
+      template <typename T>
+      void readColumn(std::istream & in, std::vector<T> & column, std::size_t rows)
+      {
+          column.resize(rows);
+          if (!in.read(reinterpret_cast<char *>(column.data()), rows * sizeof(T))){
+              throw std::invalid_argument("Truncated columnar file.");
+          }
+      }
+
+      std::size_t padding(std::size_t bytes)
+      {
+          return (alignment - bytes % alignment) % alignment;
+      }
+  }
+
+  ColumnarWriter::ColumnarWriter(std::ostream & out, std::size_t batchRows)
+      : out(out),
+        batchRows(batchRows)
+  {
+      if (batchRows == 0 || batchRows > UINT32_MAX){
+          throw std::invalid_argument("Invalid columnar batch size.");
+      }
+      latitudes.reserve(batchRows);
+      longitudes.reserve(batchRows);
+      elevations.reserve(batchRows);
+      times.reserve(batchRows);
+      formats.reserve(batchRows);
+
+      out.write(magic, sizeof(magic));
+      offset = sizeof(magic);
+  }
+
+  ColumnarWriter::~ColumnarWriter()
+  {
+      if (!finished){
+          finish();
+      }
+  }
+
+  void ColumnarWriter::append(const GPS::Fix & fix, std::string_view format)
+  {
+      if (finished){
+          throw std::invalid_argument("Cannot append to a finished columnar file.");
+      }
+
+      auto entry = std::find(dictionary.begin(), dictionary.end(), format);
+      if (entry == dictionary.end()){
+          if (dictionary.size() == 256){
+              throw std::invalid_argument("Too many distinct sentence formats.");
+          }
+          entry = dictionary.emplace(dictionary.end(), format);
+      }
+
+      latitudes.push_back(fix.position.latitude());
+      longitudes.push_back(fix.position.longitude());
+      elevations.push_back(fix.position.elevation());
+      times.push_back(fix.time);
+      formats.push_back(static_cast<std::uint8_t>(entry - dictionary.begin()));
+
+      if (formats.size() == batchRows){
+          writeBatch();
+      }
+  }
+
+  void ColumnarWriter::writeBatch()
+  {
+      const std::uint32_t rows = formats.size();
+      batchOffsets.push_back(offset);
+
+      writeValue(out, rows);
+      writeValue(out, std::uint32_t{0});
+      writeColumn(out, latitudes);
+      writeColumn(out, longitudes);
+      writeColumn(out, elevations);
+      writeColumn(out, times);
+      writeColumn(out, formats);
+      const char zeros[alignment] = {};
+      out.write(zeros, padding(rows));
+
+      offset += 2 * sizeof(std::uint32_t) + rows * (4 * sizeof(double) + 1) + padding(rows);
+      totalRows += rows;
+
+      latitudes.clear();
+      longitudes.clear();
+      elevations.clear();
+      times.clear();
+      formats.clear();
+  }
+
+  void ColumnarWriter::finish()
+  {
+      if (finished){
+          return;
+      }
+      if (!formats.empty()){
+          writeBatch();
+      }
+
+      std::uint32_t footerLength = 0;
+      writeValue(out, static_cast<std::uint32_t>(dictionary.size()));
+      footerLength += sizeof(std::uint32_t);
+      for (const std::string & format : dictionary){
+          writeValue(out, static_cast<std::uint8_t>(format.size()));
+          out.write(format.data(), format.size());
+          footerLength += 1 + format.size();
+      }
+      writeValue(out, static_cast<std::uint32_t>(batchOffsets.size()));
+      footerLength += sizeof(std::uint32_t);
+      for (std::uint64_t batchOffset : batchOffsets){
+          writeValue(out, batchOffset);
+          footerLength += sizeof(std::uint64_t);
+      }
+      writeValue(out, totalRows);
+      footerLength += sizeof(std::uint64_t);
+
+      writeValue(out, footerLength);
+      out.write(magic, sizeof(magic));
+      out.flush();
+      finished = true;
+  }
+
+  std::uint64_t ColumnarWriter::rowsWritten() const
+  {
+      return totalRows + formats.size();
+  }
+
+  ColumnarReader::ColumnarReader(std::istream & in)
+      : in(in)
+  {
+      char header[sizeof(magic)], trailer[sizeof(magic)];
+      const std::streamoff tailLength = sizeof(std::uint32_t) + sizeof(magic);
+
+      in.seekg(0);
+      if (!in.read(header, sizeof(header)) || !std::equal(header, header + sizeof(header), magic)){
+          throw std::invalid_argument("Not a columnar file.");
+      }
+      in.seekg(-tailLength, std::ios::end);
+      const std::uint32_t footerLength = readValue<std::uint32_t>(in);
+      if (!in.read(trailer, sizeof(trailer)) || !std::equal(trailer, trailer + sizeof(trailer), magic)){
+          throw std::invalid_argument("Columnar file has no footer.");
+      }
+
+      in.seekg(-(tailLength + footerLength), std::ios::end);
+      const std::uint32_t dictionarySize = readValue<std::uint32_t>(in);
+      for (std::uint32_t i = 0; i < dictionarySize; ++i){
+          std::string format(readValue<std::uint8_t>(in), '\0');
+          if (!in.read(format.data(), format.size())){
+              throw std::invalid_argument("Truncated columnar file.");
+          }
+          dictionary.push_back(std::move(format));
+      }
+      const std::uint32_t batches = readValue<std::uint32_t>(in);
+      for (std::uint32_t i = 0; i < batches; ++i){
+          batchOffsets.push_back(readValue<std::uint64_t>(in));
+      }
+      totalRows = readValue<std::uint64_t>(in);
+  }
+
+  std::uint64_t ColumnarReader::rows() const
+  {
+      return totalRows;
+  }
+
+  std::size_t ColumnarReader::batchCount() const
+  {
+      return batchOffsets.size();
+  }
+
+  const std::vector<std::string> & ColumnarReader::formatDictionary() const
+  {
+      return dictionary;
+  }
+
+  ColumnBatch ColumnarReader::readBatch(std::size_t i)
+  {
+      in.clear();
+      in.seekg(batchOffsets.at(i));
+      const std::uint32_t rows = readValue<std::uint32_t>(in);
+      readValue<std::uint32_t>(in); // padding
+
+      ColumnBatch batch;
+      readColumn(in, batch.latitudes, rows);
+      readColumn(in, batch.longitudes, rows);
+      readColumn(in, batch.elevations, rows);
+      readColumn(in, batch.times, rows);
+      readColumn(in, batch.formats, rows);
+      for (std::uint8_t format : batch.formats){
+          if (format >= dictionary.size()){
+              throw std::invalid_argument("Invalid sentence format index in columnar file.");
+          }
+      }
+      return batch;
+  }
+
+  std::uint64_t exportColumnar(std::istream & log, std::ostream & out, std::size_t batchRows)
+  {
+      ColumnarWriter writer(out, batchRows);
+      std::string data;
+      while (log >> data){
+          const std::optional<LazySentence> sentence = LazySentence::fromLine(data);
+          if (!sentence){
+              continue;
+          }
+          std::optional<GPS::Fix> fix;
+          try {
+              const GPS::seconds time = sentence->time();
+              fix = GPS::Fix{sentence->position(), time};
+          }
+          catch (const std::invalid_argument &) {
+              continue; //Lines with invalid data are ignored, as in fixesFromLog()
+          }
+          writer.append(*fix, sentence->format());
+      }
+      writer.finish();
+      return writer.rowsWritten();
+  }
+}
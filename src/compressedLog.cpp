@@ -0,0 +1,166 @@
+#include <functional>
+#include <optional>
+#include <stdexcept>
+
+#include <zlib.h>
+
+#include "blockReading.h"
+#include "compressedLog.h"
+
+namespace NMEA
+{
+  namespace
+  {
+      bool startsWith(const std::string & block, std::initializer_list<unsigned char> magic)
+      {
+          if (block.size() < magic.size()) return false;
+          std::size_t i = 0;
+          for (unsigned char byte : magic)
+          {
+              if (static_cast<unsigned char>(block[i++]) != byte) return false;
+          }
+          return true;
+      }
+
+      // Owns a zlib inflate stream.
+      class Inflater
+      {
+        public:
+          Inflater()
+          {
+              // 32 + MAX_WBITS: accept either a gzip or a zlib header.
+              if (inflateInit2(&stream, 32 + MAX_WBITS) != Z_OK)
+                  throw std::invalid_argument("Could not initialise decompression.");
+          }
+
+          ~Inflater() { inflateEnd(&stream); }
+
+          Inflater(const Inflater &) = delete;
+          Inflater & operator=(const Inflater &) = delete;
+
+          z_stream stream {};
+      };
+
+      /* Reads 'source' in blocks of 'blockSize', passing its decompressed contents to 'emit'
+       * in blocks of at most 'blockSize'.  Stops early if 'emit' returns false.
+       */
+      void decompress(std::istream & source, std::size_t blockSize,
+                      const std::function<bool(std::string)> & emit)
+      {
+          std::string input = readBlock(source, blockSize);
+          if (startsWith(input, {0x28, 0xB5, 0x2F, 0xFD}))
+          {
+              throw std::invalid_argument("zstd-compressed logs are not supported; only gzip.");
+          }
+          if (!startsWith(input, {0x1F, 0x8B}))
+          {
+              // Not compressed: pass the contents through unchanged.
+              while (!input.empty())
+              {
+                  if (!emit(std::move(input))) return;
+                  input = readBlock(source, blockSize);
+              }
+              return;
+          }
+
+          Inflater inflater;
+          z_stream & z = inflater.stream;
+          bool inMember = true; // within a gzip member, i.e. more output is expected
+          do
+          {
+              z.next_in = reinterpret_cast<Bytef *>(input.data());
+              z.avail_in = input.size();
+
+              // Inflate until this input block is used up and no output is pending.
+              while (true)
+              {
+                  if (!inMember)
+                  {
+                      if (z.avail_in == 0) break;
+                      inflateReset(&z); // another gzip member follows the previous one
+                      inMember = true;
+                  }
+
+                  std::string output(blockSize, '\0');
+                  z.next_out = reinterpret_cast<Bytef *>(output.data());
+                  z.avail_out = output.size();
+                  const int status = inflate(&z, Z_NO_FLUSH);
+                  if (status == Z_STREAM_END)
+                  {
+                      inMember = false;
+                  }
+                  else if (status != Z_OK && status != Z_BUF_ERROR)
+                  {
+                      throw std::invalid_argument(std::string("Corrupt compressed log: ") + (z.msg ? z.msg : "unknown error"));
+                  }
+
+                  const bool outputFull = (z.avail_out == 0);
+                  output.resize(output.size() - z.avail_out);
+                  if (!output.empty() && !emit(std::move(output))) return;
+
+                  // Z_BUF_ERROR means no progress was possible without more input.
+                  if (status == Z_BUF_ERROR || (inMember && !outputFull && z.avail_in == 0)) break;
+              }
+              input = readBlock(source, blockSize);
+          }
+          while (!input.empty());
+
+          if (inMember)
+          {
+              throw std::invalid_argument("Truncated compressed log.");
+          }
+      }
+  }
+
+  DecompressingStreambuf::DecompressingStreambuf(std::istream & source, AsyncParseOptions options)
+      : blocks(options.queueDepth)
+  {
+      decompressor = std::async(std::launch::async, [this, &source, options]
+      {
+          CloseOnExit closeWhenDone{blocks};
+          decompress(source, options.blockSize, [this](std::string block){ return blocks.push(std::move(block)); });
+      });
+  }
+
+  DecompressingStreambuf::~DecompressingStreambuf()
+  {
+      blocks.close(); // unblocks the decompressor if the reader stopped early
+      if (decompressor.valid()) decompressor.wait();
+  }
+
+  DecompressingStreambuf::int_type DecompressingStreambuf::underflow()
+  {
+      if (gptr() < egptr()) return traits_type::to_int_type(*gptr());
+
+      while (std::optional<std::string> block = blocks.pop())
+      {
+          current = std::move(*block);
+          if (current.empty()) continue;
+          setg(current.data(), current.data(), current.data() + current.size());
+          return traits_type::to_int_type(*gptr());
+      }
+      if (decompressor.valid()) decompressor.get(); // rethrows any decompression error
+      return traits_type::eof();
+  }
+
+  DecompressingStream::DecompressingStream(std::istream & source, AsyncParseOptions options)
+      : std::istream(nullptr),
+        buffer(source, options)
+  {
+      rdbuf(&buffer);
+      exceptions(std::ios::badbit);
+  }
+
+  GPS::Generator<std::string> decompressedBlocks(std::istream & source, AsyncParseOptions options)
+  {
+      return blocksFromTask(options.queueDepth, [&source, options](GPS::BoundedQueue<std::string> & blocks)
+      {
+          decompress(source, options.blockSize, [&](std::string block){ return blocks.push(std::move(block)); });
+      });
+  }
+
+  GPS::Generator<GPS::Position> asyncPositionsFromCompressedLog(std::istream & source, AsyncParseOptions options)
+  {
+      return positionsIn(sentencesIn(decompressedBlocks(source, options)));
+  }
+}
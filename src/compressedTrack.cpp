@@ -0,0 +1,434 @@
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+#include <utility>
+
+#include "compressedTrack.h"
+
+namespace GPS
+{
+  namespace
+  {
+      // The stored resolution of each column, in units per degree, metre or second.
+      const double unitsPerDegree = 60 * 100000; // 1e-5 minutes of arc
+      const double centimetresPerMetre = 100;
+      const double millisecondsPerSecond = 1000;
+
+      enum { latitudeColumn, longitudeColumn, elevationColumn, timeColumn };
+      const double unitsPerValue[] = {unitsPerDegree, unitsPerDegree, centimetresPerMetre, millisecondsPerSecond};
+
+      /* Delta-of-deltas are packed in blocks of 'blockLength', each at the width (in bits)
+       * of its largest (zig-zag encoded) value, after a byte giving that width.
+       */
+      constexpr std::size_t blockLength = 64;
+
+      // Padding after a chunk's data, for the unpackers' whole-word reads.
+      constexpr std::size_t paddingBytes = 16;
+
+      // Values smaller than this in magnitude convert to double by a vectorisable addition.
+      constexpr std::int64_t smallLimit = std::int64_t{1} << 51;
+
+      std::uint64_t zigZag(std::int64_t value)
+      {
+          return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+      }
+
+      std::int64_t unZigZag(std::uint64_t value)
+      {
+          return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+      }
+
+      std::uint64_t loadWord(const std::uint8_t * data)
+      {
+          std::uint64_t word;
+          std::memcpy(&word, data, sizeof(word));
+          return word;
+      }
+
+      // Appends a block of values, lowest bit first, at the width of the largest.
+      void packBlock(const std::uint64_t * values, std::vector<std::uint8_t> & out)
+      {
+          std::uint64_t all = 0;
+          for (std::size_t j = 0; j < blockLength; ++j) all |= values[j];
+          const unsigned width = std::bit_width(all);
+          out.push_back(static_cast<std::uint8_t>(width));
+
+          const std::size_t start = out.size();
+          out.resize(start + blockLength * width / 8);
+          for (std::size_t j = 0; j < blockLength; ++j)
+          {
+              for (unsigned bit = 0; bit < width; ++bit)
+              {
+                  const std::size_t position = j * width + bit;
+                  out[start + position / 8] |= static_cast<std::uint8_t>(((values[j] >> bit) & 1) << (position % 8));
+              }
+          }
+      }
+
+      /* Unpacks a block of values of the given width.  The width is a template parameter, so
+       * that each value's position and mask are constants: the values are independent, with
+       * no branches, and the loop unrolls into loads, shifts and masks.  Reads up to 9 bytes
+       * beyond the block.
+       */
+      template <unsigned width>
+      void unpackBlock(const std::uint8_t * data, std::uint64_t * values)
+      {
+          constexpr std::uint64_t mask = width == 64 ? ~std::uint64_t{0} : (std::uint64_t{1} << width) - 1;
+          #pragma GCC unroll 64
+          for (std::size_t j = 0; j < blockLength; ++j)
+          {
+              const std::size_t position = j * width;
+              const unsigned shift = position % 8;
+              std::uint64_t word = loadWord(data + position / 8) >> shift;
+              if constexpr (width > 57)
+              {
+                  // The top bits are in a ninth byte (none when the shift is 0).
+                  word |= (std::uint64_t{data[position / 8 + 8]} << 1) << (63 - shift);
+              }
+              values[j] = word & mask;
+          }
+      }
+
+      using Unpacker = void (*)(const std::uint8_t *, std::uint64_t *);
+
+      // The unpacker for each width, from 0 to 64 bits.
+      constexpr auto unpackers = []<std::size_t... widths>(std::index_sequence<widths...>)
+      {
+          return std::array<Unpacker, sizeof...(widths)> { &unpackBlock<widths>... };
+      }(std::make_index_sequence<65>());
+
+      /* Writes the delta-of-deltas of 'values' (offset from and divided by the first value
+       * and scale) at a stride: each value is predicted to continue the step from the value
+       * 'stride' before it, taking values before the first to be equal to it.
+       * Arithmetic wraps, so that any sequence of 64-bit values round-trips.
+       */
+      void encodeColumn(const std::vector<std::int64_t> & values, std::int64_t scale, unsigned stride,
+                        std::vector<std::uint8_t> & out)
+      {
+          auto normalised = [&](std::size_t i) -> std::uint64_t
+          {
+              return scale == 1 ? std::uint64_t(values[i]) - std::uint64_t(values[0])
+                                : static_cast<std::uint64_t>((values[i] - values[0]) / scale);
+          };
+          // The last block is filled out with zeros.
+          std::array<std::uint64_t, blockLength> block {};
+          std::size_t filled = 0;
+          for (std::size_t i = 1; i < values.size(); ++i)
+          {
+              const std::uint64_t previous = i >= stride ? normalised(i - stride) : 0;
+              const std::uint64_t beforeThat = i >= 2 * stride ? normalised(i - 2 * stride) : 0;
+              const std::uint64_t predicted = 2 * previous - beforeThat;
+              block[filled++] = zigZag(static_cast<std::int64_t>(normalised(i) - predicted));
+              if (filled == blockLength)
+              {
+                  packBlock(block.data(), out);
+                  filled = 0;
+              }
+          }
+          if (filled > 0)
+          {
+              std::fill(block.begin() + filled, block.end(), 0);
+              packBlock(block.data(), out);
+          }
+      }
+
+      /* The inverse of encodeColumn(), writing the 'count' values of a column (converted back
+       * to degrees, metres or seconds) to 'out'.  The blocks are unpacked first, then summed
+       * twice to undo the delta-of-deltas, and then converted; only the sums depend on one
+       * another.
+       */
+      void decodeColumn(const std::uint8_t * data, std::int64_t first, std::int64_t scale, unsigned stride,
+                        bool small, double unitsPerValue, std::size_t count, double * out)
+      {
+          std::array<std::uint64_t, CompressedTrack::chunkSize + blockLength> codes;
+          for (std::size_t i = 1; i < count; i += blockLength)
+          {
+              const unsigned width = *data++;
+              unpackers[width](data, codes.data() + i);
+              data += blockLength * width / 8;
+          }
+
+          // The values less the first, summed in place.  Each phase of a stride of 2 has its
+          // own sums, kept in registers, so that the loop carries no dependency through memory.
+          std::uint64_t * const values = codes.data();
+          values[0] = 0;
+          for (std::size_t i = 1; i < count; ++i) values[i] = static_cast<std::uint64_t>(unZigZag(values[i]));
+          if (stride == 1)
+          {
+              std::uint64_t step = 0, sum = 0;
+              for (std::size_t i = 1; i < count; ++i)
+              {
+                  step += values[i];
+                  sum += step;
+                  values[i] = sum * std::uint64_t(scale);
+              }
+          }
+          else
+          {
+              std::uint64_t steps[2] {}, sums[2] {};
+              std::size_t i = 1;
+              for (; i + 1 < count; i += 2)
+              {
+                  steps[1] += values[i];
+                  sums[1] += steps[1];
+                  values[i] = sums[1] * std::uint64_t(scale);
+                  steps[0] += values[i+1];
+                  sums[0] += steps[0];
+                  values[i+1] = sums[0] * std::uint64_t(scale);
+              }
+              if (i < count)
+              {
+                  steps[1] += values[i];
+                  sums[1] += steps[1];
+                  values[i] = sums[1] * std::uint64_t(scale);
+              }
+          }
+
+          if (small)
+          {
+              /* Converted by adding the value to the significand of 1.5 * 2^52, which is exact
+               * below 2^51 and, unlike a 64-bit integer conversion, vectorises without AVX-512.
+               */
+              const std::uint64_t bias = std::uint64_t(first) + std::bit_cast<std::uint64_t>(0x1.8p52);
+              for (std::size_t i = 0; i < count; ++i)
+              {
+                  out[i] = (std::bit_cast<double>(values[i] + bias) - 0x1.8p52) / unitsPerValue;
+              }
+          }
+          else
+          {
+              for (std::size_t i = 0; i < count; ++i)
+              {
+                  out[i] = static_cast<std::int64_t>(std::uint64_t(first) + values[i]) / unitsPerValue;
+              }
+          }
+      }
+  }
+
+  void CompressedTrack::append(const Fix & fix)
+  {
+      pending[latitudeColumn].push_back(std::llround(fix.position.latitude() * unitsPerDegree));
+      pending[longitudeColumn].push_back(std::llround(fix.position.longitude() * unitsPerDegree));
+      pending[elevationColumn].push_back(std::llround(fix.position.elevation() * centimetresPerMetre));
+      pending[timeColumn].push_back(std::llround(fix.time * millisecondsPerSecond));
+      if (pending[0].size() == chunkSize)
+      {
+          // The uncompressed columns keep their storage for the next chunk.
+          chunks.push_back(compress(pending));
+          for (std::vector<std::int64_t> & column : pending) column.clear();
+      }
+  }
+
+  void CompressedTrack::seal()
+  {
+      if (!pending[0].empty()) chunks.push_back(compress(pending));
+      for (std::vector<std::int64_t> & column : pending) std::vector<std::int64_t>().swap(column);
+  }
+
+  std::size_t CompressedTrack::size() const
+  {
+      std::size_t count = pending[0].size();
+      for (const Chunk & chunk : chunks) count += chunk.summary.count;
+      return count;
+  }
+
+  std::size_t CompressedTrack::bytesUsed() const
+  {
+      std::size_t bytes = sizeof(*this) + chunks.capacity() * sizeof(Chunk);
+      for (const Chunk & chunk : chunks) bytes += chunk.data.capacity();
+      for (const std::vector<std::int64_t> & column : pending) bytes += column.capacity() * sizeof(std::int64_t);
+      return bytes;
+  }
+
+  std::size_t CompressedTrack::chunkCount() const
+  {
+      return chunks.size() + (pending[0].empty() ? 0 : 1);
+  }
+
+  ChunkSummary CompressedTrack::summary(std::size_t chunk) const
+  {
+      return chunk < chunks.size() ? chunks[chunk].summary : summarise(pending);
+  }
+
+  void CompressedTrack::decode(const Chunk & compressed, degrees * latitudes, degrees * longitudes,
+                               metres * elevations, seconds * times)
+  {
+      double * const outputs[columnCount] = {latitudes, longitudes, elevations, times};
+      for (std::size_t c = 0; c < columnCount; ++c)
+      {
+          const Column & column = compressed.columns[c];
+          decodeColumn(compressed.data.data() + column.byteOffset, column.first, column.scale, column.stride,
+                       column.small, unitsPerValue[c], compressed.summary.count, outputs[c]);
+      }
+  }
+
+  void CompressedTrack::decode(const Columns & columns, degrees * latitudes, degrees * longitudes,
+                               metres * elevations, seconds * times)
+  {
+      double * const outputs[columnCount] = {latitudes, longitudes, elevations, times};
+      for (std::size_t c = 0; c < columnCount; ++c)
+      {
+          for (std::size_t i = 0; i < columns[c].size(); ++i) outputs[c][i] = columns[c][i] / unitsPerValue[c];
+      }
+  }
+
+  void CompressedTrack::decodeChunk(std::size_t chunk, std::vector<Fix> & fixes) const
+  {
+      std::array<degrees, chunkSize> latitudes, longitudes;
+      std::array<metres, chunkSize> elevations;
+      std::array<seconds, chunkSize> times;
+      std::size_t count;
+      if (chunk == chunks.size())
+      {
+          count = pending[0].size();
+          decode(pending, latitudes.data(), longitudes.data(), elevations.data(), times.data());
+      }
+      else
+      {
+          count = chunks[chunk].summary.count;
+          decode(chunks[chunk], latitudes.data(), longitudes.data(), elevations.data(), times.data());
+      }
+      fixes.reserve(fixes.size() + count);
+      for (std::size_t i = 0; i < count; ++i)
+      {
+          fixes.push_back({ Position(latitudes[i], longitudes[i], elevations[i]), times[i] });
+      }
+  }
+
+  void CompressedTrack::decodeChunkColumns(std::size_t chunk, FixColumns & columns) const
+  {
+      const std::size_t start = columns.size();
+      const std::size_t count = chunk == chunks.size() ? pending[0].size() : chunks[chunk].summary.count;
+      columns.latitudes.resize(start + count);
+      columns.longitudes.resize(start + count);
+      columns.elevations.resize(start + count);
+      columns.times.resize(start + count);
+
+      degrees * const latitudes = columns.latitudes.data() + start;
+      degrees * const longitudes = columns.longitudes.data() + start;
+      metres * const elevations = columns.elevations.data() + start;
+      seconds * const times = columns.times.data() + start;
+      if (chunk == chunks.size()) decode(pending, latitudes, longitudes, elevations, times);
+      else decode(chunks[chunk], latitudes, longitudes, elevations, times);
+  }
+
+  std::vector<Fix> CompressedTrack::fixes() const
+  {
+      std::vector<Fix> result;
+      result.reserve(size());
+      for (std::size_t chunk = 0; chunk < chunkCount(); ++chunk) decodeChunk(chunk, result);
+      return result;
+  }
+
+  FixColumns CompressedTrack::columns() const
+  {
+      FixColumns result;
+      const std::size_t count = size();
+      result.latitudes.reserve(count);
+      result.longitudes.reserve(count);
+      result.elevations.reserve(count);
+      result.times.reserve(count);
+      for (std::size_t chunk = 0; chunk < chunkCount(); ++chunk) decodeChunkColumns(chunk, result);
+      return result;
+  }
+
+  std::vector<Fix> CompressedTrack::fixesBetween(seconds from, seconds to) const
+  {
+      std::vector<Fix> result;
+      FixColumns decoded;
+      for (std::size_t chunk = 0; chunk < chunkCount(); ++chunk)
+      {
+          const ChunkSummary extent = summary(chunk);
+          if (extent.latest < from || extent.earliest > to) continue;
+          decoded.clear();
+          decodeChunkColumns(chunk, decoded);
+          for (std::size_t i = 0; i < decoded.size(); ++i)
+          {
+              if (decoded.times[i] >= from && decoded.times[i] <= to) result.push_back(decoded.fix(i));
+          }
+      }
+      return result;
+  }
+
+  std::vector<Fix> CompressedTrack::fixesWithin(const Position & southWest, const Position & northEast) const
+  {
+      auto inside = [&](degrees latitude, degrees longitude)
+      {
+          return latitude >= southWest.latitude() && latitude <= northEast.latitude()
+              && longitude >= southWest.longitude() && longitude <= northEast.longitude();
+      };
+      std::vector<Fix> result;
+      FixColumns decoded;
+      for (std::size_t chunk = 0; chunk < chunkCount(); ++chunk)
+      {
+          const ChunkSummary extent = summary(chunk);
+          if (extent.maxLatitude < southWest.latitude() || extent.minLatitude > northEast.latitude()
+           || extent.maxLongitude < southWest.longitude() || extent.minLongitude > northEast.longitude()) continue;
+          decoded.clear();
+          decodeChunkColumns(chunk, decoded);
+          for (std::size_t i = 0; i < decoded.size(); ++i)
+          {
+              if (inside(decoded.latitudes[i], decoded.longitudes[i])) result.push_back(decoded.fix(i));
+          }
+      }
+      return result;
+  }
+
+  ChunkSummary CompressedTrack::summarise(const Columns & columns)
+  {
+      ChunkSummary summary {};
+      summary.count = columns[0].size();
+      if (summary.count == 0) return summary;
+      auto extent = [&](std::size_t column, double unitsPerValue, double & min, double & max)
+      {
+          const auto [low, high] = std::minmax_element(columns[column].begin(), columns[column].end());
+          min = *low / unitsPerValue;
+          max = *high / unitsPerValue;
+      };
+      extent(latitudeColumn, unitsPerDegree, summary.minLatitude, summary.maxLatitude);
+      extent(longitudeColumn, unitsPerDegree, summary.minLongitude, summary.maxLongitude);
+      extent(elevationColumn, centimetresPerMetre, summary.minElevation, summary.maxElevation);
+      extent(timeColumn, millisecondsPerSecond, summary.earliest, summary.latest);
+      return summary;
+  }
+
+  CompressedTrack::Chunk CompressedTrack::compress(const Columns & columns)
+  {
+      Chunk chunk;
+      chunk.summary = summarise(columns);
+      std::vector<std::uint8_t> strideOne, strideTwo;
+      for (std::size_t c = 0; c < columnCount; ++c)
+      {
+          const std::vector<std::int64_t> & values = columns[c];
+          // Differences of 2^63 or more (only possible between absurd values) are not divided.
+          std::uint64_t divisor = 0;
+          for (std::int64_t value : values)
+          {
+              const std::uint64_t difference = value >= values[0] ? std::uint64_t(value) - std::uint64_t(values[0])
+                                                                  : std::uint64_t(values[0]) - std::uint64_t(value);
+              divisor = std::gcd(divisor, difference);
+          }
+          const std::int64_t scale = divisor == 0 || divisor >> 63 != 0 ? 1 : static_cast<std::int64_t>(divisor);
+
+          strideOne.clear();
+          strideTwo.clear();
+          encodeColumn(values, scale, 1, strideOne);
+          encodeColumn(values, scale, 2, strideTwo);
+          const bool two = strideTwo.size() < strideOne.size();
+          const bool small = std::all_of(values.begin(), values.end(), [](std::int64_t value)
+          {
+              return value > -smallLimit && value < smallLimit;
+          });
+          chunk.columns[c] = {values[0], scale, static_cast<std::uint32_t>(chunk.data.size()),
+                              static_cast<std::uint8_t>(two ? 2 : 1), small};
+          const std::vector<std::uint8_t> & encoded = two ? strideTwo : strideOne;
+          chunk.data.insert(chunk.data.end(), encoded.begin(), encoded.end());
+      }
+      // Padding for the unpackers' whole-word reads.
+      chunk.data.resize(chunk.data.size() + paddingBytes);
+      chunk.data.shrink_to_fit();
+      return chunk;
+  }
+}
@@ -0,0 +1,161 @@
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <thread>
+
+#include "earth.h"
+#include "densityGrid.h"
+
+namespace GPS
+{
+  namespace
+  {
+      // Splits [0,n) into 'parts' near-equal contiguous ranges, returning the start of range 'i'.
+      std::size_t shareStart(std::size_t n, unsigned parts, unsigned i)
+      {
+          return n / parts * i + std::min<std::size_t>(i, n % parts);
+      }
+
+      template <typename F>
+      void runOnThreads(unsigned threads, F && f)
+      {
+          std::vector<std::thread> workers;
+          for (unsigned i = 1; i < threads; ++i) workers.emplace_back(f, i);
+          f(0);
+          for (std::thread & worker : workers) worker.join();
+      }
+
+      void writeBigEndian16(std::ostream & out, unsigned value)
+      {
+          out.put(static_cast<char>(value >> 8));
+          out.put(static_cast<char>(value & 0xFF));
+      }
+  }
+
+  DensityGrid::DensityGrid(Position southWest, Position northEast, metres cellSize)
+    : south(southWest.latitude()),
+      west(southWest.longitude())
+  {
+      if (cellSize <= 0)
+          throw std::invalid_argument("Cell size must be positive.");
+      if (northEast.latitude() <= south || northEast.longitude() <= west)
+          throw std::invalid_argument("The north-east corner must lie north and east of the south-west corner.");
+
+      const degrees centreLatitude = (south + northEast.latitude()) / 2;
+      latitudePerCell = Earth::latitudeSubtendedBy(cellSize);
+      longitudePerCell = Earth::longitudeSubtendedBy(cellSize, centreLatitude);
+
+      cellsPerDegreeLatitude = 1 / latitudePerCell;
+      cellsPerDegreeLongitude = 1 / longitudePerCell;
+      rowCount = std::max<std::size_t>(1, std::ceil((northEast.latitude() - south) * cellsPerDegreeLatitude));
+      columnCount = std::max<std::size_t>(1, std::ceil((northEast.longitude() - west) * cellsPerDegreeLongitude));
+      counts.assign(rowCount * columnCount, 0);
+  }
+
+  std::size_t DensityGrid::rows() const
+  {
+      return rowCount;
+  }
+
+  std::size_t DensityGrid::columns() const
+  {
+      return columnCount;
+  }
+
+  std::size_t DensityGrid::cellIndex(degrees lat, degrees lon) const
+  {
+      const double row = (lat - south) * cellsPerDegreeLatitude;
+      const double column = (lon - west) * cellsPerDegreeLongitude;
+      // Points on the northern or eastern edge (row == rowCount) belong to the last row or column.
+      if (row < 0 || column < 0 || row > rowCount || column > columnCount) return counts.size();
+      const std::size_t r = std::min(static_cast<std::size_t>(row), rowCount - 1);
+      const std::size_t c = std::min(static_cast<std::size_t>(column), columnCount - 1);
+      return r * columnCount + c;
+  }
+
+  void DensityGrid::add(const Position & pos)
+  {
+      const std::size_t cell = cellIndex(pos.latitude(), pos.longitude());
+      if (cell == counts.size()) ++outsideCount;
+      else ++counts[cell];
+  }
+
+  void DensityGrid::add(const std::vector<Position> & positions, unsigned threads)
+  {
+      if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+      // Below this, a thread costs more to start (and its histogram more to merge) than it saves.
+      const std::size_t minimumShare = 1 << 16;
+      threads = static_cast<unsigned>(std::clamp<std::size_t>(positions.size() / minimumShare, 1, threads));
+
+      if (threads == 1)
+      {
+          for (const Position & pos : positions) add(pos);
+          return;
+      }
+
+      // Each histogram has a trailing slot for Positions outside the grid, so they need no special case.
+      std::vector<std::vector<Count>> histograms(threads);
+      runOnThreads(threads, [&](unsigned t)
+      {
+          std::vector<Count> & histogram = histograms[t];
+          histogram.assign(counts.size() + 1, 0);
+          const std::size_t end = shareStart(positions.size(), threads, t + 1);
+          for (std::size_t i = shareStart(positions.size(), threads, t); i < end; ++i)
+          {
+              ++histogram[cellIndex(positions[i].latitude(), positions[i].longitude())];
+          }
+      });
+
+      runOnThreads(threads, [&](unsigned t)
+      {
+          const std::size_t end = shareStart(counts.size(), threads, t + 1);
+          for (const std::vector<Count> & histogram : histograms)
+          {
+              for (std::size_t cell = shareStart(counts.size(), threads, t); cell < end; ++cell)
+              {
+                  counts[cell] += histogram[cell];
+              }
+          }
+      });
+
+      for (const std::vector<Count> & histogram : histograms) outsideCount += histogram.back();
+  }
+
+  DensityGrid::Count DensityGrid::count(std::size_t row, std::size_t column) const
+  {
+      if (row >= rowCount || column >= columnCount)
+          throw std::out_of_range("Cell is outside the grid.");
+      return counts[row * columnCount + column];
+  }
+
+  unsigned long long DensityGrid::total() const
+  {
+      unsigned long long sum = 0;
+      for (Count c : counts) sum += c;
+      return sum;
+  }
+
+  unsigned long long DensityGrid::outside() const
+  {
+      return outsideCount;
+  }
+
+  void DensityGrid::writePGM(std::ostream & out) const
+  {
+      const Count busiest = counts.empty() ? 0 : *std::max_element(counts.begin(), counts.end());
+      const bool wide = busiest > 255;
+      const unsigned maxValue = wide ? 65535 : std::max<Count>(busiest, 1);
+      const double scale = wide ? 65535.0 / busiest : 1.0;
+
+      out << "P5\n" << columnCount << ' ' << rowCount << '\n' << maxValue << '\n';
+      for (std::size_t r = rowCount; r-- > 0;)
+      {
+          const Count * row = &counts[r * columnCount];
+          for (std::size_t c = 0; c < columnCount; ++c)
+          {
+              if (wide) writeBigEndian16(out, static_cast<unsigned>(std::lround(row[c] * scale)));
+              else out.put(static_cast<char>(row[c]));
+          }
+      }
+  }
+}
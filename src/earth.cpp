@@ -7,27 +7,27 @@ namespace GPS
 {
   namespace Earth
   {
-      const Position NorthPole = Position(poleLatitude,0,0);
-      const Position EquatorialMeridian = Position(0,0,0);
-      const Position EquatorialAntiMeridian = Position(0,antiMeridianLongitude,0);
-      const Position CliftonCampus = Position(52.91249953,-1.18402513,58);
-      const Position CityCampus = Position(52.9581383,-1.1542364,53);
-      const Position Pontianak = Position(0,109.322134,0);
-
-      const metres meanRadius = 6371008.8;
-      const metres equatorialCircumference = 40075160;
-      const metres polarCircumference = 40008000;
-
-      degrees latitudeSubtendedBy(metres distance)
-      {
-          return (distance / polarCircumference) * fullRotation;
-      }
-
       degrees longitudeSubtendedBy(metres distance,degrees lat)
       {
           metres circumference = equatorialCircumference * std::cos(degToRad(lat));
           if (circumference == 0) return 0; // No longitude at poles.
           return (distance / circumference) * fullRotation;
       }
+
+      void toECEF(const degrees * lat, const degrees * lon, const metres * ele,
+                  metres * x, metres * y, metres * z, std::size_t n)
+      {
+          const double radiansPerDegree = pi / halfRotation;
+          for (std::size_t i = 0; i < n; ++i)
+          {
+              const radians phi = lat[i] * radiansPerDegree;
+              const radians lambda = lon[i] * radiansPerDegree;
+              const metres r = meanRadius + ele[i];
+              const double cosPhi = std::cos(phi);
+              x[i] = r * cosPhi * std::cos(lambda);
+              y[i] = r * cosPhi * std::sin(lambda);
+              z[i] = r * std::sin(phi);
+          }
+      }
   }
 }
@@ -0,0 +1,154 @@
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+#include "encodeNMEA.h"
+
+namespace NMEA
+{
+  namespace
+  {
+      const GPS::speed metresPerSecondPerKnot = 1852.0 / 3600;
+      const long long millisecondsPerDay = 24 * 60 * 60 * 1000;
+
+      // Writes 'value' as exactly 'digits' decimal digits (with leading zeros).
+      char * writeDigits(char * out, unsigned long long value, int digits)
+      {
+          for (int i = digits - 1; i >= 0; --i)
+          {
+              out[i] = static_cast<char>('0' + value % 10);
+              value /= 10;
+          }
+          return out + digits;
+      }
+
+      // Writes 'value' in decimal, with as many digits as it needs.
+      char * writeNumber(char * out, unsigned long long value)
+      {
+          char digits[20];
+          int n = 0;
+          do {
+              digits[n++] = static_cast<char>('0' + value % 10);
+              value /= 10;
+          } while (value != 0);
+          while (n > 0) *out++ = digits[--n];
+          return out;
+      }
+
+      // Writes 'value' to a fixed number of decimal places.
+      char * writeFixedPoint(char * out, double value, int decimals)
+      {
+          static const double scales[] = {1, 10, 100, 1000, 10000};
+          long long scaled = std::llround(value * scales[decimals]);
+          if (scaled < 0)
+          {
+              *out++ = '-';
+              scaled = -scaled;
+          }
+          const long long whole = scaled / static_cast<long long>(scales[decimals]);
+          out = writeNumber(out, whole);
+          *out++ = '.';
+          return writeDigits(out, scaled - whole * static_cast<long long>(scales[decimals]), decimals);
+      }
+
+      char * writeText(char * out, std::string_view text)
+      {
+          std::memcpy(out, text.data(), text.size());
+          return out + text.size();
+      }
+
+      // Writes "ddmm.mmmm,N" (or "dddmm.mmmm,E" for a longitude, with 'degreeDigits' 3).
+      char * writeDDM(char * out, GPS::degrees angle, int degreeDigits, char positive, char negative)
+      {
+          const unsigned long long tenThousandthsOfMinutes = std::llround(std::abs(angle) * 60 * 10000);
+          const unsigned long long degrees = tenThousandthsOfMinutes / 600000;
+          const unsigned long long remainder = tenThousandthsOfMinutes % 600000;
+          out = writeDigits(out, degrees, degreeDigits);
+          out = writeDigits(out, remainder / 10000, 2);
+          *out++ = '.';
+          out = writeDigits(out, remainder % 10000, 4);
+          *out++ = ',';
+          *out++ = angle < 0 ? negative : positive;
+          return out;
+      }
+
+      // Writes "hhmmss.sss".
+      char * writeTime(char * out, GPS::seconds time)
+      {
+          long long ms = std::llround(time * 1000) % millisecondsPerDay;
+          if (ms < 0) ms += millisecondsPerDay;
+          const long long secs = ms / 1000;
+          out = writeDigits(out, secs / 3600, 2);
+          out = writeDigits(out, secs / 60 % 60, 2);
+          out = writeDigits(out, secs % 60, 2);
+          *out++ = '.';
+          return writeDigits(out, ms % 1000, 3);
+      }
+
+      char * writeCoordinates(char * out, const GPS::Position & pos)
+      {
+          out = writeDDM(out, pos.latitude(), 2, 'N', 'S');
+          *out++ = ',';
+          return writeDDM(out, pos.longitude(), 3, 'E', 'W');
+      }
+  }
+
+  void writeChecksum(std::string_view body, char * digits)
+  {
+      static const char hex[] = "0123456789ABCDEF";
+      unsigned char sum = 0;
+      for (char c : body) sum ^= static_cast<unsigned char>(c);
+      digits[0] = hex[sum >> 4];
+      digits[1] = hex[sum & 0xF];
+  }
+
+  std::size_t encodeSentence(std::string_view format, const GPS::Fix & fix, GPS::speed groundSpeed, char * buffer)
+  {
+      char * out = buffer;
+      *out++ = '$';
+      if (format == "GLL")
+      {
+          out = writeText(out, "GPGLL,");
+          out = writeCoordinates(out, fix.position);
+          *out++ = ',';
+          out = writeTime(out, fix.time);
+      }
+      else if (format == "GGA")
+      {
+          out = writeText(out, "GPGGA,");
+          out = writeTime(out, fix.time);
+          *out++ = ',';
+          out = writeCoordinates(out, fix.position);
+          out = writeText(out, ",1,08,1.0,");
+          out = writeFixedPoint(out, fix.position.elevation(), 1);
+          out = writeText(out, ",M,0.0,M,,");
+      }
+      else if (format == "RMC")
+      {
+          out = writeText(out, "GPRMC,");
+          out = writeTime(out, fix.time);
+          out = writeText(out, ",A,");
+          out = writeCoordinates(out, fix.position);
+          *out++ = ',';
+          out = writeFixedPoint(out, groundSpeed / metresPerSecondPerKnot, 3);
+          out = writeText(out, ",0.00,,,A");
+      }
+      else
+      {
+          throw std::invalid_argument("Unsupported sentence format.");
+      }
+
+      writeChecksum(std::string_view(buffer + 1, out - buffer - 1), out + 1);
+      *out = '*';
+      out += 3;
+      *out++ = '\n';
+      return out - buffer;
+  }
+
+  std::string encodeSentence(std::string_view format, const GPS::Fix & fix, GPS::speed groundSpeed)
+  {
+      char buffer[maxEncodedSentenceLength];
+      const std::size_t length = encodeSentence(format, fix, groundSpeed, buffer);
+      return std::string(buffer, length - 1);
+  }
+}
@@ -0,0 +1,120 @@
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "geometry.h"
+#include "earth.h"
+#include "fixFilter.h"
+
+namespace GPS
+{
+  namespace
+  {
+      const seconds secondsPerDay = 24 * 60 * 60;
+
+      // Assumed standard deviation of the initial velocity, in metres per second.
+      const double initialVelocityError = 10;
+
+      constexpr double metresPerDegreeLat = Earth::polarCircumference / fullRotation;
+  }
+
+  seconds elapsedTime(seconds from, seconds to)
+  {
+      seconds elapsed = std::fmod(to - from, secondsPerDay);
+      if (elapsed < 0) elapsed += secondsPerDay;
+      return elapsed;
+  }
+
+  JumpFilter::JumpFilter(speed maxSpeed, unsigned resyncAfter)
+      : maxSpeed(maxSpeed), resyncAfter(resyncAfter)
+  {
+      if (!(maxSpeed > 0))
+          throw std::invalid_argument("Maximum speed must be positive.");
+  }
+
+  bool JumpFilter::accept(const Fix & fix)
+  {
+      if (reference && consecutiveRejects < resyncAfter)
+      {
+          const metres distance = Position::horizontalDistanceBetween(reference->position, fix.position);
+          const seconds elapsed = elapsedTime(reference->time, fix.time);
+          if (distance > maxSpeed * elapsed)
+          {
+              ++consecutiveRejects;
+              ++rejected;
+              return false;
+          }
+      }
+      reference = fix;
+      consecutiveRejects = 0;
+      return true;
+  }
+
+  unsigned long JumpFilter::rejectedCount() const
+  {
+      return rejected;
+  }
+
+  void KalmanSmoother::AxisState::predict(seconds dt, double accelerationVariance)
+  {
+      // x' = F x, P' = F P F^T + Q, with F = [1 dt; 0 1] and Q for white-noise acceleration.
+      position += velocity * dt;
+      const double dt2 = dt * dt;
+      varPos    += 2 * dt * covPosVel + dt2 * varVel + accelerationVariance * dt2 * dt2 / 4;
+      covPosVel += dt * varVel + accelerationVariance * dt2 * dt / 2;
+      varVel    += accelerationVariance * dt2;
+  }
+
+  void KalmanSmoother::AxisState::update(double measurement, double measurementVariance)
+  {
+      const double innovation = measurement - position;
+      const double innovationVariance = varPos + measurementVariance;
+      const double gainPos = varPos / innovationVariance;
+      const double gainVel = covPosVel / innovationVariance;
+
+      position += gainPos * innovation;
+      velocity += gainVel * innovation;
+
+      const double newVarPos = (1 - gainPos) * varPos;
+      const double newCovPosVel = (1 - gainPos) * covPosVel;
+      varVel -= gainVel * covPosVel;
+      varPos = newVarPos;
+      covPosVel = newCovPosVel;
+  }
+
+  KalmanSmoother::KalmanSmoother(double acceleration, metres measurementError)
+      : accelerationVariance(acceleration * acceleration),
+        measurementVariance(measurementError * measurementError)
+  {
+      if (!(acceleration > 0) || !(measurementError > 0))
+          throw std::invalid_argument("Kalman smoother noise parameters must be positive.");
+  }
+
+  Fix KalmanSmoother::smooth(const Fix & fix)
+  {
+      if (!origin)
+      {
+          origin = fix.position;
+          metresPerDegreeLon = Earth::equatorialCircumference * std::cos(degToRad(origin->latitude())) / fullRotation;
+          lastTime = fix.time;
+          east = AxisState{0, 0, measurementVariance, 0, initialVelocityError * initialVelocityError};
+          north = east;
+          return fix;
+      }
+
+      const double x = normaliseDeg(fix.position.longitude() - origin->longitude()) * metresPerDegreeLon;
+      const double y = (fix.position.latitude() - origin->latitude()) * metresPerDegreeLat;
+      const seconds dt = elapsedTime(lastTime, fix.time);
+      lastTime = fix.time;
+
+      east.predict(dt, accelerationVariance);
+      north.predict(dt, accelerationVariance);
+      east.update(x, measurementVariance);
+      north.update(y, measurementVariance);
+
+      const degrees lat = origin->latitude() + north.position / metresPerDegreeLat;
+      const degrees lon = metresPerDegreeLon > 0 ? normaliseDeg(origin->longitude() + east.position / metresPerDegreeLon)
+                                                 : fix.position.longitude();
+      return Fix{Position(std::max(-poleLatitude, std::min(poleLatitude, lat)), lon, fix.position.elevation()), fix.time};
+  }
+}
@@ -0,0 +1,78 @@
+#include <stdexcept>
+#include <string_view>
+
+#include "fixRuns.h"
+
+namespace NMEA
+{
+  RunLengthDeduplicator::RunLengthDeduplicator(GPS::metres epsilon)
+      : epsilon(epsilon)
+  {
+      if (epsilon < 0){
+          throw std::invalid_argument("Deduplication distance must not be negative.");
+      }
+  }
+
+  std::optional<FixRun> RunLengthDeduplicator::add(const LazySentence & sentence)
+  {
+      try {
+          const std::string_view coordinates = sentence.coordinateText();
+          if (current && coordinates == currentCoordinates){
+              /* The run's first sentence has already interpreted this text, so only the
+               * fields that can still be invalid are checked, as fixesFromLog() would.
+               */
+              const GPS::seconds time = sentence.time();
+              sentence.elevation();
+              current->lastTime = time;
+              ++current->count;
+              return std::nullopt;
+          }
+
+          // Interpreted as by fixesFromLog(), so that runs hold only the Fixes it returns.
+          const GPS::Position & position = sentence.position();
+          const GPS::seconds time = sentence.time();
+          if (current && epsilon > 0
+              && GPS::Position::horizontalDistanceBetween(current->position, position) <= epsilon){
+              current->lastTime = time;
+              ++current->count;
+              return std::nullopt;
+          }
+
+          FixRun next{position, time, time, 1};
+          std::optional<FixRun> completed = std::move(current);
+          current = next;
+          currentCoordinates.assign(coordinates);
+          return completed;
+      }
+      catch (const std::invalid_argument &) {
+          //Sentences with invalid data are ignored, as in fixesFromLog()
+          return std::nullopt;
+      }
+  }
+
+  std::optional<FixRun> RunLengthDeduplicator::finish()
+  {
+      std::optional<FixRun> completed = std::move(current);
+      current.reset();
+      currentCoordinates.clear();
+      return completed;
+  }
+
+  std::vector<FixRun> fixRunsFromLog(std::istream & log, GPS::metres epsilon)
+  {
+      RunLengthDeduplicator deduplicator(epsilon);
+      std::vector<FixRun> vec;
+      std::string data;
+      while (log >> data){
+          if (const std::optional<LazySentence> sentence = LazySentence::fromLine(data)){
+              if (std::optional<FixRun> run = deduplicator.add(*sentence)){
+                  vec.push_back(*run);
+              }
+          }
+      }
+      if (std::optional<FixRun> run = deduplicator.finish()){
+          vec.push_back(*run);
+      }
+      return vec;
+  }
+}
@@ -0,0 +1,162 @@
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+#include "geometry.h"
+#include "fixedPosition.h"
+
+namespace GPS
+{
+  namespace
+  {
+      /* A non-negative decimal number, held as value / scale, where scale is a power of 10.
+       * At most 9 digits are kept either side of the point; further fractional digits
+       * (finer than 1e-9) are ignored.
+       */
+      struct Decimal
+      {
+          std::int64_t value = 0;
+          std::int64_t scale = 1;
+      };
+
+      Decimal parseDecimal(std::string_view str)
+      {
+          if (str.empty())
+              throw std::invalid_argument("Empty numeric field.");
+
+          Decimal result;
+          bool seenPoint = false;
+          bool seenDigit = false;
+          unsigned integerDigits = 0;
+          for (char c : str)
+          {
+              if (c == '.' && !seenPoint)
+              {
+                  seenPoint = true;
+              }
+              else if (c >= '0' && c <= '9')
+              {
+                  seenDigit = true;
+                  if (!seenPoint)
+                  {
+                      if (++integerDigits > 9)
+                          throw std::invalid_argument(std::string(str) + " is out of range.");
+                      result.value = result.value * 10 + (c - '0');
+                  }
+                  else if (result.scale < 1000000000)
+                  {
+                      result.value = result.value * 10 + (c - '0');
+                      result.scale *= 10;
+                  }
+              }
+              else
+              {
+                  throw std::invalid_argument(std::string(str) + " is not a decimal number.");
+              }
+          }
+          if (!seenDigit)
+              throw std::invalid_argument(std::string(str) + " is not a decimal number.");
+          return result;
+      }
+
+      // Rounds numerator/denominator to the nearest integer (both non-negative).
+      std::int64_t roundedDivide(std::int64_t numerator, std::int64_t denominator)
+      {
+          return (numerator + denominator / 2) / denominator;
+      }
+
+      // Converts a positive DDM string to units of 1e-7 degrees.
+      std::int64_t ddmToUnits(std::string_view ddmStr)
+      {
+          const Decimal ddm = parseDecimal(ddmStr);
+          const std::int64_t wholeMinutes = ddm.value / ddm.scale;            // DDDMM
+          const std::int64_t degs = wholeMinutes / 100;
+          const std::int64_t scaledMins = ddm.value - degs * 100 * ddm.scale; // MM.mmmm * scale
+
+          return degs * FixedPosition::unitsPerDegree
+               + roundedDivide(scaledMins * FixedPosition::unitsPerDegree, 60 * ddm.scale);
+      }
+
+      std::int64_t metresToCentimetres(std::string_view eleStr)
+      {
+          const bool negative = !eleStr.empty() && eleStr.front() == '-';
+          if (negative) eleStr.remove_prefix(1);
+
+          const Decimal ele = parseDecimal(eleStr);
+          const std::int64_t wholeMetres = ele.value / ele.scale;
+          const std::int64_t fraction = ele.value % ele.scale;
+          const std::int64_t cm = wholeMetres * FixedPosition::centimetresPerMetre
+                                + roundedDivide(fraction * FixedPosition::centimetresPerMetre, ele.scale);
+          return negative ? -cm : cm;
+      }
+
+      // Applies a N/S or E/W bearing to a positive angle.
+      std::int64_t withBearing(std::int64_t angle, char bearing, char positive, char negative, const std::string & name)
+      {
+          if (bearing == positive) return angle;
+          if (bearing == negative) return -angle;
+          throw std::invalid_argument(bearing + std::string(" is an invalid " + name + " bearing character in DDM format.  Only '")
+                                      + positive + "' or '" + negative + "' accepted.");
+      }
+
+      FixedPosition::units toUnits(std::int64_t value)
+      {
+          if (value < INT32_MIN || value > INT32_MAX)
+              throw std::invalid_argument("Value cannot be represented in a FixedPosition.");
+          return static_cast<FixedPosition::units>(value);
+      }
+
+      FixedPosition::units checkedUnits(double value)
+      {
+          const double rounded = std::round(value);
+          if (!(std::abs(rounded) <= INT32_MAX))
+              throw std::invalid_argument("Value cannot be represented in a FixedPosition.");
+          return static_cast<FixedPosition::units>(rounded);
+      }
+  }
+
+  FixedPosition::FixedPosition(units latUnits, units lonUnits, units eleCentimetres)
+      : lat(latUnits), lon(lonUnits), ele(eleCentimetres)
+  {
+      if (std::abs(static_cast<std::int64_t>(lat)) > static_cast<std::int64_t>(poleLatitude) * unitsPerDegree)
+          throw std::invalid_argument("Latitude values must not exceed " + std::to_string(poleLatitude) + " degrees.");
+
+      if (std::abs(static_cast<std::int64_t>(lon)) > static_cast<std::int64_t>(antiMeridianLongitude) * unitsPerDegree)
+          throw std::invalid_argument("Longitude values must not exceed " + std::to_string(antiMeridianLongitude) + " degrees.");
+  }
+
+  FixedPosition::FixedPosition(const Position & pos)
+      : FixedPosition(checkedUnits(pos.latitude() * unitsPerDegree),
+                      checkedUnits(pos.longitude() * unitsPerDegree),
+                      checkedUnits(pos.elevation() * centimetresPerMetre))
+  {}
+
+  FixedPosition::FixedPosition(std::string_view ddmLatStr, char northing,
+                               std::string_view ddmLonStr, char easting,
+                               std::string_view eleStr)
+      : FixedPosition(toUnits(withBearing(ddmToUnits(ddmLatStr), northing, 'N', 'S', "North/South")),
+                      toUnits(withBearing(ddmToUnits(ddmLonStr), easting,  'E', 'W', "East/West")),
+                      toUnits(metresToCentimetres(eleStr)))
+  {}
+
+  degrees FixedPosition::latitude() const
+  {
+      return static_cast<degrees>(lat) / unitsPerDegree;
+  }
+
+  degrees FixedPosition::longitude() const
+  {
+      return static_cast<degrees>(lon) / unitsPerDegree;
+  }
+
+  metres FixedPosition::elevation() const
+  {
+      return static_cast<metres>(ele) / centimetresPerMetre;
+  }
+
+  Position FixedPosition::toPosition() const
+  {
+      return Position(latitude(), longitude(), elevation());
+  }
+}
@@ -0,0 +1,283 @@
+#include <cmath>
+#include <limits>
+
+#include "geometry.h"
+#include "geodesic.h"
+
+/*
+ * See: T. Vincenty, "Direct and inverse solutions of geodesics on the ellipsoid with
+ *      application of nested equations", Survey Review 23(176), 1975.
+ */
+
+namespace GPS
+{
+  namespace
+  {
+      // A latitude on the auxiliary sphere.
+      struct ReducedLatitude
+      {
+          double sinU, cosU;
+      };
+
+      ReducedLatitude reduce(degrees lat, const Ellipsoid & e)
+      {
+          const double sinPhi = std::sin(degToRad(lat)) * (1 - e.f);
+          const double cosPhi = std::cos(degToRad(lat));
+          const double norm = pythagoras(sinPhi, cosPhi);
+          return { sinPhi / norm, cosPhi / norm };
+      }
+
+      // The auxiliary-sphere quantities for a given longitude difference 'lambda'.
+      struct Evaluation
+      {
+          double sinLambda, cosLambda;
+          double sinSigma, cosSigma, sigma;
+          double sinAlpha, cosSqrAlpha, cos2SigmaM;
+      };
+
+      Evaluation evaluate(radians lambda, ReducedLatitude p1, ReducedLatitude p2)
+      {
+          Evaluation ev;
+          ev.sinLambda = std::sin(lambda);
+          ev.cosLambda = std::cos(lambda);
+          ev.sinSigma = pythagoras(p2.cosU * ev.sinLambda,
+                                   p1.cosU * p2.sinU - p1.sinU * p2.cosU * ev.cosLambda);
+          ev.cosSigma = p1.sinU * p2.sinU + p1.cosU * p2.cosU * ev.cosLambda;
+          ev.sigma = std::atan2(ev.sinSigma, ev.cosSigma);
+
+          // sinSigma is zero for coincident Positions, and for antipodal ones joined by a meridian.
+          ev.sinAlpha = (ev.sinSigma == 0) ? 0 : p1.cosU * p2.cosU * ev.sinLambda / ev.sinSigma;
+          ev.cosSqrAlpha = 1 - ev.sinAlpha * ev.sinAlpha;
+
+          // cosSqrAlpha is zero for equatorial lines.
+          ev.cos2SigmaM = (ev.cosSqrAlpha == 0) ? 0 : ev.cosSigma - 2 * p1.sinU * p2.sinU / ev.cosSqrAlpha;
+          return ev;
+      }
+
+      // The difference between the longitude on the auxiliary sphere and on the ellipsoid.
+      radians lambdaExcess(const Evaluation & ev, const Ellipsoid & e)
+      {
+          const double C = e.f / 16 * ev.cosSqrAlpha * (4 + e.f * (4 - 3 * ev.cosSqrAlpha));
+          return (1 - C) * e.f * ev.sinAlpha
+                 * (ev.sigma + C * ev.sinSigma
+                    * (ev.cos2SigmaM + C * ev.cosSigma * (-1 + 2 * ev.cos2SigmaM * ev.cos2SigmaM)));
+      }
+
+      metres distanceOf(const Evaluation & ev, const Ellipsoid & e)
+      {
+          const double uSqr = ev.cosSqrAlpha * e.secondEccentricitySqr;
+          const double A = 1 + uSqr / 16384 * (4096 + uSqr * (-768 + uSqr * (320 - 175 * uSqr)));
+          const double B = uSqr / 1024 * (256 + uSqr * (-128 + uSqr * (74 - 47 * uSqr)));
+          const double c2 = ev.cos2SigmaM * ev.cos2SigmaM;
+          const double deltaSigma =
+              B * ev.sinSigma * (ev.cos2SigmaM + B / 4 * (ev.cosSigma * (-1 + 2 * c2)
+                                 - B / 6 * ev.cos2SigmaM * (-3 + 4 * ev.sinSigma * ev.sinSigma) * (-3 + 4 * c2)));
+          return e.b * A * (ev.sigma - deltaSigma);
+      }
+
+      // A geodesic found by solve(): its auxiliary-sphere quantities and its length.
+      struct Solution
+      {
+          Evaluation ev;
+          metres distance;
+          bool hasAzimuths; // when found by azimuth rather than by lambda
+          radians alpha1, alpha2;
+      };
+
+      /* Bisects a bracketed root of 'residual' in [lo,hi], where 'rLo' = residual(lo).
+       * The returned point is within 'tolerance' of a sign change.
+       */
+      template <typename Residual>
+      radians bisect(Residual residual, radians lo, radians hi, double rLo, double tolerance)
+      {
+          const bool loNegative = rLo < 0;
+          while (hi - lo > tolerance)
+          {
+              const radians mid = (lo + hi) / 2;
+              ((residual(mid) < 0) == loNegative ? lo : hi) = mid;
+          }
+          return (lo + hi) / 2;
+      }
+
+      /* Calls 'onRoot' with each root of 'residual' found by sampling [lo,hi] for sign changes.
+       * NaN residuals (undefined parameter values) never bracket a root, and sign changes that
+       * bisect to a discontinuity (such as lambda wrapping round) are discarded.
+       */
+      template <typename Residual, typename OnRoot>
+      void forEachRoot(Residual residual, radians lo, radians hi, double tolerance, OnRoot onRoot)
+      {
+          const unsigned int samples = 32;
+          radians x0 = lo;
+          double r0 = residual(x0);
+          if (r0 == 0) onRoot(x0);
+          for (unsigned int i = 1; i <= samples; ++i)
+          {
+              const radians x1 = lo + (hi - lo) * i / samples;
+              const double r1 = residual(x1);
+              if (r1 == 0) onRoot(x1);
+              else if ((r0 < 0 && r1 > 0) || (r0 > 0 && r1 < 0))
+              {
+                  const radians root = bisect(residual, x0, x1, r0, tolerance);
+                  if (std::abs(residual(root)) < 1e-9) onRoot(root);
+              }
+              x0 = x1;
+              r0 = r1;
+          }
+      }
+
+      /* Follows the geodesic leaving p1 at azimuth 'alpha1' to where it next crosses p2's
+       * latitude about half-way round the Earth, setting 'ev', 'lambda' and the final azimuth.
+       * Returns false if the geodesic never reaches p2's latitude.
+       */
+      bool followAzimuth(radians alpha1, ReducedLatitude p1, ReducedLatitude p2,
+                         Evaluation & ev, radians & lambda, radians & alpha2)
+      {
+          const double sinAlpha0 = p1.cosU * std::sin(alpha1); // Clairaut's constant
+          const double cosAlpha0 = std::sqrt(1 - sinAlpha0 * sinAlpha0);
+          if (std::abs(p2.sinU) > cosAlpha0) return false;
+
+          // Arc lengths and longitudes on the auxiliary sphere, measured from the northward node.
+          const radians sigma1 = std::atan2(p1.sinU, p1.cosU * std::cos(alpha1));
+          const radians s = (cosAlpha0 == 0) ? 0 : std::asin(p2.sinU / cosAlpha0);
+          const radians halfWay = sigma1 + pi;
+          radians sigma2 = s + 2 * pi * std::round((halfWay - s) / (2 * pi));
+          const radians other = (pi - s) + 2 * pi * std::round((halfWay - (pi - s)) / (2 * pi));
+          if (std::abs(other - halfWay) < std::abs(sigma2 - halfWay)) sigma2 = other;
+
+          const radians omega1 = std::atan2(sinAlpha0 * std::sin(sigma1), std::cos(sigma1));
+          const radians omega2 = std::atan2(sinAlpha0 * std::sin(sigma2), std::cos(sigma2));
+          lambda = std::fmod(omega2 - omega1, 2 * pi);
+          if (lambda < 0) lambda += 2 * pi;
+
+          ev.sinLambda = std::sin(lambda);
+          ev.cosLambda = std::cos(lambda);
+          ev.sigma = sigma2 - sigma1;
+          ev.sinSigma = std::sin(ev.sigma);
+          ev.cosSigma = std::cos(ev.sigma);
+          ev.sinAlpha = sinAlpha0;
+          ev.cosSqrAlpha = cosAlpha0 * cosAlpha0;
+          ev.cos2SigmaM = std::cos(sigma1 + sigma2);
+          alpha2 = std::atan2(sinAlpha0, cosAlpha0 * std::cos(sigma2));
+          return true;
+      }
+
+      /* Solves lambda = L + lambdaExcess(lambda), for 0 <= L <= pi.
+       *
+       * The fixed-point iteration converges in a handful of steps except near antipodes.
+       * If it fails, the residual (which is <= 0 at lambda = L and pi - L >= 0 at lambda = pi)
+       * is bracketed and bisected instead, taking the shortest geodesic if there are several.
+       *
+       * Near antipodes lambda may also be stuck at pi while the azimuth varies (as for the
+       * meridian joining antipodes on the Equator), so there the geodesic is also solved for
+       * by its initial azimuth, and the shortest of all candidates taken.
+       */
+      Solution solve(radians L, ReducedLatitude p1, ReducedLatitude p2, const Ellipsoid & e)
+      {
+          const double tolerance = 1e-12;
+          const unsigned int maxIterations = 20;
+
+          Solution best { Evaluation{}, std::numeric_limits<metres>::infinity(), false, 0, 0 };
+          auto consider = [&](const Evaluation & ev, bool hasAzimuths, radians alpha1, radians alpha2)
+          {
+              const metres d = distanceOf(ev, e);
+              if (d < best.distance) best = { ev, d, hasAzimuths, alpha1, alpha2 };
+          };
+
+          bool converged = false;
+          radians lambda = L;
+          for (unsigned int i = 0; i < maxIterations; ++i)
+          {
+              const Evaluation ev = evaluate(lambda, p1, p2);
+              const radians next = L + lambdaExcess(ev, e);
+              if (std::abs(next - lambda) < tolerance)
+              {
+                  consider(evaluate(next, p1, p2), false, 0, 0);
+                  converged = true;
+                  break;
+              }
+              if (next > pi) break;
+              lambda = next;
+          }
+
+          const bool nearAntipodal = L > pi * (1 - 4 * e.f);
+          if (converged && !nearAntipodal) return best;
+
+          if (!converged)
+          {
+              auto residual = [&](radians l) { return l - L - lambdaExcess(evaluate(l, p1, p2), e); };
+              forEachRoot(residual, L, pi, tolerance, [&](radians l)
+              {
+                  consider(evaluate(l, p1, p2), false, 0, 0);
+              });
+          }
+
+          if (nearAntipodal)
+          {
+              Evaluation ev;
+              radians lambda, alpha2;
+              auto residual = [&](radians alpha1)
+              {
+                  if (!followAzimuth(alpha1, p1, p2, ev, lambda, alpha2)) return std::numeric_limits<double>::quiet_NaN();
+                  return lambda - lambdaExcess(ev, e) - L;
+              };
+              forEachRoot(residual, 0, pi, tolerance, [&](radians alpha1)
+              {
+                  if (followAzimuth(alpha1, p1, p2, ev, lambda, alpha2)) consider(ev, true, alpha1, alpha2);
+              });
+          }
+          return best;
+      }
+
+      radians longitudeDifference(const Position & p1, const Position & p2)
+      {
+          return degToRad(normaliseDeg(p2.longitude() - p1.longitude()));
+      }
+
+      metres distance(radians L, ReducedLatitude p1, ReducedLatitude p2, const Ellipsoid & e)
+      {
+          return solve(std::abs(L), p1, p2, e).distance;
+      }
+  }
+
+  Geodesic geodesicBetween(const Position & pos1, const Position & pos2, const Ellipsoid & e)
+  {
+      const ReducedLatitude p1 = reduce(pos1.latitude(), e);
+      const ReducedLatitude p2 = reduce(pos2.latitude(), e);
+      const radians L = longitudeDifference(pos1, pos2);
+
+      // Solved for an eastward longitude difference, and mirrored for a westward one.
+      const Solution solution = solve(std::abs(L), p1, p2, e);
+      const Evaluation & ev = solution.ev;
+      const double sign = (L < 0) ? -1 : 1;
+
+      radians alpha1 = solution.alpha1, alpha2 = solution.alpha2;
+      if (!solution.hasAzimuths)
+      {
+          alpha1 = std::atan2(p2.cosU * ev.sinLambda,
+                              p1.cosU * p2.sinU - p1.sinU * p2.cosU * ev.cosLambda);
+          alpha2 = std::atan2(p1.cosU * ev.sinLambda,
+                              -p1.sinU * p2.cosU + p1.cosU * p2.sinU * ev.cosLambda);
+      }
+
+      return { solution.distance, sign * radToDeg(alpha1), sign * radToDeg(alpha2) };
+  }
+
+  metres geodesicDistanceBetween(const Position & pos1, const Position & pos2, const Ellipsoid & e)
+  {
+      return distance(longitudeDifference(pos1, pos2),
+                      reduce(pos1.latitude(), e), reduce(pos2.latitude(), e), e);
+  }
+
+  void geodesicLegDistances(const Position * track, std::size_t n, metres * legs, const Ellipsoid & e)
+  {
+      if (n < 2) return;
+
+      ReducedLatitude previous = reduce(track[0].latitude(), e);
+      for (std::size_t i = 1; i < n; ++i)
+      {
+          const ReducedLatitude current = reduce(track[i].latitude(), e);
+          legs[i-1] = distance(longitudeDifference(track[i-1], track[i]), previous, current, e);
+          previous = current;
+      }
+  }
+}
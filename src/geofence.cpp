@@ -0,0 +1,201 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+
+#include "geometry.h"
+#include "earth.h"
+#include "geofence.h"
+
+namespace GPS
+{
+  bool GeofenceSet::BoundingBox::contains(degrees lat, degrees lon) const
+  {
+      return lat >= minLat && lat <= maxLat && lon >= minLon && lon <= maxLon;
+  }
+
+  GeofenceSet::GeofenceSet(degrees cellSize) : cellSize(cellSize)
+  {
+      if (!(cellSize > 0))
+          throw std::invalid_argument("Geofence grid cell size must be positive.");
+  }
+
+  GeofenceSet::FenceId GeofenceSet::addCircle(Position centre, metres radius)
+  {
+      if (!(radius > 0))
+          throw std::invalid_argument("Geofence radius must be positive.");
+
+      // Spans on the same sphere as horizontalDistanceBetween(), so no member is left out.
+      const degrees latSpan = Earth::angleSubtendedBy(radius);
+      BoundingBox bounds;
+      bounds.minLat = std::max(centre.latitude() - latSpan, -poleLatitude);
+      bounds.maxLat = std::min(centre.latitude() + latSpan, poleLatitude);
+
+      // The longitude span is widest at the latitude nearest the pole.
+      const degrees extremeLat = std::max(std::abs(bounds.minLat), std::abs(bounds.maxLat));
+      const degrees lonSpan = latSpan / std::cos(degToRad(extremeLat));
+      if (extremeLat >= poleLatitude
+          || centre.longitude() - lonSpan < -antiMeridianLongitude
+          || centre.longitude() + lonSpan > antiMeridianLongitude)
+      {
+          // Covers a pole or crosses the anti-meridian: take all longitudes.
+          bounds.minLon = -antiMeridianLongitude;
+          bounds.maxLon = antiMeridianLongitude;
+      }
+      else
+      {
+          bounds.minLon = centre.longitude() - lonSpan;
+          bounds.maxLon = centre.longitude() + lonSpan;
+      }
+
+      fences.push_back({bounds, centre, radius, {}});
+      index(fences.size() - 1);
+      return fences.size() - 1;
+  }
+
+  GeofenceSet::FenceId GeofenceSet::addPolygon(std::vector<Position> vertices)
+  {
+      if (vertices.size() < 3)
+          throw std::invalid_argument("A geofence polygon must have at least three vertices.");
+
+      BoundingBox bounds {vertices[0].latitude(), vertices[0].latitude(),
+                          vertices[0].longitude(), vertices[0].longitude()};
+      for (const Position & vertex : vertices)
+      {
+          bounds.minLat = std::min(bounds.minLat, vertex.latitude());
+          bounds.maxLat = std::max(bounds.maxLat, vertex.latitude());
+          bounds.minLon = std::min(bounds.minLon, vertex.longitude());
+          bounds.maxLon = std::max(bounds.maxLon, vertex.longitude());
+      }
+
+      const Position centre = vertices[0];
+      fences.push_back({bounds, centre, 0, std::move(vertices)});
+      index(fences.size() - 1);
+      return fences.size() - 1;
+  }
+
+  std::size_t GeofenceSet::size() const
+  {
+      return fences.size();
+  }
+
+  bool GeofenceSet::contains(FenceId id, Position pos) const
+  {
+      const Fence & fence = fences.at(id);
+      const degrees lat = pos.latitude();
+      const degrees lon = pos.longitude();
+      if (!fence.bounds.contains(lat, lon)) return false;
+
+      if (fence.radius > 0)
+      {
+          return Position::horizontalDistanceBetween(fence.centre, pos) <= fence.radius;
+      }
+
+      // Ray casting: count the edges crossed by a ray heading east from the Position.
+      const std::vector<Position> & v = fence.vertices;
+      bool inside = false;
+      for (std::size_t i = 0, j = v.size() - 1; i < v.size(); j = i++)
+      {
+          const degrees latI = v[i].latitude(), lonI = v[i].longitude();
+          const degrees latJ = v[j].latitude(), lonJ = v[j].longitude();
+          if ((latI > lat) != (latJ > lat))
+          {
+              const degrees crossingLon = lonI + (lat - latI) * (lonJ - lonI) / (latJ - latI);
+              if (lon == crossingLon) return true; // on the boundary
+              if (lon < crossingLon) inside = !inside;
+          }
+      }
+      return inside;
+  }
+
+  void GeofenceSet::fencesContaining(Position pos, std::vector<FenceId> & result) const
+  {
+      result.clear();
+
+      const auto cell = grid.find(cellKey(cellIndex(pos.latitude()), cellIndex(pos.longitude())));
+      if (cell != grid.end())
+      {
+          for (FenceId id : cell->second)
+          {
+              if (contains(id, pos)) result.push_back(id);
+          }
+      }
+
+      if (!largeFences.empty())
+      {
+          const std::size_t gridMatches = result.size();
+          for (FenceId id : largeFences)
+          {
+              if (contains(id, pos)) result.push_back(id);
+          }
+          std::inplace_merge(result.begin(), result.begin() + gridMatches, result.end());
+      }
+  }
+
+  GeofenceSet::CellKey GeofenceSet::cellKey(long row, long col) const
+  {
+      return (static_cast<CellKey>(row) << 32) ^ static_cast<std::uint32_t>(col);
+  }
+
+  long GeofenceSet::cellIndex(degrees angle) const
+  {
+      return static_cast<long>(std::floor(angle / cellSize));
+  }
+
+  void GeofenceSet::index(FenceId id)
+  {
+      const BoundingBox & bounds = fences[id].bounds;
+      const long minRow = cellIndex(bounds.minLat), maxRow = cellIndex(bounds.maxLat);
+      const long minCol = cellIndex(bounds.minLon), maxCol = cellIndex(bounds.maxLon);
+
+      if ((maxRow - minRow + 1) * (maxCol - minCol + 1) > maxCellsPerFence)
+      {
+          largeFences.push_back(id);
+          return;
+      }
+      for (long row = minRow; row <= maxRow; ++row)
+      {
+          for (long col = minCol; col <= maxCol; ++col)
+          {
+              grid[cellKey(row, col)].push_back(id);
+          }
+      }
+  }
+
+  GeofenceMonitor::GeofenceMonitor(const GeofenceSet & fences) : fences(fences) {}
+
+  void GeofenceMonitor::update(Position pos, std::vector<GeofenceEvent> & events)
+  {
+      fences.fencesContaining(pos, current);
+
+      // Both lists are sorted, so the changes are found by a single merge-like pass.
+      std::size_t i = 0, j = 0;
+      const std::size_t firstEnter = events.size();
+      while (i < inside.size() || j < current.size())
+      {
+          if (j == current.size() || (i < inside.size() && inside[i] < current[j]))
+          {
+              events.push_back({GeofenceEvent::Type::Exit, inside[i++]});
+          }
+          else if (i == inside.size() || current[j] < inside[i])
+          {
+              events.push_back({GeofenceEvent::Type::Enter, current[j++]});
+          }
+          else
+          {
+              ++i;
+              ++j;
+          }
+      }
+      // Exits before enters.
+      std::stable_partition(events.begin() + firstEnter, events.end(),
+                            [](const GeofenceEvent & e){ return e.type == GeofenceEvent::Type::Exit; });
+
+      std::swap(inside, current);
+  }
+
+  const std::vector<GeofenceSet::FenceId> & GeofenceMonitor::insideFences() const
+  {
+      return inside;
+  }
+}
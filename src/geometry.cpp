@@ -4,43 +4,45 @@
 
 namespace GPS
 {
-  const double pi = 3.141592653589793;
-  const degrees fullRotation = 360;
-  const degrees halfRotation = fullRotation/2;
-  const degrees poleLatitude = fullRotation/4;
-  const degrees antiMeridianLongitude = fullRotation/2;
-
-  double pythagoras(double x, double y)
-  {
-      return std::sqrt(x*x + y*y);
-  }
-
-  double pythagoras(double x, double y, double z)
-  {
-      return std::sqrt(x*x + y*y + z*z);
-  }
-
-  radians degToRad(degrees d)
+  namespace
   {
-      return d * pi / halfRotation;
+      /* std::ceil(), written so that the compiler can vectorise it without SSE4.1: adding
+       * and subtracting 1.5 * 2^52 rounds to a whole number, for magnitudes below 2^51.
+       * Infinities and NaNs are returned unchanged.
+       */
+      inline double ceiling(double x)
+      {
+          const double rounded = (x + 0x1.8p52) - 0x1.8p52;
+          return rounded + (rounded < x ? 1.0 : 0.0);
+      }
   }
 
-  degrees radToDeg(radians r)
+  void degToRad(const degrees * in, radians * out, std::size_t n)
   {
-      return r * halfRotation / pi;
+      #pragma GCC ivdep // 'out' is either 'in' or disjoint from it
+      for (std::size_t i = 0; i < n; ++i)
+      {
+          out[i] = in[i] * pi / halfRotation; // as the scalar degToRad(), to the last bit
+      }
   }
 
-  double sinSqr(radians x)
+  void radToDeg(const radians * in, degrees * out, std::size_t n)
   {
-      const double sx = std::sin(x);
-      return sx * sx;
+      #pragma GCC ivdep
+      for (std::size_t i = 0; i < n; ++i)
+      {
+          out[i] = in[i] * halfRotation / pi;
+      }
   }
 
-  degrees normaliseDeg(degrees d)
+  void normaliseDeg(const degrees * in, degrees * out, std::size_t n)
   {
-      d = fmod(d,fullRotation); // results in range (-360,360)
-      if (d <= -halfRotation) d += fullRotation; // results in range (-180,360)
-      if (d > halfRotation) d -= fullRotation; // results in range (-180,180]
-      return d;
+      #pragma GCC ivdep
+      for (std::size_t i = 0; i < n; ++i)
+      {
+          // Subtract the whole number of turns that brings the angle into (-180,180].
+          const double turns = (in[i] - halfRotation) / fullRotation;
+          out[i] = in[i] - ceiling(turns) * fullRotation;
+      }
   }
 }
@@ -0,0 +1,266 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+
+#include "parseNMEA.h"
+#include "logIndex.h"
+
+namespace NMEA
+{
+  namespace
+  {
+      const char magic[8] = {'N','M','E','A','I','D','X','2'};
+
+      /* The time of a line, if it is a valid sentence of a supported format with a valid
+       * time field; nothing otherwise.  Only the time field is converted.
+       */
+      std::optional<GPS::seconds> timeOfLine(std::string_view line)
+      {
+          if (!isWellFormedSentence(line) || !hasCorrectChecksum(line) || !isSupportedSentenceFormat(line.substr(3,3))){
+              return std::nullopt;
+          }
+          const std::size_t timeField = timeFieldIndex(line.substr(3,3));
+
+          std::size_t start = 7;
+          for (std::size_t i = 0; i < timeField; ++i){
+              start = line.find(',', start);
+              if (start == std::string_view::npos){
+                  return std::nullopt;
+              }
+              ++start;
+          }
+          const std::size_t end = std::min(line.find(',', start), line.length() - 3);
+          try {
+              return timeOfDay(line.substr(start, end - start));
+          }
+          catch (const std::invalid_argument &) {
+              return std::nullopt;
+          }
+      }
+
+      std::string_view trim(std::string_view line)
+      {
+          const std::size_t first = line.find_first_not_of(" \t\r\n");
+          if (first == std::string_view::npos){
+              return {};
+          }
+          return line.substr(first, line.find_last_not_of(" \t\r\n") - first + 1);
+      }
+
+      template <typename T>
+      void writeValue(std::ostream & out, const T & value)
+      {
+          out.write(reinterpret_cast<const char *>(&value), sizeof(T));
+      }
+
+      template <typename T>
+      T readValue(std::istream & in)
+      {
+          T value;
+          if (!in.read(reinterpret_cast<char *>(&value), sizeof(T))){
+              throw std::invalid_argument("Truncated log index.");
+          }
+          return value;
+      }
+  }
+
+  LogIndex::LogIndex(GPS::seconds interval)
+      : intervalLength(interval)
+  {
+      if (!(interval > 0)){
+          throw std::invalid_argument("Index interval must be positive.");
+      }
+  }
+
+  LogIndex LogIndex::build(std::istream & log, GPS::seconds interval)
+  {
+      LogIndex result(interval);
+
+      // The log is read in large blocks and split into lines in place, with any partial
+      // line at the end of a block carried over to the next.
+      const std::size_t blockSize = 1 << 20;
+      std::vector<char> buffer(blockSize);
+      std::size_t carried = 0;
+      std::uint64_t blockOffset = 0; // of buffer[0] in the log
+
+      GPS::seconds nextMark = 0;
+      GPS::seconds previousTime = 0;
+
+      auto indexLine = [&](std::string_view line, std::uint64_t offset)
+      {
+          const std::optional<GPS::seconds> time = timeOfLine(trim(line));
+          if (!time){
+              return;
+          }
+          if (!result.index.empty() && *time < previousTime){
+              result.timeOrdered = false;
+          }
+          if (result.index.empty() || *time >= nextMark || *time < previousTime){
+              result.index.push_back({*time, offset});
+              nextMark = (std::floor(*time / interval) + 1) * interval;
+          }
+          previousTime = *time;
+      };
+
+      while (true){
+          if (carried == buffer.size()){
+              buffer.resize(buffer.size() * 2); // a line longer than a block
+          }
+          log.read(buffer.data() + carried, buffer.size() - carried);
+          const std::size_t filled = carried + log.gcount();
+          if (filled == carried){
+              break;
+          }
+
+          std::size_t lineStart = 0;
+          for (const char * newline; (newline = static_cast<const char *>(
+                   std::memchr(buffer.data() + lineStart, '\n', filled - lineStart))); ){
+              const std::size_t lineEnd = newline - buffer.data();
+              indexLine(std::string_view(buffer.data() + lineStart, lineEnd - lineStart), blockOffset + lineStart);
+              lineStart = lineEnd + 1;
+          }
+
+          carried = filled - lineStart;
+          std::memmove(buffer.data(), buffer.data() + lineStart, carried);
+          blockOffset += lineStart;
+      }
+      if (carried > 0){
+          indexLine(std::string_view(buffer.data(), carried), blockOffset);
+      }
+
+      result.logBytes = blockOffset + carried;
+      return result;
+  }
+
+  LogIndex LogIndex::load(std::istream & sidecar)
+  {
+      char header[sizeof(magic)];
+      if (!sidecar.read(header, sizeof(header)) || !std::equal(header, header + sizeof(header), magic)){
+          throw std::invalid_argument("Not a log index.");
+      }
+      LogIndex result(readValue<GPS::seconds>(sidecar));
+      result.timeOrdered = readValue<std::uint8_t>(sidecar) != 0;
+      result.logBytes = readValue<std::uint64_t>(sidecar);
+      result.logModified = readValue<std::int64_t>(sidecar);
+
+      const std::uint64_t count = readValue<std::uint64_t>(sidecar);
+      for (std::uint64_t i = 0; i < count; ++i){
+          const GPS::seconds time = readValue<GPS::seconds>(sidecar);
+          const std::uint64_t offset = readValue<std::uint64_t>(sidecar);
+          result.index.push_back({time, offset});
+      }
+      return result;
+  }
+
+  void LogIndex::save(std::ostream & sidecar) const
+  {
+      sidecar.write(magic, sizeof(magic));
+      writeValue(sidecar, intervalLength);
+      writeValue(sidecar, static_cast<std::uint8_t>(timeOrdered));
+      writeValue(sidecar, logBytes);
+      writeValue(sidecar, logModified);
+      writeValue(sidecar, static_cast<std::uint64_t>(index.size()));
+      for (const Entry & entry : index){
+          writeValue(sidecar, entry.time);
+          writeValue(sidecar, entry.offset);
+      }
+  }
+
+  std::string LogIndex::sidecarPath(const std::string & logPath)
+  {
+      return logPath + ".idx";
+  }
+
+  LogIndex LogIndex::forFile(const std::string & logPath, GPS::seconds interval)
+  {
+      std::ifstream log(logPath, std::ios::binary);
+      if (!log){
+          throw std::invalid_argument("Cannot open log file: " + logPath);
+      }
+      log.seekg(0, std::ios::end);
+      const std::uint64_t logSize = log.tellg();
+      log.seekg(0);
+      const std::int64_t modified = std::filesystem::last_write_time(logPath).time_since_epoch().count();
+
+      if (std::ifstream sidecar{sidecarPath(logPath), std::ios::binary}){
+          try {
+              LogIndex existing = load(sidecar);
+              if (existing.logBytes == logSize && existing.logModified == modified && existing.intervalLength == interval){
+                  return existing;
+              }
+          }
+          catch (const std::invalid_argument &) {
+              //An unreadable index is rebuilt
+          }
+      }
+
+      LogIndex result = build(log, interval);
+      result.logModified = modified;
+      std::ofstream sidecar(sidecarPath(logPath), std::ios::binary);
+      result.save(sidecar);
+      return result;
+  }
+
+  GPS::seconds LogIndex::interval() const
+  {
+      return intervalLength;
+  }
+
+  const std::vector<LogIndex::Entry> & LogIndex::entries() const
+  {
+      return index;
+  }
+
+  bool LogIndex::isTimeOrdered() const
+  {
+      return timeOrdered;
+  }
+
+  std::uint64_t LogIndex::indexedBytes() const
+  {
+      return logBytes;
+  }
+
+  std::uint64_t LogIndex::offsetFor(GPS::seconds time) const
+  {
+      if (!timeOrdered){
+          return 0;
+      }
+      auto after = std::upper_bound(index.begin(), index.end(), time,
+                                    [](GPS::seconds t, const Entry & entry){ return t < entry.time; });
+      return (after == index.begin()) ? 0 : std::prev(after)->offset;
+  }
+
+  std::vector<GPS::Fix> LogIndex::fixesBetween(std::istream & log, GPS::seconds from, GPS::seconds to) const
+  {
+      log.clear();
+      log.seekg(offsetFor(from));
+
+      std::vector<GPS::Fix> vec;
+      std::string data;
+      while (log >> data){
+          const std::optional<LazySentence> sentence = LazySentence::fromLine(data);
+          if (!sentence){
+              continue;
+          }
+          try {
+              const GPS::seconds time = sentence->time();
+              if (time > to && timeOrdered){
+                  break;
+              }
+              if (time >= from && time <= to){
+                  vec.push_back(GPS::Fix{sentence->position(), time});
+              }
+          }
+          catch (const std::invalid_argument &) {
+              //Lines with invalid data are ignored, as in fixesInTimeWindow()
+          }
+      }
+      return vec;
+  }
+}
@@ -1,143 +1,610 @@
+#include <algorithm>
+#include <charconv>
+
 #include "earth.h"
 #include "parseNMEA.h"
 namespace NMEA
 {
+  namespace
+  {
+      bool isUpperCase(char c)
+      {
+          return c >= 'A' && c <= 'Z';
+      }
+
+      bool isHexDigit(char c)
+      {
+          return (c >= '0' && c <= '9') || (c >= 'A' && c <= 'F') || (c >= 'a' && c <= 'f');
+      }
+
+      unsigned hexValue(char c)
+      {
+          if (c >= 'a') return c - 'a' + 10;
+          if (c >= 'A') return c - 'A' + 10;
+          return c - '0';
+      }
+
+      // The characters accepted within the data fields (including the separating commas).
+      constexpr bool isFieldCharacterSlow(char c)
+      {
+          return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9')
+              || c == '-' || c == ',' || c == '.';
+      }
+
+      // As a lookup table, since every character of every line is tested.
+      struct FieldCharacterTable
+      {
+          bool accepted[256] = {};
+
+          constexpr FieldCharacterTable()
+          {
+              for (int c = 0; c < 256; ++c) accepted[c] = isFieldCharacterSlow(static_cast<char>(c));
+          }
+      };
+
+      constexpr FieldCharacterTable fieldCharacters;
+
+      bool isFieldCharacter(char c)
+      {
+          return fieldCharacters.accepted[static_cast<unsigned char>(c)];
+      }
+
+      /* Splits a well-formed sentence into 'data', which may be a SentenceData or an
+       * ArenaSentenceData; in the latter case the strings are allocated from the arena.
+       */
+      template <typename Data>
+      void splitSentence(std::string_view sentence, Data & data)
+      {
+          data.format.assign(sentence.substr(3,3));
+
+          // Fields lie between the ',' following the format and the '*' before the checksum.
+          const std::string_view fields = sentence.substr(7, sentence.length() - 10);
+
+          data.dataFields.reserve(std::count(fields.begin(), fields.end(), ',') + 1);
+          std::size_t start = 0;
+          while (true){
+              const std::size_t comma = fields.find(',', start);
+              data.dataFields.emplace_back(fields.substr(start, comma - start));
+              if (comma == std::string_view::npos){
+                  break;
+              }
+              start = comma + 1;
+          }
+      }
+
+      // The bearing character of a field, or '\0' (an invalid bearing) if the field is empty.
+      char firstCharacter(std::string_view field)
+      {
+          return field.empty() ? '\0' : field.front();
+      }
+
+      /* 'Result' is the type of Position to construct: GPS::Position or GPS::FixedPosition,
+       * both of which are constructible from DDM strings.
+       */
+      template <typename Result, typename Data>
+      Result sentanceInterpreter(const Data & data, unsigned expectedSize, int latPos, int longPos, int northingPos, int eastingPos, int elevatonPos = 0){
+
+          if(data.dataFields.size() != expectedSize){
+              throw std::invalid_argument("Unsupported sentence format.");
+          }
+          //Gets data from the array
+          std::string lat(data.dataFields[latPos]);
+          std::string lon(data.dataFields[longPos]);
+          char northing = firstCharacter(data.dataFields[northingPos]);
+          char easting = firstCharacter(data.dataFields[eastingPos]);
+          //If the elevation position is passed through use constructor with elevation
+          if(!(elevatonPos == 0)){
+              std::string elevation(data.dataFields[elevatonPos]);
+              return Result(std::move(lat),northing,std::move(lon),easting,std::move(elevation));
+          }
+          return Result(std::move(lat),northing,std::move(lon),easting);
+      }
+
+      /* Where each supported format keeps its data, as indices of its data fields.  The
+       * latitude, N/S, longitude and E/W fields are consecutive in every format.
+       */
+      struct FieldLayout
+      {
+          std::string_view format;
+          unsigned fieldCount;
+          int latitude, northing, longitude, easting;
+          int elevation; // 0 if the format has none
+          std::size_t time;
+      };
 
-  bool isSupportedSentenceFormat(std::string format)
+      constexpr FieldLayout fieldLayouts[] = {
+          {"GLL", 5, 0, 1, 2, 3, 0, 4},
+          {"GGA", 14, 1, 2, 3, 4, 8, 0},
+          {"RMC", 11, 2, 3, 4, 5, 0, 0}
+      };
+
+      const FieldLayout & fieldLayout(std::string_view format)
+      {
+          for (const FieldLayout & layout : fieldLayouts){
+              if (layout.format == format){
+                  return layout;
+              }
+          }
+          throw std::invalid_argument("Unsupported sentence format.");
+      }
+
+      template <typename Result = GPS::Position, typename Data>
+      Result interpret(const Data & data)
+      {
+          const FieldLayout & layout = fieldLayout(data.format);
+          return sentanceInterpreter<Result>(data, layout.fieldCount, layout.latitude, layout.longitude,
+                                             layout.northing, layout.easting, layout.elevation);
+      }
+
+      template <typename Data>
+      GPS::seconds interpretTime(const Data & data)
+      {
+          const std::size_t timeField = timeFieldIndex(data.format);
+          if (data.dataFields.size() <= timeField){
+              throw std::invalid_argument("Missing time field.");
+          }
+          return timeOfDay(data.dataFields[timeField]);
+      }
+
+      /* Applies 'interpreter' to the SentenceData of a line, returning nothing if the line is
+       * not a valid sentence or the interpreter throws std::invalid_argument.
+       */
+      template <typename Interpreter>
+      auto interpretLine(std::string_view line, Interpreter interpreter)
+          -> std::optional<decltype(interpreter(std::declval<const SentenceData &>()))>
+      {
+          if (!isWellFormedSentence(line) || !hasCorrectChecksum(line)){
+              return std::nullopt;
+          }
+          SentenceData sentence;
+          splitSentence(line, sentence);
+          if (!isSupportedSentenceFormat(sentence.format)){
+              return std::nullopt;
+          }
+          try {
+              return interpreter(sentence);
+          }
+          catch (const std::invalid_argument &) {
+              return std::nullopt;
+          }
+      }
+  }
+
+  std::size_t timeFieldIndex(std::string_view format)
   {
+      return fieldLayout(format).time;
+  }
 
-      //Use find to see if the supported sentance format code is at the start of the program
-      std::vector<std::string> SupportedCodes{"GLL","GGA","RMC"};
-      return std::find(std::begin(SupportedCodes), std::end(SupportedCodes), format) != std::end(SupportedCodes);
+  bool isSupportedSentenceFormat(std::string_view format)
+  {
+      return std::any_of(std::begin(fieldLayouts), std::end(fieldLayouts),
+                         [format](const FieldLayout & layout) { return layout.format == format; });
   }
-  bool isWellFormedSentence(std::string candidateSentence)
-    {
-        // Uses regex to check for a valid NMEA sentence
-        std::regex regexSentence("\\$GP[A-Z]{3},[\-A-Za-z0-9,.]*\\*[0-9A-Fa-f]{2}");
-        return regex_match(candidateSentence, regexSentence);
-    }
-  bool hasCorrectChecksum(std::string sentence)
-    {
-        assert (isWellFormedSentence(sentence));
-        //Get original checksum and convert to int
-        std::string checkSum = sentence.substr(sentence.find('*') + 1);
-        int iCheckSum = std::stoi(checkSum, 0, 16);
 
-        //Start and endpoint of characters to XOR
+  bool isWellFormedSentence(std::string_view candidateSentence)
+  {
+      /* Hand-written equivalent of the regular expression
+       *   \$GP[A-Z]{3},[-A-Za-z0-9,.]*\*[0-9A-Fa-f]{2}
+       * std::regex was rebuilt on every call and dominated the cost of parsing a log.
+       */
+      const std::size_t length = candidateSentence.length();
+      if (length < 10 || candidateSentence.substr(0,3) != "$GP"){
+          return false; // shortest well-formed sentence is "$GPXXX,*hh"
+      }
+      if (!isUpperCase(candidateSentence[3]) || !isUpperCase(candidateSentence[4]) || !isUpperCase(candidateSentence[5])){
+          return false;
+      }
+      if (candidateSentence[6] != ',' || candidateSentence[length-3] != '*'){
+          return false;
+      }
+      for (std::size_t i = 7; i < length - 3; ++i){
+          if (!isFieldCharacter(candidateSentence[i])){
+              return false;
+          }
+      }
+      return isHexDigit(candidateSentence[length-2]) && isHexDigit(candidateSentence[length-1]);
+  }
 
-        size_t first = sentence.find('$');
-        size_t last = sentence.find('*', first);
-        std::string sub = sentence.substr(first + 1, last - first -1);
+  bool hasCorrectChecksum(std::string_view sentence)
+  {
+      assert (isWellFormedSentence(sentence));
 
+      //The checksum is the two hex digits after the '*'
+      const std::size_t star = sentence.find('*');
+      const unsigned checkSum = hexValue(sentence[star+1]) * 16 + hexValue(sentence[star+2]);
 
-        //XOR value
-        unsigned int cSum = 0;
+      //XOR every character between the '$' and the '*'
+      unsigned cSum = 0;
+      for (std::size_t i = sentence.find('$') + 1; i < star; ++i){
+          cSum ^= static_cast<unsigned char>(sentence[i]);
+      }
+      return checkSum == cSum;
+  }
 
-        //Loop over each character and XOR it
+  SentenceData parseSentenceData(std::string sentence)
+  {
+      assert (isWellFormedSentence(sentence));
+      SentenceData data;
+      splitSentence(sentence, data);
+      return data;
+  }
 
-        for (unsigned int i = 0; i < sub.length(); i++ ){
-            cSum ^= sub[i];
-        }
-        return((unsigned)iCheckSum == cSum);
-    }
+  GPS::Position interpretSentenceData(SentenceData data)
+  {
+      return interpret(data);
+  }
+
+  std::optional<GPS::Position> positionFromLine(std::string_view line)
+  {
+      return interpretLine(line, [](const SentenceData & data){ return interpret<GPS::Position>(data); });
+  }
+
+  ArenaSentenceData parseSentenceData(std::string_view sentence, std::pmr::memory_resource * arena)
+  {
+      assert (isWellFormedSentence(sentence));
+      ArenaSentenceData data(arena);
+      splitSentence(sentence, data);
+      return data;
+  }
+
+  GPS::Position interpretSentenceData(const ArenaSentenceData & data)
+  {
+      return interpret(data);
+  }
+
+  BatchParser::BatchParser(std::size_t arenaBytes)
+      : buffer(arenaBytes),
+        arena(buffer.data(), buffer.size())
+  {}
 
-   SentenceData parseSentenceData(std::string sentence)
+  bool BatchParser::parseBatch(std::istream & log, std::vector<GPS::Position> & positions, std::size_t maxLines)
   {
-       assert (isWellFormedSentence(sentence));
-        //Create substring to hold sentence format
-        std::string sentenceFormat = sentence.substr(3,3);
-    
-        //Vector to hold field data
-        std::vector<std::string> fields;
-        std::string dataContainer = "";
+      arena.release(); // everything allocated by the previous batch is dropped at once
 
-        //Loop pushes seperate fields into the vector value
-        for (unsigned int i = 7 ; i <sentence.length() - 2; i++){
-            char Container = sentence[i];
-            if ((Container == ',')|| (Container == '*')){
-                fields.push_back(dataContainer);
-                dataContainer = "";
+      for (std::size_t lines = 0; lines < maxLines; ){
+          if (!(log >> line)){
+              return false;
+          }
+          if (line.empty()){
+              continue;
+          }
+          ++lines;
+
+          if (!isWellFormedSentence(line) || !hasCorrectChecksum(line)){
+              continue;
+          }
+          const ArenaSentenceData sentence = parseSentenceData(line, &arena);
+          if (!isSupportedSentenceFormat(sentence.format)){
+              continue;
+          }
+          try {
+              positions.push_back(interpretSentenceData(sentence));
+          }
+          catch (const std::invalid_argument &) {
+              //Lines with invalid data are ignored, as in positionsFromLog()
+          }
+      }
+      return true;
+  }
+
+  namespace
+  {
+      using Clock = std::chrono::steady_clock;
+
+      // Adds the time elapsed since 'start' to 'total', and restarts the timer.
+      void lap(Clock::time_point & start, std::chrono::nanoseconds & total)
+      {
+          const Clock::time_point now = Clock::now();
+          total += now - start;
+          start = now;
+      }
+
+      /* The parse loop shared by both positionsFromLog() overloads.
+       * Timing is only taken when 'stats' is non-null, so the plain overload pays nothing for it.
+       */
+      std::vector<GPS::Position> parseLog(std::istream & log, ParseStats * stats, const RejectCallback & onReject)
+      {
+          std::vector<GPS::Position> vec;
+
+          auto reject = [&](RejectReason reason, const std::string & line, unsigned long ParseStats::* counter)
+          {
+              if (stats) ++(stats->*counter);
+              if (onReject) onReject(reason, line);
+          };
+
+          //Loop the file until no sentences remain
+          std::string data;
+          while (log >> data){
+              if (!data.length()){
+                  continue;
+              }
+
+              Clock::time_point timer;
+              if (stats){
+                  ++stats->linesRead;
+                  stats->bytesRead += data.length();
+                  timer = Clock::now();
               }
-              else {
-                  dataContainer = dataContainer + Container;
+
+              const bool wellFormed = isWellFormedSentence(data);
+              if (stats) lap(timer, stats->validateTime);
+              if (!wellFormed){
+                  reject(RejectReason::IllFormed, data, &ParseStats::illFormed);
+                  continue;
+              }
+
+              const bool checksumOK = hasCorrectChecksum(data);
+              if (stats) lap(timer, stats->checksumTime);
+              if (!checksumOK){
+                  reject(RejectReason::BadChecksum, data, &ParseStats::badChecksum);
+                  continue;
+              }
+
+              SentenceData sentence = parseSentenceData(data);
+              if (stats) lap(timer, stats->splitTime);
+              if (!isSupportedSentenceFormat(sentence.format)){
+                  reject(RejectReason::UnsupportedFormat, data, &ParseStats::unsupportedFormat);
+                  continue;
+              }
+
+              try {
+                  vec.push_back(interpretSentenceData(std::move(sentence)));
+                  if (stats){
+                      lap(timer, stats->interpretTime);
+                      ++stats->accepted;
+                  }
+              }
+              catch (const std::invalid_argument &) {
+                  if (stats) lap(timer, stats->interpretTime);
+                  reject(RejectReason::InvalidData, data, &ParseStats::invalidData);
               }
           }
+          return vec;
+      }
+  }
 
-          return {sentenceFormat, fields};
+  unsigned long ParseStats::rejected() const
+  {
+      return illFormed + badChecksum + unsupportedFormat + invalidData;
   }
-  GPS::Position sentanceInterpreter(SentenceData data, unsigned expectedSize, int latPos, int longPos, int northingPos, int eastingPos, int elevatonPos = 0){
 
-      if(data.dataFields.size() != expectedSize){
-          throw std::invalid_argument("Unsupported sentence format.");
+  ParseStats & ParseStats::operator+=(const ParseStats & other)
+  {
+      linesRead         += other.linesRead;
+      bytesRead         += other.bytesRead;
+      accepted          += other.accepted;
+      illFormed         += other.illFormed;
+      badChecksum       += other.badChecksum;
+      unsupportedFormat += other.unsupportedFormat;
+      invalidData       += other.invalidData;
+      validateTime      += other.validateTime;
+      checksumTime      += other.checksumTime;
+      splitTime         += other.splitTime;
+      interpretTime     += other.interpretTime;
+      return *this;
+  }
+
+  std::vector<GPS::Position> positionsFromLog(std::istream & log)
+  {
+      return parseLog(log, nullptr, nullptr);
+  }
+
+  std::vector<GPS::Position> positionsFromLog(std::istream & log, ParseStats & stats, RejectCallback onReject)
+  {
+      return parseLog(log, &stats, onReject);
+  }
+
+  std::vector<GPS::FixedPosition> fixedPositionsFromLog(std::istream & log)
+  {
+      std::vector<GPS::FixedPosition> vec;
+      std::string data;
+      while (log >> data){
+          auto interpreter = [](const SentenceData & sentence){ return interpret<GPS::FixedPosition>(sentence); };
+          if (std::optional<GPS::FixedPosition> pos = interpretLine(data, interpreter)){
+              vec.push_back(*pos);
+          }
       }
-      //Gets data from the array
-       std::string lat = data.dataFields[latPos];
-       std::string lon = data.dataFields[longPos];
-       char northing = data.dataFields[northingPos].front();
-       char easting = data.dataFields[eastingPos].front();
-       std::string elevation = data.dataFields[elevatonPos];
-       //If the elevation position is passed through use constructor with elevation
-       if(!(elevatonPos == 0)){
-           return GPS::Position(lat,northing, lon,easting,elevation);
-       }
-       return GPS::Position(lat,northing,lon,easting);
+      return vec;
   }
-  GPS::Position interpretSentenceData(SentenceData data)
+
+  GPS::seconds timeOfDay(std::string_view hhmmss)
   {
-      
-      if(!(isSupportedSentenceFormat(data.format) == true)){
-          throw std::invalid_argument("Unsupported sentence format.");
+      const std::size_t point = std::min(hhmmss.find('.'), hhmmss.length());
+      if (point == 0 || point > 6){
+          throw std::invalid_argument("Invalid time of day: " + std::string(hhmmss));
       }
-      if(data.format == "GLL"){
-           return sentanceInterpreter(data,5,0,2,1,3);
+
+      long whole = 0;
+      for (std::size_t i = 0; i < point; ++i){
+          if (hhmmss[i] < '0' || hhmmss[i] > '9'){
+              throw std::invalid_argument("Invalid time of day: " + std::string(hhmmss));
+          }
+          whole = whole * 10 + (hhmmss[i] - '0');
+      }
+      double fraction = 0;
+      double scale = 0.1;
+      for (std::size_t i = point + 1; i < hhmmss.length(); ++i, scale /= 10){
+          if (hhmmss[i] < '0' || hhmmss[i] > '9'){
+              throw std::invalid_argument("Invalid time of day: " + std::string(hhmmss));
+          }
+          fraction += (hhmmss[i] - '0') * scale;
+      }
+
+      const long hours = whole / 10000;
+      const long minutes = (whole / 100) % 100;
+      const long secs = whole % 100;
+      if (hours > 23 || minutes > 59 || secs > 60){ // 60 allows for a leap second
+          throw std::invalid_argument("Invalid time of day: " + std::string(hhmmss));
       }
-      if(data.format == "GGA"){
-        return sentanceInterpreter(data,14,1,3,2,4,8);
-        }
-      if(data.format == "RMC"){
-        return sentanceInterpreter(data,11,2,4,3,5);
-        }
-      throw std::invalid_argument("Unsupported sentance format");
+      return hours * 3600 + minutes * 60 + secs + fraction;
   }
 
-  std::vector<GPS::Position> positionsFromLog(std::istream & log)
-    {
+  GPS::seconds interpretSentenceTime(const SentenceData & data)
+  {
+      return interpretTime(data);
+  }
+
+  std::optional<GPS::Fix> fixFromLine(std::string_view line)
+  {
+      return interpretLine(line, [](const SentenceData & data)
+      {
+          return GPS::Fix{interpret<GPS::Position>(data), interpretSentenceTime(data)};
+      });
+  }
 
+  std::vector<GPS::Fix> fixesFromLog(std::istream & log, const FixStage & stage)
+  {
+      std::vector<GPS::Fix> vec;
+      std::string data;
+      while (log >> data){
+          std::optional<GPS::Fix> fix = fixFromLine(data);
+          if (fix && (!stage || stage(*fix))){
+              vec.push_back(*fix);
+          }
+      }
+      return vec;
+  }
+
+  namespace
+  {
+      // Presents the fields of a LazySentence to interpret() and interpretTime() without copying them.
+      struct LazyFields
+      {
+          const LazySentence & sentence;
 
-      //Declare vector positions 
-      std::vector<GPS::Position> vec;
+          std::size_t size() const { return sentence.fieldCount(); }
+          std::string_view operator[](std::size_t i) const { return sentence.field(i); }
+      };
+
+      struct LazyData
+      {
+          std::string_view format;
+          LazyFields dataFields;
+      };
+
+      const GPS::speed metresPerSecondPerKnot = 1852.0 / 3600;
+  }
+
+  std::optional<LazySentence> LazySentence::fromLine(std::string_view line)
+  {
+      if (!isWellFormedSentence(line) || !hasCorrectChecksum(line) || !isSupportedSentenceFormat(line.substr(3,3))){
+          return std::nullopt;
+      }
+      return LazySentence(line);
+  }
 
-      //Loop the file until no sentences remain
+  LazySentence::LazySentence(std::string_view sentence)
+      : line(sentence)
+  {
+      // Fields lie between the ',' following the format and the '*' before the checksum.
+      const std::size_t end = line.length() - 3;
+      std::size_t start = 7;
       while (true){
-          //Create variable to represent single log file line
-          std::string data;
-          log >> data;
-          if (log.eof()){
+          const std::size_t comma = std::min(line.find(',', start), end);
+          fields.push_back({static_cast<std::uint32_t>(start), static_cast<std::uint32_t>(comma - start)});
+          if (comma == end){
               break;
           }
-          if (!data.length()){
-              continue;
-          }
+          start = comma + 1;
+      }
+  }
 
-       //Check if input values are valid
-       try {
-              if(!isWellFormedSentence(data)){
-                  throw std::invalid_argument("Unsupported sentance format");
-              }
-          SentenceData sentence (parseSentenceData(data));
+  std::string_view LazySentence::format() const
+  {
+      return std::string_view(line).substr(3,3);
+  }
 
-          if ((isSupportedSentenceFormat(sentence.format))&&(isWellFormedSentence(data))&&(hasCorrectChecksum(data))){
-              vec.push_back(interpretSentenceData(sentence));
-          }
-       }
+  std::size_t LazySentence::fieldCount() const
+  {
+      return fields.size();
+  }
 
-       //Catching invalid inputs
-       catch (const std::invalid_argument &) {
-            //Catch the error but do not handle it
-       }
+  std::string_view LazySentence::field(std::size_t i) const
+  {
+      return std::string_view(line).substr(fields[i].offset, fields[i].length);
+  }
 
-       }
-          return vec;
+  std::string_view LazySentence::coordinateText() const
+  {
+      const FieldLayout & layout = fieldLayout(format());
+      if (fieldCount() != layout.fieldCount){
+          throw std::invalid_argument("Unsupported sentence format.");
+      }
+      const std::string_view first = field(layout.latitude);
+      const std::string_view last = field(layout.easting);
+      return std::string_view(first.data(), last.data() + last.size() - first.data());
+  }
+
+  const GPS::Position & LazySentence::position() const
+  {
+      if (!cachedPosition){
+          cachedPosition = interpret<GPS::Position>(LazyData{format(), LazyFields{*this}});
       }
+      return *cachedPosition;
+  }
+
+  GPS::metres LazySentence::elevation() const
+  {
+      if (cachedPosition){
+          return cachedPosition->elevation();
+      }
+      const FieldLayout & layout = fieldLayout(format());
+      if (fieldCount() != layout.fieldCount){
+          throw std::invalid_argument("Unsupported sentence format.");
+      }
+      if (layout.elevation == 0){
+          return 0;
+      }
+      //Converted as the Position constructor converts it
+      return std::stod(std::string(field(layout.elevation)));
+  }
+
+  GPS::seconds LazySentence::time() const
+  {
+      if (!cachedTime){
+          cachedTime = interpretTime(LazyData{format(), LazyFields{*this}});
+      }
+      return *cachedTime;
+  }
+
+  GPS::speed LazySentence::groundSpeed() const
+  {
+      if (!cachedSpeed){
+          const std::size_t speedField = 6;
+          if (format() != "RMC" || fieldCount() != 11){
+              throw std::invalid_argument("Only RMC sentences record speed.");
+          }
+          const std::string_view knotsStr = field(speedField);
+          double knots;
+          const auto [end, error] = std::from_chars(knotsStr.data(), knotsStr.data() + knotsStr.size(), knots);
+          if (knotsStr.empty() || error != std::errc() || end != knotsStr.data() + knotsStr.size()){
+              throw std::invalid_argument("Invalid speed: " + std::string(knotsStr));
+          }
+          cachedSpeed = knots * metresPerSecondPerKnot;
+      }
+      return *cachedSpeed;
+  }
+
+  std::vector<GPS::Fix> fixesInTimeWindow(std::istream & log, GPS::seconds from, GPS::seconds to)
+  {
+      std::vector<GPS::Fix> vec;
+      std::string data;
+      while (log >> data){
+          const std::optional<LazySentence> sentence = LazySentence::fromLine(data);
+          if (!sentence){
+              continue;
+          }
+          try {
+              const GPS::seconds time = sentence->time();
+              if (time >= from && time <= to){
+                  vec.push_back(GPS::Fix{sentence->position(), time});
+              }
+          }
+          catch (const std::invalid_argument &) {
+              //Lines with invalid data are ignored, as in fixesFromLog()
+          }
+      }
+      return vec;
+  }
 
 }
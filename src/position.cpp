@@ -9,19 +9,6 @@
 
 namespace GPS
 {
-  Position::Position(degrees lat, degrees lon, metres ele)
-  {
-      if (std::abs(lat) > poleLatitude)
-          throw std::invalid_argument("Latitude values must not exceed " + std::to_string(poleLatitude) + " degrees.");
-
-      if (std::abs(lon) > antiMeridianLongitude)
-          throw std::invalid_argument("Longitude values must not exceed " + std::to_string(antiMeridianLongitude) + " degrees.");
-
-      this->lat = lat;
-      this->lon = lon;
-      this->ele = ele;
-  }
-
   Position::Position(std::string latStr,
                      std::string lonStr,
                      std::string eleStr)
@@ -54,21 +41,6 @@ namespace GPS
 
   }
 
-  degrees Position::latitude() const
-  {
-      return lat;
-  }
-
-  degrees Position::longitude() const
-  {
-      return lon;
-  }
-
-  metres Position::elevation() const
-  {
-      return ele;
-  }
-
   metres Position::horizontalDistanceBetween(Position p1, Position p2)
   /*
    * See: http://en.wikipedia.org/wiki/Law_of_haversines
@@ -0,0 +1,201 @@
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+#include "geometry.h"
+#include "cartesian.h"
+#include "encodeNMEA.h"
+#include "replay.h"
+
+namespace NMEA
+{
+  namespace
+  {
+      const std::size_t fileBlockBytes = 64 * 1024;
+
+      [[noreturn]] void throwSystemError(const std::string & what)
+      {
+          throw std::runtime_error(what + ": " + std::strerror(errno));
+      }
+  }
+
+  ReplaySink::ReplaySink(int fd, bool ownsFd, bool datagrams, std::size_t blockBytes)
+    : fd(fd), ownsFd(ownsFd), datagrams(datagrams), blockBytes(blockBytes)
+  {
+      block.reserve(std::max(blockBytes, maxEncodedSentenceLength));
+  }
+
+  ReplaySink ReplaySink::toFileDescriptor(int fd)
+  {
+      return ReplaySink(fd, false, false, fileBlockBytes);
+  }
+
+  ReplaySink ReplaySink::toUDP(const std::string & address, std::uint16_t port, std::size_t maxDatagramBytes)
+  {
+      sockaddr_in destination {};
+      destination.sin_family = AF_INET;
+      destination.sin_port = htons(port);
+      if (inet_pton(AF_INET, address.c_str(), &destination.sin_addr) != 1)
+          throw std::runtime_error("Invalid IPv4 address: " + address);
+
+      const int fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+      if (fd < 0) throwSystemError("Could not open UDP socket");
+      // Connecting a UDP socket fixes its destination, so each datagram is a plain send().
+      if (::connect(fd, reinterpret_cast<const sockaddr *>(&destination), sizeof(destination)) != 0)
+      {
+          ::close(fd);
+          throwSystemError("Could not connect UDP socket");
+      }
+      return ReplaySink(fd, true, true, maxDatagramBytes);
+  }
+
+  ReplaySink::ReplaySink(ReplaySink && other)
+    : fd(other.fd), ownsFd(other.ownsFd), datagrams(other.datagrams),
+      blockBytes(other.blockBytes), block(std::move(other.block))
+  {
+      other.ownsFd = false;
+      other.block.clear();
+  }
+
+  ReplaySink::~ReplaySink()
+  {
+      try {
+          flush();
+      }
+      catch (const std::runtime_error &) {
+          // Nothing can be done about a failed write from a destructor.
+      }
+      if (ownsFd) ::close(fd);
+  }
+
+  void ReplaySink::send(const char * data, std::size_t length)
+  {
+      if (datagrams)
+      {
+          // A destination that is not (yet) listening is reported by a later send; ignore it.
+          if (::send(fd, data, length, 0) < 0 && errno != ECONNREFUSED) throwSystemError("Could not send datagram");
+          return;
+      }
+      while (length > 0)
+      {
+          const ssize_t written = ::write(fd, data, length);
+          if (written < 0)
+          {
+              if (errno == EINTR) continue;
+              throwSystemError("Could not write");
+          }
+          data += written;
+          length -= written;
+      }
+  }
+
+  void ReplaySink::write(std::string_view sentence)
+  {
+      if (datagrams && blockBytes == 0)
+      {
+          send(sentence.data(), sentence.size());
+          return;
+      }
+      if (!block.empty() && block.size() + sentence.size() > blockBytes) flush();
+      block.insert(block.end(), sentence.begin(), sentence.end());
+  }
+
+  void ReplaySink::flush()
+  {
+      if (block.empty()) return;
+      send(block.data(), block.size());
+      block.clear();
+  }
+
+  ReplayStats replay(const SentenceSource & next, ReplaySink & sink, ReplayOptions options)
+  {
+      using Clock = std::chrono::steady_clock;
+      const Clock::time_point start = Clock::now();
+      const std::size_t batchSize = std::max<std::size_t>(options.batchSize, 1);
+
+      ReplayStats stats;
+      char buffer[maxEncodedSentenceLength];
+      while (options.maxSentences == 0 || stats.sentences < options.maxSentences)
+      {
+          if (options.sentencesPerSecond > 0 && stats.sentences > 0 && stats.sentences % batchSize == 0)
+          {
+              // Send what this batch has queued before waiting for the next batch to be due.
+              sink.flush();
+              const std::chrono::duration<double> due(stats.sentences / options.sentencesPerSecond);
+              std::this_thread::sleep_until(start + std::chrono::duration_cast<Clock::duration>(due));
+          }
+          std::size_t length = 0;
+          if (!next(buffer, length)) break;
+          sink.write(std::string_view(buffer, length));
+          ++stats.sentences;
+          stats.bytes += length;
+      }
+      sink.flush();
+      stats.elapsed = Clock::now() - start;
+      return stats;
+  }
+
+  SentenceSource logSource(const std::string & logContents, unsigned repeats)
+  {
+      auto position = std::make_shared<std::size_t>(0);
+      auto pass = std::make_shared<unsigned>(0);
+      return [&logContents, repeats, position, pass](char * buffer, std::size_t & length)
+      {
+          while (*pass < repeats)
+          {
+              if (*position >= logContents.size())
+              {
+                  *position = 0;
+                  ++*pass;
+                  continue;
+              }
+              std::size_t end = logContents.find('\n', *position);
+              if (end == std::string::npos) end = logContents.size();
+              std::string_view line(logContents.data() + *position, end - *position);
+              *position = end + 1;
+              if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+              // Blank lines are skipped, as are lines too long to be sentences.
+              if (line.empty() || line.size() >= maxEncodedSentenceLength) continue;
+              std::memcpy(buffer, line.data(), line.size());
+              buffer[line.size()] = '\n';
+              length = line.size() + 1;
+              return true;
+          }
+          return false;
+      };
+  }
+
+  SentenceSource syntheticSource(GPS::Position centre, GPS::metres radius, GPS::speed speed, double fixesPerSecond)
+  {
+      struct State
+      {
+          GPS::LocalFrame frame;
+          unsigned long long sentence = 0;
+          GPS::Fix fix {GPS::Position(0, 0), 0};
+      };
+      auto state = std::make_shared<State>(State{GPS::LocalFrame(centre)});
+      const double radiansPerSecond = speed / radius;
+      return [state, radius, speed, fixesPerSecond, radiansPerSecond](char * buffer, std::size_t & length)
+      {
+          const bool gga = state->sentence % 2 == 0;
+          if (gga)
+          {
+              const GPS::seconds t = (state->sentence / 2) / fixesPerSecond;
+              const GPS::radians angle = radiansPerSecond * t;
+              state->fix = { state->frame.toPosition({radius * std::cos(angle), radius * std::sin(angle), 0}), t };
+          }
+          length = encodeSentence(gga ? "GGA" : "RMC", state->fix, speed, buffer);
+          ++state->sentence;
+          return true;
+      };
+  }
+}
@@ -0,0 +1,264 @@
+#include <cmath>
+#include <stdexcept>
+
+#include "geometry.h"
+#include "earth.h"
+#include "fixFilter.h"
+#include "resample.h"
+
+namespace GPS
+{
+  namespace
+  {
+      const seconds secondsPerDay = 24 * 60 * 60;
+
+      struct Vector
+      {
+          double x, y, z;
+      };
+
+      Vector unitVector(const Position & pos)
+      {
+          const radians lat = degToRad(pos.latitude()), lon = degToRad(pos.longitude());
+          return { std::cos(lat) * std::cos(lon), std::cos(lat) * std::sin(lon), std::sin(lat) };
+      }
+
+      // The angle between two vectors, accurate for small angles (unlike acos of the dot product).
+      radians angleBetween(const Vector & a, const Vector & b)
+      {
+          const double cx = a.y*b.z - a.z*b.y, cy = a.z*b.x - a.x*b.z, cz = a.x*b.y - a.y*b.x;
+          return std::atan2(pythagoras(cx, cy, cz), a.x*b.x + a.y*b.y + a.z*b.z);
+      }
+
+      // Positions closer than this (about 6mm) are interpolated linearly.
+      const radians smallAngle = 1e-9;
+
+      // The weights of the endpoints for a point 'fraction' of the way along an arc of 'angle'.
+      void slerpWeights(radians angle, double fraction, double & fromWeight, double & toWeight)
+      {
+          const double sinAngle = std::sin(angle);
+          const bool small = angle < smallAngle;
+          fromWeight = small ? 1 - fraction : std::sin((1 - fraction) * angle) / sinAngle;
+          toWeight = small ? fraction : std::sin(fraction * angle) / sinAngle;
+      }
+
+      // The latitude and longitude of the direction of a (not necessarily unit) vector.
+      void toLatLon(double x, double y, double z, degrees & lat, degrees & lon)
+      {
+          lat = radToDeg(std::atan2(z, pythagoras(x, y)));
+          lon = radToDeg(std::atan2(y, x));
+      }
+
+      long long firstSampleAtOrAfter(seconds time, seconds interval)
+      {
+          return static_cast<long long>(std::ceil(time / interval));
+      }
+
+      void checkParameters(seconds interval, seconds maxGap)
+      {
+          if (interval <= 0) throw std::invalid_argument("Resampling interval must be positive.");
+          if (maxGap < 0) throw std::invalid_argument("Maximum gap must not be negative.");
+      }
+
+      /* Plans the samples between two consecutive Fixes, calling 'sample(index, fraction, hold)'
+       * for each, where 'index' counts intervals from midnight on the first day, and 'hold'
+       * is true if the sample takes the earlier Fix's Position under GapPolicy::HoldLast.
+       * Advances 'nextIndex' past the later Fix.
+       */
+      template <typename Sample>
+      void planSegment(seconds fromTime, seconds elapsed, seconds interval, seconds maxGap, GapPolicy policy,
+                       long long & nextIndex, Sample && sample)
+      {
+          const seconds toTime = fromTime + elapsed;
+          const bool gap = elapsed > maxGap;
+          if (gap && policy == GapPolicy::Omit) nextIndex = firstSampleAtOrAfter(toTime, interval);
+          for (; nextIndex * interval <= toTime; ++nextIndex)
+          {
+              const seconds t = nextIndex * interval;
+              const double fraction = (t - fromTime) / elapsed;
+              sample(nextIndex, fraction, gap && policy == GapPolicy::HoldLast && t < toTime);
+          }
+      }
+  }
+
+  Position interpolate(const Position & from, const Position & to, double fraction)
+  {
+      if (fraction == 0) return from;
+      if (fraction == 1) return to;
+
+      const Vector a = unitVector(from), b = unitVector(to);
+      double fromWeight, toWeight;
+      slerpWeights(angleBetween(a, b), fraction, fromWeight, toWeight);
+      degrees lat, lon;
+      toLatLon(fromWeight * a.x + toWeight * b.x,
+               fromWeight * a.y + toWeight * b.y,
+               fromWeight * a.z + toWeight * b.z, lat, lon);
+      const metres ele = from.elevation() + fraction * (to.elevation() - from.elevation());
+      return Position(lat, lon, ele);
+  }
+
+  Resampler::Resampler(seconds interval, seconds maxGap, GapPolicy policy)
+    : interval(interval), maxGap(maxGap), policy(policy)
+  {
+      checkParameters(interval, maxGap);
+  }
+
+  void Resampler::add(const Fix & fix, std::vector<Fix> & samples)
+  {
+      if (!previous)
+      {
+          previous = fix;
+          previousTime = fix.time;
+          nextSample = firstSampleAtOrAfter(fix.time, interval);
+          if (nextSample * interval == fix.time)
+          {
+              samples.push_back(fix);
+              ++nextSample;
+          }
+          return;
+      }
+
+      const seconds elapsed = elapsedTime(previous->time, fix.time);
+      if (elapsed == 0) return;
+
+      planSegment(previousTime, elapsed, interval, maxGap, policy, nextSample,
+                  [&](long long index, double fraction, bool hold)
+      {
+          const Position pos = hold ? previous->position : interpolate(previous->position, fix.position, fraction);
+          samples.push_back({pos, std::fmod(index * interval, secondsPerDay)});
+      });
+      previousTime += elapsed;
+      previous = fix;
+  }
+
+  std::vector<Fix> resampleTrack(const std::vector<Fix> & fixes, seconds interval, seconds maxGap, GapPolicy policy)
+  {
+      checkParameters(interval, maxGap);
+      if (fixes.empty()) return {};
+
+      // Pass 1: assign each sample the pair of Fixes it lies between, and its fraction of the way.
+      std::vector<std::size_t> fromFix, toFix;
+      std::vector<double> fractions;
+      std::vector<seconds> times;
+      // For each Fix, the Fix before it that was not ignored.
+      std::vector<std::size_t> previousFix(fixes.size(), 0);
+      {
+          long long nextIndex = firstSampleAtOrAfter(fixes[0].time, interval);
+          if (nextIndex * interval == fixes[0].time)
+          {
+              fromFix.push_back(0);
+              toFix.push_back(0);
+              fractions.push_back(1);
+              times.push_back(fixes[0].time);
+              ++nextIndex;
+          }
+          seconds fromTime = fixes[0].time;
+          std::size_t from = 0;
+          for (std::size_t i = 1; i < fixes.size(); ++i)
+          {
+              const seconds elapsed = elapsedTime(fixes[from].time, fixes[i].time);
+              if (elapsed == 0) continue;
+              previousFix[i] = from;
+              planSegment(fromTime, elapsed, interval, maxGap, policy, nextIndex,
+                          [&](long long index, double fraction, bool hold)
+              {
+                  // A held sample is the earlier Fix, reached at fraction 1 of a segment to itself.
+                  fromFix.push_back(from);
+                  toFix.push_back(hold ? from : i);
+                  fractions.push_back(hold ? 1 : fraction);
+                  times.push_back(std::fmod(index * interval, secondsPerDay));
+              });
+              fromTime += elapsed;
+              from = i;
+          }
+      }
+      const std::size_t n = toFix.size();
+
+      // Pass 2: the Fixes as Cartesian vectors (at zero elevation), converted in one batch,
+      // and the angle of the arc from each Fix's predecessor.
+      std::vector<degrees> lat(fixes.size()), lon(fixes.size());
+      std::vector<metres> zero(fixes.size(), 0), x(fixes.size()), y(fixes.size()), z(fixes.size());
+      for (std::size_t i = 0; i < fixes.size(); ++i)
+      {
+          lat[i] = fixes[i].position.latitude();
+          lon[i] = fixes[i].position.longitude();
+      }
+      Earth::toECEF(lat.data(), lon.data(), zero.data(), x.data(), y.data(), z.data(), fixes.size());
+      std::vector<radians> arcAngle(fixes.size(), 0);
+      for (std::size_t i = 1; i < fixes.size(); ++i)
+      {
+          const std::size_t p = previousFix[i];
+          arcAngle[i] = angleBetween({x[p], y[p], z[p]}, {x[i], y[i], z[i]});
+      }
+
+      /* Pass 3: interpolate the vectors and elevations.  A sample 'f' of the way along an arc
+       * of angle A from 'a' is cos(fA) a + sin(fA) v, where v is the vector at right angles
+       * to 'a' in the direction of the arc.  Successive samples on an arc are a fixed angle
+       * apart, so after the first two, (cos,sin) is advanced by rotation instead of by
+       * evaluating trigonometric functions.
+       */
+      std::vector<double> sx(n), sy(n), sz(n), ele(n);
+      std::size_t arcFrom = fixes.size(), arcTo = fixes.size();
+      bool linear = true, stepKnown = false;
+      double c = 1, s = 0, stepCos = 1, stepSin = 0, previousFraction = 0;
+      Vector v {0, 0, 0};
+      for (std::size_t k = 0; k < n; ++k)
+      {
+          const std::size_t a = fromFix[k], b = toFix[k];
+          const double f = fractions[k];
+          const radians angle = arcAngle[b];
+          if (a != arcFrom || b != arcTo)
+          {
+              arcFrom = a;
+              arcTo = b;
+              stepKnown = false;
+              linear = a == b || angle < smallAngle;
+              if (!linear)
+              {
+                  const double sinAngle = std::sin(angle), cosAngle = std::cos(angle);
+                  v = { (x[b] - cosAngle * x[a]) / sinAngle,
+                        (y[b] - cosAngle * y[a]) / sinAngle,
+                        (z[b] - cosAngle * z[a]) / sinAngle };
+                  c = std::cos(f * angle);
+                  s = std::sin(f * angle);
+              }
+          }
+          else if (!linear)
+          {
+              if (!stepKnown)
+              {
+                  stepCos = std::cos((f - previousFraction) * angle);
+                  stepSin = std::sin((f - previousFraction) * angle);
+                  stepKnown = true;
+              }
+              const double nextCos = c * stepCos - s * stepSin;
+              s = s * stepCos + c * stepSin;
+              c = nextCos;
+          }
+          previousFraction = f;
+
+          const double wa = linear ? 1 - f : c, wb = linear ? f : 0;
+          sx[k] = wa * x[a] + wb * x[b] + (linear ? 0 : s * v.x);
+          sy[k] = wa * y[a] + wb * y[b] + (linear ? 0 : s * v.y);
+          sz[k] = wa * z[a] + wb * z[b] + (linear ? 0 : s * v.z);
+          const metres eleA = fixes[a].position.elevation(), eleB = fixes[b].position.elevation();
+          ele[k] = eleA + f * (eleB - eleA);
+      }
+
+      // Pass 4: back to latitude and longitude.  Samples at Fix times take the Fix's Position exactly.
+      std::vector<Fix> samples;
+      samples.reserve(n);
+      for (std::size_t k = 0; k < n; ++k)
+      {
+          if (fractions[k] == 1)
+          {
+              samples.push_back({fixes[toFix[k]].position, times[k]});
+              continue;
+          }
+          degrees sampleLat, sampleLon;
+          toLatLon(sx[k], sy[k], sz[k], sampleLat, sampleLon);
+          samples.push_back({Position(sampleLat, sampleLon, ele[k]), times[k]});
+      }
+      return samples;
+  }
+}
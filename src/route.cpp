@@ -0,0 +1,234 @@
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#include "geometry.h"
+#include "earth.h"
+#include "route.h"
+
+namespace GPS
+{
+  namespace
+  {
+      /* Returns the value of the named attribute in an XML start tag, or throws a
+       * std::invalid_argument exception if it is absent.
+       */
+      std::string attribute(const std::string & tag, const std::string & name)
+      {
+          for (std::size_t pos = tag.find(name + "="); pos != std::string::npos; pos = tag.find(name + "=", pos + 1))
+          {
+              if (pos == 0 || !std::isspace(static_cast<unsigned char>(tag[pos-1]))) continue; // e.g. "xlat="
+              const std::size_t open = pos + name.length() + 1;
+              if (open >= tag.length() || (tag[open] != '"' && tag[open] != '\'')) break;
+              const std::size_t close = tag.find(tag[open], open + 1);
+              if (close == std::string::npos) break;
+              return tag.substr(open + 1, close - open - 1);
+          }
+          throw std::invalid_argument("Missing or malformed '" + name + "' attribute in GPX element: " + tag);
+      }
+
+      double toNumber(const std::string & str)
+      {
+          std::size_t used = 0;
+          const double value = std::stod(str, &used);
+          if (used != str.length()) throw std::invalid_argument(str + " is not a number.");
+          return value;
+      }
+  }
+
+  std::vector<Position> routeFromGPX(std::istream & gpx)
+  {
+      const std::string content{std::istreambuf_iterator<char>(gpx), std::istreambuf_iterator<char>()};
+
+      std::vector<Position> route;
+      std::size_t pos = 0;
+      while ((pos = content.find("<rtept", pos)) != std::string::npos)
+      {
+          const std::size_t tagEnd = content.find('>', pos);
+          if (tagEnd == std::string::npos)
+              throw std::invalid_argument("Unterminated <rtept> element in GPX.");
+          const std::string tag = content.substr(pos, tagEnd - pos + 1);
+
+          const degrees lat = toNumber(attribute(tag, "lat"));
+          const degrees lon = toNumber(attribute(tag, "lon"));
+          metres ele = 0;
+
+          const bool selfClosing = content[tagEnd-1] == '/';
+          std::size_t next = tagEnd + 1;
+          if (!selfClosing)
+          {
+              const std::size_t close = content.find("</rtept>", tagEnd);
+              if (close == std::string::npos)
+                  throw std::invalid_argument("Unterminated <rtept> element in GPX.");
+              const std::size_t eleStart = content.find("<ele>", tagEnd);
+              if (eleStart < close)
+              {
+                  const std::size_t eleEnd = content.find("</ele>", eleStart);
+                  ele = toNumber(content.substr(eleStart + 5, eleEnd - eleStart - 5));
+              }
+              next = close;
+          }
+
+          route.emplace_back(lat, lon, ele);
+          pos = next;
+      }
+
+      if (route.empty())
+          throw std::invalid_argument("No route points found in GPX.");
+      return route;
+  }
+
+  RouteDeviationMonitor::RouteDeviationMonitor(std::vector<Position> route, metres threshold, degrees cellSize)
+      : route(std::move(route)), threshold(threshold), cellSize(cellSize)
+  {
+      if (this->route.size() < 2)
+          throw std::invalid_argument("A route must have at least two points.");
+      if (!(threshold > 0) || !(cellSize > 0))
+          throw std::invalid_argument("Route deviation threshold and cell size must be positive.");
+
+      for (std::size_t segment = 0; segment + 1 < this->route.size(); ++segment)
+      {
+          const Position & a = this->route[segment];
+          const Position & b = this->route[segment+1];
+          const long minRow = cellIndex(std::min(a.latitude(), b.latitude()));
+          const long maxRow = cellIndex(std::max(a.latitude(), b.latitude()));
+          const long minCol = cellIndex(std::min(a.longitude(), b.longitude()));
+          const long maxCol = cellIndex(std::max(a.longitude(), b.longitude()));
+          for (long row = minRow; row <= maxRow; ++row)
+          {
+              for (long col = minCol; col <= maxCol; ++col)
+              {
+                  grid[cellKey(row, col)].push_back(segment);
+              }
+          }
+      }
+  }
+
+  RouteDeviationMonitor::Match RouteDeviationMonitor::update(Position pos)
+  {
+      Match best {0, std::numeric_limits<metres>::infinity(), true};
+
+      // Fast path: the track is still following the route near the previous match.
+      if (matched)
+      {
+          const std::size_t first = lastSegment > searchBehind ? lastSegment - searchBehind : 0;
+          const std::size_t last = std::min(lastSegment + searchAhead, route.size() - 2);
+          for (std::size_t segment = first; segment <= last; ++segment)
+          {
+              const metres distance = distanceToSegment(pos, segment);
+              if (distance < best.crossTrackDistance) best = {segment, distance, false};
+          }
+          // If the best is at the edge of the window, a closer segment may lie beyond it.
+          const bool atEdge = (best.segment == last && last + 2 < route.size())
+                           || (best.segment == first && first > 0);
+          if (best.crossTrackDistance > threshold || atEdge)
+          {
+              best.crossTrackDistance = std::numeric_limits<metres>::infinity();
+          }
+      }
+
+      if (best.crossTrackDistance > threshold && !nearestWithin(pos, threshold, best))
+      {
+          // Off the route: widen the search until some segment is found.
+          metres radius = threshold;
+          bool found = false;
+          while (!found && !searchAll(radius))
+          {
+              radius *= 4;
+              found = nearestWithin(pos, radius, best);
+          }
+          if (!found)
+          {
+              for (std::size_t segment = 0; segment + 1 < route.size(); ++segment)
+              {
+                  const metres distance = distanceToSegment(pos, segment);
+                  if (distance < best.crossTrackDistance) best = {segment, distance, true};
+              }
+          }
+          else
+          {
+              // A nearer segment could lie beyond the window in which the first was found.
+              nearestWithin(pos, best.crossTrackDistance, best);
+          }
+      }
+
+      best.deviating = best.crossTrackDistance > threshold;
+      lastSegment = best.segment;
+      matched = !best.deviating;
+      return best;
+  }
+
+  bool RouteDeviationMonitor::searchAll(metres radius) const
+  {
+      // Beyond this, scanning every segment is cheaper than the grid cells around the fix.
+      const degrees span = 2 * Earth::angleSubtendedBy(radius) / cellSize;
+      return span * span > route.size();
+  }
+
+  bool RouteDeviationMonitor::nearestWithin(Position pos, metres radius, Match & best) const
+  {
+      // Any segment within the radius has a bounding box overlapping this window.  The spans
+      // are in the metric of distanceToSegment(): the meanRadius sphere, scaled at the fix.
+      const degrees latSpan = Earth::angleSubtendedBy(radius);
+      const degrees lonSpan = std::min(latSpan / std::cos(degToRad(pos.latitude())), halfRotation);
+      const long minRow = cellIndex(pos.latitude() - latSpan), maxRow = cellIndex(pos.latitude() + latSpan);
+      const long minCol = cellIndex(pos.longitude() - lonSpan), maxCol = cellIndex(pos.longitude() + lonSpan);
+
+      bool found = false;
+      for (long row = minRow; row <= maxRow; ++row)
+      {
+          for (long col = minCol; col <= maxCol; ++col)
+          {
+              const auto cell = grid.find(cellKey(row, col));
+              if (cell == grid.end()) continue;
+              for (std::size_t segment : cell->second)
+              {
+                  const metres distance = distanceToSegment(pos, segment);
+                  if (distance <= radius && (!found || distance < best.crossTrackDistance
+                                             || (distance == best.crossTrackDistance && segment < best.segment)))
+                  {
+                      best = {segment, distance, false};
+                      found = true;
+                  }
+              }
+          }
+      }
+      return found;
+  }
+
+  metres RouteDeviationMonitor::distanceToSegment(Position pos, std::size_t segment) const
+  {
+      // Project onto a plane tangent at the fix, in metres.
+      const double metresPerDegree = degToRad(1) * Earth::meanRadius;
+      const double lonScale = std::cos(degToRad(pos.latitude())) * metresPerDegree;
+
+      const Position & a = route[segment];
+      const Position & b = route[segment+1];
+      const double ax = normaliseDeg(a.longitude() - pos.longitude()) * lonScale;
+      const double ay = (a.latitude() - pos.latitude()) * metresPerDegree;
+      const double bx = normaliseDeg(b.longitude() - pos.longitude()) * lonScale;
+      const double by = (b.latitude() - pos.latitude()) * metresPerDegree;
+
+      // Closest point to the origin on the segment a-b.
+      const double dx = bx - ax, dy = by - ay;
+      const double lengthSqr = dx*dx + dy*dy;
+      double t = lengthSqr > 0 ? -(ax*dx + ay*dy) / lengthSqr : 0;
+      t = std::clamp(t, 0.0, 1.0);
+      return pythagoras(ax + t*dx, ay + t*dy);
+  }
+
+  RouteDeviationMonitor::CellKey RouteDeviationMonitor::cellKey(long row, long col) const
+  {
+      return (static_cast<CellKey>(row) << 32) ^ static_cast<std::uint32_t>(col);
+  }
+
+  long RouteDeviationMonitor::cellIndex(degrees angle) const
+  {
+      return static_cast<long>(std::floor(angle / cellSize));
+  }
+}
@@ -0,0 +1,204 @@
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <bit>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+#include "parseNMEA.h"
+#include "sharedFix.h"
+
+namespace GPS
+{
+  /* The layout of the shared memory segment.  The sequence number and the fields it guards
+   * share one cache line, so a reader's copy touches only that line.  The fields are atomic
+   * words (holding the bits of doubles) so that the unsynchronised reads a sequence lock
+   * relies on are not data races; lock-free atomics work across processes.
+   */
+  struct SharedFixSegment
+  {
+      std::atomic<std::uint64_t> magic;
+
+      alignas(64) std::atomic<std::uint64_t> sequence; // twice the number published; odd while publishing
+      std::atomic<std::uint64_t> latitude;
+      std::atomic<std::uint64_t> longitude;
+      std::atomic<std::uint64_t> elevation;
+      std::atomic<std::uint64_t> time;
+      std::atomic<std::uint64_t> groundSpeed;
+      std::atomic<std::int64_t>  publishedAt;
+  };
+
+  namespace
+  {
+      // Identifies a segment created by a FixPublisher (and the version of its layout).
+      const std::uint64_t segmentMagic = 0x4750534649580001; // "GPSFIX" 0001
+
+      static_assert(std::atomic<std::uint64_t>::is_always_lock_free);
+      static_assert(std::atomic<std::int64_t>::is_always_lock_free);
+
+      [[noreturn]] void throwSystemError(const std::string & what)
+      {
+          throw std::runtime_error(what + ": " + std::strerror(errno));
+      }
+
+      std::uint64_t bits(double value)
+      {
+          return std::bit_cast<std::uint64_t>(value);
+      }
+
+      double value(std::uint64_t bits)
+      {
+          return std::bit_cast<double>(bits);
+      }
+
+      // Maps the named segment, creating it if 'create'.
+      void * mapSegment(const std::string & name, bool create)
+      {
+          const int fd = create ? ::shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644)
+                                : ::shm_open(name.c_str(), O_RDONLY, 0);
+          if (fd < 0) throwSystemError("Could not open shared memory segment " + name);
+
+          if (create && ::ftruncate(fd, sizeof(SharedFixSegment)) != 0)
+          {
+              ::close(fd);
+              ::shm_unlink(name.c_str());
+              throwSystemError("Could not size shared memory segment " + name);
+          }
+          struct stat status;
+          if (!create && (::fstat(fd, &status) != 0 || status.st_size < static_cast<off_t>(sizeof(SharedFixSegment))))
+          {
+              ::close(fd);
+              throw std::runtime_error("Not a fix segment: " + name);
+          }
+
+          void * address = ::mmap(nullptr, sizeof(SharedFixSegment), create ? PROT_READ | PROT_WRITE : PROT_READ,
+                                  MAP_SHARED, fd, 0);
+          // The mapping keeps the segment open.
+          ::close(fd);
+          if (address == MAP_FAILED)
+          {
+              if (create) ::shm_unlink(name.c_str());
+              throwSystemError("Could not map shared memory segment " + name);
+          }
+          return address;
+      }
+  }
+
+  FixPublisher::FixPublisher(const std::string & name)
+    : name(name)
+  {
+      // Start afresh rather than adopt a segment left by a publisher that did not exit cleanly.
+      ::shm_unlink(name.c_str());
+      segment = new (mapSegment(name, true)) SharedFixSegment{};
+      segment->magic.store(segmentMagic, std::memory_order_release);
+  }
+
+  FixPublisher::~FixPublisher()
+  {
+      ::munmap(segment, sizeof(SharedFixSegment));
+      ::shm_unlink(name.c_str());
+  }
+
+  void FixPublisher::publish(const Fix & fix, speed groundSpeed)
+  {
+      // Read the clock first, to keep the window in which readers must retry short.
+      const auto now = std::chrono::steady_clock::now().time_since_epoch();
+      const std::int64_t publishedAt = std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+
+      const std::uint64_t sequence = segment->sequence.load(std::memory_order_relaxed);
+      segment->sequence.store(sequence + 1, std::memory_order_relaxed);
+      // Readers that see any of the new fields also see the odd sequence number.
+      std::atomic_thread_fence(std::memory_order_release);
+
+      segment->latitude.store(bits(fix.position.latitude()), std::memory_order_relaxed);
+      segment->longitude.store(bits(fix.position.longitude()), std::memory_order_relaxed);
+      segment->elevation.store(bits(fix.position.elevation()), std::memory_order_relaxed);
+      segment->time.store(bits(fix.time), std::memory_order_relaxed);
+      segment->groundSpeed.store(bits(groundSpeed), std::memory_order_relaxed);
+      segment->publishedAt.store(publishedAt, std::memory_order_relaxed);
+
+      segment->sequence.store(sequence + 2, std::memory_order_release);
+  }
+
+  unsigned long long FixPublisher::published() const
+  {
+      return segment->sequence.load(std::memory_order_relaxed) / 2;
+  }
+
+  FixSubscriber::FixSubscriber(const std::string & name)
+    : segment(static_cast<const SharedFixSegment *>(mapSegment(name, false)))
+  {
+      if (segment->magic.load(std::memory_order_acquire) != segmentMagic)
+      {
+          ::munmap(const_cast<SharedFixSegment *>(segment), sizeof(SharedFixSegment));
+          throw std::runtime_error("Not a fix segment: " + name);
+      }
+  }
+
+  FixSubscriber::~FixSubscriber()
+  {
+      ::munmap(const_cast<SharedFixSegment *>(segment), sizeof(SharedFixSegment));
+  }
+
+  std::optional<PublishedFix> FixSubscriber::tryLatest() const
+  {
+      const std::uint64_t before = segment->sequence.load(std::memory_order_acquire);
+      if (before == 0 || before % 2 != 0) return std::nullopt;
+
+      const std::uint64_t latitude = segment->latitude.load(std::memory_order_relaxed);
+      const std::uint64_t longitude = segment->longitude.load(std::memory_order_relaxed);
+      const std::uint64_t elevation = segment->elevation.load(std::memory_order_relaxed);
+      const std::uint64_t time = segment->time.load(std::memory_order_relaxed);
+      const std::uint64_t groundSpeed = segment->groundSpeed.load(std::memory_order_relaxed);
+      const std::int64_t publishedAt = segment->publishedAt.load(std::memory_order_relaxed);
+
+      // The fields are read before the sequence number is read again.
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (segment->sequence.load(std::memory_order_relaxed) != before) return std::nullopt;
+
+      return PublishedFix{ {Position(value(latitude), value(longitude), value(elevation)), value(time)},
+                           value(groundSpeed), before / 2, std::chrono::nanoseconds(publishedAt) };
+  }
+
+  std::optional<PublishedFix> FixSubscriber::latest() const
+  {
+      while (true)
+      {
+          if (std::optional<PublishedFix> fix = tryLatest()) return fix;
+          if (segment->sequence.load(std::memory_order_relaxed) == 0) return std::nullopt;
+      }
+  }
+
+  unsigned long long FixSubscriber::sequence() const
+  {
+      return segment->sequence.load(std::memory_order_acquire) / 2;
+  }
+
+  std::size_t publishFixesFromLog(std::istream & log, FixPublisher & publisher)
+  {
+      std::size_t count = 0;
+      std::string line;
+      while (log >> line)
+      {
+          const std::optional<NMEA::LazySentence> sentence = NMEA::LazySentence::fromLine(line);
+          if (!sentence) continue;
+          try {
+              const Fix fix {sentence->position(), sentence->time()};
+              speed groundSpeed = std::numeric_limits<speed>::quiet_NaN();
+              if (sentence->format() == "RMC") groundSpeed = sentence->groundSpeed();
+              publisher.publish(fix, groundSpeed);
+              ++count;
+          }
+          catch (const std::invalid_argument &) {
+              // Not a valid fix.
+          }
+      }
+      return count;
+  }
+}
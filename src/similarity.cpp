@@ -0,0 +1,329 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+
+#include "geometry.h"
+#include "earth.h"
+#include "workStealing.h"
+#include "similarity.h"
+
+namespace GPS
+{
+  namespace
+  {
+      using Vector = Trajectory::Vector;
+
+      const double infinity = std::numeric_limits<double>::infinity();
+
+      double chordSqr(const Vector & u, const Vector & v)
+      {
+          const double dx = u.x - v.x, dy = u.y - v.y, dz = u.z - v.z;
+          return dx*dx + dy*dy + dz*dz;
+      }
+
+      /* The distance along the surface between two points a (squared) chord apart: the
+       * chord is 2 sin(d/2) for a central angle d, which makes this the haversine formula.
+       */
+      metres arcLength(double chordSqr)
+      {
+          const double halfChord = std::sqrt(chordSqr) / 2;
+          if (halfChord < 0.01) // within about 127 km
+          {
+              // The series for asin, which is exact to double precision for small values.
+              const double squared = halfChord * halfChord;
+              return 2 * Earth::meanRadius * halfChord * (1 + squared * (1.0/6 + squared * (3.0/40 + squared * (5.0/112))));
+          }
+          return 2 * Earth::meanRadius * std::asin(std::min(1.0, halfChord));
+      }
+
+      double chordSqrOf(metres arc)
+      {
+          const radians halfAngle = arc / (2 * Earth::meanRadius);
+          if (halfAngle >= pi / 2) return infinity;
+          const double halfChord = std::sin(halfAngle);
+          return 4 * halfChord * halfChord;
+      }
+
+      // The columns that each row may be aligned with: first[i] to last[i] inclusive.
+      struct Band
+      {
+          std::vector<std::size_t> first, last;
+      };
+
+      /* Cell (i,j) is in the band if |i(m-1) - j(n-1)| <= W, which is the fraction of the
+       * longer track measured along it.  W is at least the longer length, which lets each row
+       * overlap the next by a column, so that there is always a path.
+       */
+      Band sakoeChibaBand(std::size_t n, std::size_t m, double fraction)
+      {
+          using Int = std::int64_t;
+          const Int rows = n - 1, columns = m - 1;
+          const Int width = std::max(static_cast<Int>(std::min(fraction, 1.0) * rows * columns),
+                                     std::max(rows, columns));
+
+          Band band;
+          band.first.resize(n);
+          band.last.resize(n);
+          for (Int i = 0; i < static_cast<Int>(n); ++i)
+          {
+              if (rows == 0)
+              {
+                  band.first[i] = 0;
+                  band.last[i] = columns;
+                  continue;
+              }
+              const Int low = i * columns - width, high = i * columns + width;
+              band.first[i] = low <= 0 ? 0 : (low + rows - 1) / rows;
+              band.last[i] = std::min(high / rows, columns);
+          }
+          return band;
+      }
+
+      /* The least (or greatest) of a coordinate of the 'points' in each row's band, by keeping
+       * a deque of the positions that could yet be the extreme, as the band moves along.
+       */
+      template <typename Compare>
+      std::vector<double> bandExtremes(const std::vector<Vector> & points, double Vector::* coordinate,
+                                       const Band & band, Compare better)
+      {
+          std::vector<double> extremes(band.first.size());
+          std::deque<std::size_t> candidates;
+          std::size_t next = 0;
+          for (std::size_t i = 0; i < extremes.size(); ++i)
+          {
+              for (; next <= band.last[i]; ++next)
+              {
+                  while (!candidates.empty() && !better(points[candidates.back()].*coordinate, points[next].*coordinate))
+                      candidates.pop_back();
+                  candidates.push_back(next);
+              }
+              while (candidates.front() < band.first[i]) candidates.pop_front();
+              extremes[i] = points[candidates.front()].*coordinate;
+          }
+          return extremes;
+      }
+
+      /* For each point of 'a', the least squared chord to the points of 'b' it may be aligned
+       * with: the first and last points exactly, and the others to the bounding box of the
+       * points in the band.
+       */
+      std::vector<double> rowBounds(const Trajectory & a, const Trajectory & b, const Band & band)
+      {
+          const std::vector<Vector> & u = a.vectors();
+          const std::vector<Vector> & v = b.vectors();
+          const std::vector<double> minX = bandExtremes(v, &Vector::x, band, std::less<double>());
+          const std::vector<double> maxX = bandExtremes(v, &Vector::x, band, std::greater<double>());
+          const std::vector<double> minY = bandExtremes(v, &Vector::y, band, std::less<double>());
+          const std::vector<double> maxY = bandExtremes(v, &Vector::y, band, std::greater<double>());
+          const std::vector<double> minZ = bandExtremes(v, &Vector::z, band, std::less<double>());
+          const std::vector<double> maxZ = bandExtremes(v, &Vector::z, band, std::greater<double>());
+
+          std::vector<double> bounds(u.size());
+          for (std::size_t i = 0; i < u.size(); ++i)
+          {
+              const double dx = std::max({0.0, minX[i] - u[i].x, u[i].x - maxX[i]});
+              const double dy = std::max({0.0, minY[i] - u[i].y, u[i].y - maxY[i]});
+              const double dz = std::max({0.0, minZ[i] - u[i].z, u[i].z - maxZ[i]});
+              bounds[i] = dx*dx + dy*dy + dz*dz;
+          }
+          bounds.front() = std::max(bounds.front(), chordSqr(u.front(), v.front()));
+          bounds.back() = std::max(bounds.back(), chordSqr(u.back(), v.back()));
+          return bounds;
+      }
+
+      /* The dynamic programme over the band, keeping two rows of the cost matrix (offset by
+       * one column, so that column -1 is infinite).  'cellCost' is the cost of aligning two
+       * points, and 'combine' adds it to the least cost of reaching the cell.  'abandonAbove'
+       * is in the units of the costs, and remaining[i] (if given) is a lower bound on what the
+       * rows after i add to the cost of a path.
+       */
+      template <typename CellCost, typename Combine>
+      double alignmentCost(const Trajectory & a, const Trajectory & b, const Band & band,
+                           double abandonAbove, const std::vector<double> * remaining,
+                           CellCost cellCost, Combine combine)
+      {
+          const std::vector<Vector> & u = a.vectors();
+          const std::vector<Vector> & v = b.vectors();
+          const std::size_t n = u.size(), m = v.size();
+
+          std::vector<double> previous(m + 1, infinity), current(m + 1, infinity);
+          previous[0] = 0; // the path starts at (0,0)
+          for (std::size_t i = 0; i < n; ++i)
+          {
+              const std::size_t first = band.first[i], last = band.last[i];
+              // The band's columns never move back, so the cells after it have never been
+              // written, and only the cell before it can hold a stale cost.
+              current[0] = infinity;
+              current[first] = infinity;
+
+              double rowLeast = infinity;
+              for (std::size_t j = first; j <= last; ++j)
+              {
+                  const double before = std::min({previous[j], previous[j+1], current[j]});
+                  const double cost = combine(cellCost(u[i], v[j]), before);
+                  current[j+1] = cost;
+                  rowLeast = std::min(rowLeast, cost);
+              }
+
+              // Every path crosses every row, and costs only grow along it.
+              if (remaining && combine((*remaining)[i], rowLeast) > abandonAbove) return infinity;
+
+              std::swap(previous, current);
+          }
+          return previous[m];
+      }
+
+      void validate(const Trajectory & a, const Trajectory & b, const SimilarityOptions & options)
+      {
+          if (a.empty() || b.empty())
+              throw std::invalid_argument("Cannot compare an empty trajectory.");
+          if (!(options.band >= 0))
+              throw std::invalid_argument("The Sakoe-Chiba band cannot be negative.");
+      }
+  }
+
+  Trajectory::Trajectory(const std::vector<Position> & positions)
+  {
+      points.reserve(positions.size());
+      for (const Position & position : positions)
+      {
+          const radians lat = degToRad(position.latitude());
+          const radians lon = degToRad(position.longitude());
+          points.push_back({std::cos(lat) * std::cos(lon), std::cos(lat) * std::sin(lon), std::sin(lat)});
+      }
+  }
+
+  metres trajectoryDistance(const Trajectory & a, const Trajectory & b, SimilarityOptions options, metres abandonAbove)
+  {
+      validate(a, b, options);
+      const Band band = sakoeChibaBand(a.size(), b.size(), options.band);
+      const bool abandoning = abandonAbove < infinity;
+      std::vector<double> remaining;
+
+      if (options.measure == SimilarityMeasure::DTW)
+      {
+          if (abandoning)
+          {
+              // remaining[i] is the sum of the bounds of rows i+1 onwards.
+              const std::vector<double> bounds = rowBounds(a, b, band);
+              remaining.resize(bounds.size());
+              metres sum = 0;
+              for (std::size_t i = bounds.size(); i-- > 0; )
+              {
+                  remaining[i] = sum;
+                  sum += arcLength(bounds[i]);
+              }
+          }
+          const metres distance = alignmentCost(a, b, band, abandonAbove, abandoning ? &remaining : nullptr,
+                                                [](const Vector & u, const Vector & v) { return arcLength(chordSqr(u, v)); },
+                                                [](double cost, double before) { return cost + before; });
+          return distance > abandonAbove ? infinity : distance;
+      }
+      else
+      {
+          // The Fréchet distance only compares distances, so the programme runs on squared chords.
+          if (abandoning)
+          {
+              // remaining[i] is the greatest bound of rows i+1 onwards.
+              const std::vector<double> bounds = rowBounds(a, b, band);
+              remaining.resize(bounds.size());
+              double greatest = 0;
+              for (std::size_t i = bounds.size(); i-- > 0; )
+              {
+                  remaining[i] = greatest;
+                  greatest = std::max(greatest, bounds[i]);
+              }
+          }
+          const double cost = alignmentCost(a, b, band, chordSqrOf(abandonAbove), abandoning ? &remaining : nullptr,
+                                            [](const Vector & u, const Vector & v) { return chordSqr(u, v); },
+                                            [](double cost, double before) { return std::max(cost, before); });
+          const metres distance = cost < infinity ? arcLength(cost) : infinity;
+          return distance > abandonAbove ? infinity : distance;
+      }
+  }
+
+  metres trajectoryLowerBound(const Trajectory & a, const Trajectory & b, SimilarityOptions options)
+  {
+      validate(a, b, options);
+      const std::vector<double> bounds = rowBounds(a, b, sakoeChibaBand(a.size(), b.size(), options.band));
+
+      if (options.measure == SimilarityMeasure::DTW)
+      {
+          metres sum = 0;
+          for (double bound : bounds) sum += arcLength(bound);
+          return sum;
+      }
+      else return arcLength(*std::max_element(bounds.begin(), bounds.end()));
+  }
+
+  TrajectoryMatch nearestTrajectory(const Trajectory & query, const std::vector<Trajectory> & candidates,
+                                    SimilarityOptions options)
+  {
+      if (candidates.empty())
+          throw std::invalid_argument("No candidate trajectories to compare with.");
+
+      std::vector<metres> bounds(candidates.size());
+      for (std::size_t k = 0; k < candidates.size(); ++k) bounds[k] = trajectoryLowerBound(query, candidates[k], options);
+
+      std::vector<std::size_t> order(candidates.size());
+      std::iota(order.begin(), order.end(), 0);
+      std::sort(order.begin(), order.end(), [&bounds](std::size_t k1, std::size_t k2) { return bounds[k1] < bounds[k2]; });
+
+      TrajectoryMatch nearest {order.front(), infinity};
+      for (std::size_t k : order)
+      {
+          if (bounds[k] >= nearest.distance) break;
+          const metres distance = trajectoryDistance(query, candidates[k], options, nearest.distance);
+          if (distance < nearest.distance) nearest = {k, distance};
+      }
+      return nearest;
+  }
+
+  std::vector<TrajectoryMatch> nearestTrajectories(const std::vector<Trajectory> & queries,
+                                                   const std::vector<Trajectory> & candidates,
+                                                   SimilarityOptions options, unsigned threads)
+  {
+      if (threads == 0) threads = std::thread::hardware_concurrency();
+
+      std::vector<TrajectoryMatch> matches(queries.size());
+      WorkStealingPool pool(threads);
+
+      for (std::size_t q = 0; q < queries.size(); ++q)
+      {
+          pool.submit([&queries, &candidates, &matches, options, q]
+          {
+              matches[q] = nearestTrajectory(queries[q], candidates, options);
+          });
+      }
+      pool.wait();
+      return matches;
+  }
+
+  std::vector<std::vector<metres>> distanceMatrix(const std::vector<Trajectory> & queries,
+                                                  const std::vector<Trajectory> & candidates,
+                                                  SimilarityOptions options, unsigned threads)
+  {
+      if (threads == 0) threads = std::thread::hardware_concurrency();
+
+      std::vector<std::vector<metres>> distances(queries.size(), std::vector<metres>(candidates.size()));
+      WorkStealingPool pool(threads);
+
+      for (std::size_t q = 0; q < queries.size(); ++q)
+      {
+          for (std::size_t k = 0; k < candidates.size(); ++k)
+          {
+              pool.submit([&queries, &candidates, &distances, options, q, k]
+              {
+                  distances[q][k] = trajectoryDistance(queries[q], candidates[k], options);
+              });
+          }
+      }
+      pool.wait();
+      return distances;
+  }
+}
@@ -0,0 +1,240 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <unordered_map>
+
+#include "geometry.h"
+#include "earth.h"
+#include "stops.h"
+
+namespace GPS
+{
+  namespace
+  {
+      // Horizontal distances are measured at zero elevation.
+      ECEF horizontalECEF(const Position & pos)
+      {
+          return toECEF(Position(pos.latitude(), pos.longitude()));
+      }
+
+      metres distanceSqr(const ECEF & p1, const ECEF & p2)
+      {
+          const metres dx = p1.x - p2.x, dy = p1.y - p2.y, dz = p1.z - p2.z;
+          return dx*dx + dy*dy + dz*dz;
+      }
+
+      // The square of the chord subtending a great-circle arc of 'distance' metres.
+      metres chordSqrOf(metres distance)
+      {
+          const metres chord = 2 * Earth::meanRadius * std::sin(distance / (2 * Earth::meanRadius));
+          // Allow for rounding, so that Positions exactly 'distance' apart count as within it.
+          return chord * chord * (1 + 1e-12);
+      }
+  }
+
+  StopDetector::StopDetector(metres radius, seconds minimumDwell)
+    : minimumDwell(minimumDwell)
+  {
+      if (radius <= 0) throw std::invalid_argument("Stop radius must be positive.");
+      if (minimumDwell < 0) throw std::invalid_argument("Minimum dwell time must not be negative.");
+      chordSqr = chordSqrOf(radius);
+  }
+
+  bool StopDetector::withinRadius(const ECEF & p1, const ECEF & p2) const
+  {
+      return distanceSqr(p1, p2) <= chordSqr;
+  }
+
+  bool StopDetector::reachesDwell(seconds last) const
+  {
+      return last - run.front().fix.time >= minimumDwell;
+  }
+
+  void StopDetector::becomeStop()
+  {
+      isStop = true;
+      lastTime = run.back().fix.time;
+      fixCount = run.size();
+      latitudeSum = longitudeSum = 0;
+      for (const Candidate & c : run)
+      {
+          latitudeSum += c.fix.position.latitude();
+          longitudeSum += c.fix.position.longitude();
+      }
+      run.erase(run.begin() + 1, run.end());
+  }
+
+  Stop StopDetector::currentStop() const
+  {
+      return { Position(latitudeSum / fixCount, longitudeSum / fixCount),
+               run.front().fix.time, lastTime, fixCount };
+  }
+
+  std::optional<Stop> StopDetector::add(const Fix & fix)
+  {
+      const Candidate next {fix, horizontalECEF(fix.position)};
+
+      if (!run.empty() && withinRadius(run.front().ecef, next.ecef))
+      {
+          if (isStop)
+          {
+              lastTime = fix.time;
+              ++fixCount;
+              latitudeSum += fix.position.latitude();
+              longitudeSum += fix.position.longitude();
+          }
+          else
+          {
+              run.push_back(next);
+              if (reachesDwell(fix.time)) becomeStop();
+          }
+          return std::nullopt;
+      }
+
+      std::optional<Stop> ended = finish();
+      if (!ended)
+      {
+          /* The run (if any) was too short to be a Stop.  Restart it from the first of its
+           * Fixes that has all of the later ones, and this Fix, within its radius.
+           */
+          while (!run.empty())
+          {
+              run.pop_front();
+              if (run.empty()) break;
+              const ECEF & first = run.front().ecef;
+              const bool allWithin = withinRadius(first, next.ecef) &&
+                  std::all_of(run.begin() + 1, run.end(), [&](const Candidate & c) { return withinRadius(first, c.ecef); });
+              if (allWithin) break;
+          }
+      }
+      run.push_back(next);
+      if (reachesDwell(fix.time) && run.size() > 1) becomeStop();
+      return ended;
+  }
+
+  std::optional<Stop> StopDetector::finish()
+  {
+      if (!isStop) return std::nullopt;
+      const Stop stop = currentStop();
+      isStop = false;
+      run.clear();
+      return stop;
+  }
+
+  std::vector<Stop> stopsFromFixes(const std::vector<Fix> & fixes, metres radius, seconds minimumDwell)
+  {
+      StopDetector detector(radius, minimumDwell);
+      std::vector<Stop> stops;
+      for (const Fix & fix : fixes)
+      {
+          if (std::optional<Stop> stop = detector.add(fix)) stops.push_back(*stop);
+      }
+      if (std::optional<Stop> stop = detector.finish()) stops.push_back(*stop);
+      return stops;
+  }
+
+  Clustering clusterPositions(const std::vector<Position> & positions, metres epsilon, std::size_t minimumPoints)
+  {
+      if (epsilon <= 0) throw std::invalid_argument("Cluster radius must be positive.");
+
+      Clustering result;
+      const std::size_t n = positions.size();
+      result.labels.assign(n, Clustering::noise);
+      if (n == 0) return result;
+
+      std::vector<ECEF> ecef(n);
+      for (std::size_t i = 0; i < n; ++i) ecef[i] = horizontalECEF(positions[i]);
+      const metres chordSqr = chordSqrOf(epsilon);
+
+      /* Cells must be wide enough that neighbours are always in adjacent cells.  By the
+       * law of haversines, Positions within 'epsilon' differ in latitude by at most
+       * epsilon/R radians, and in longitude by at most 2 asin(sin(epsilon/2R) / cos(lat)),
+       * where 'lat' is the latitude furthest from the equator.
+       */
+      degrees maxAbsLatitude = 0;
+      for (const Position & pos : positions) maxAbsLatitude = std::max(maxAbsLatitude, std::abs(pos.latitude()));
+      const double halfAngleSine = std::sin(epsilon / (2 * Earth::meanRadius)) / std::cos(degToRad(maxAbsLatitude));
+      if (halfAngleSine >= 1)
+          throw std::invalid_argument("Positions must not lie within the cluster radius of a pole.");
+      const degrees cellHeight = radToDeg(epsilon / Earth::meanRadius);
+      const degrees cellWidth = radToDeg(2 * std::asin(halfAngleSine));
+
+      auto cellOf = [&](const Position & pos)
+      {
+          return std::pair<std::int64_t,std::int64_t>(std::floor(pos.latitude() / cellHeight),
+                                                      std::floor(pos.longitude() / cellWidth));
+      };
+      auto key = [](std::int64_t row, std::int64_t column)
+      {
+          return (static_cast<std::uint64_t>(row) << 32) ^ static_cast<std::uint64_t>(column & 0xFFFFFFFF);
+      };
+
+      // Positions sorted by cell, with each cell's range in the sorted order.
+      std::vector<std::size_t> order(n);
+      std::vector<std::uint64_t> cellKeys(n);
+      for (std::size_t i = 0; i < n; ++i)
+      {
+          const auto [row, column] = cellOf(positions[i]);
+          cellKeys[i] = key(row, column);
+          order[i] = i;
+      }
+      std::sort(order.begin(), order.end(), [&](std::size_t i, std::size_t j) { return cellKeys[i] < cellKeys[j]; });
+      std::vector<ECEF> sortedECEF(n);
+      for (std::size_t k = 0; k < n; ++k) sortedECEF[k] = ecef[order[k]];
+      std::unordered_map<std::uint64_t,std::pair<std::size_t,std::size_t>> cells;
+      for (std::size_t begin = 0, end; begin < n; begin = end)
+      {
+          end = begin + 1;
+          while (end < n && cellKeys[order[end]] == cellKeys[order[begin]]) ++end;
+          cells.emplace(cellKeys[order[begin]], std::make_pair(begin, end));
+      }
+
+      std::vector<std::size_t> neighbours;
+      auto findNeighbours = [&](std::size_t i)
+      {
+          neighbours.clear();
+          const auto [row, column] = cellOf(positions[i]);
+          for (std::int64_t r = row - 1; r <= row + 1; ++r)
+          {
+              for (std::int64_t c = column - 1; c <= column + 1; ++c)
+              {
+                  const auto cell = cells.find(key(r, c));
+                  if (cell == cells.end()) continue;
+                  for (std::size_t k = cell->second.first; k < cell->second.second; ++k)
+                  {
+                      if (distanceSqr(ecef[i], sortedECEF[k]) <= chordSqr) neighbours.push_back(order[k]);
+                  }
+              }
+          }
+      };
+
+      std::vector<bool> visited(n, false);
+      std::vector<std::size_t> frontier;
+      for (std::size_t i = 0; i < n; ++i)
+      {
+          if (visited[i]) continue;
+          visited[i] = true;
+          findNeighbours(i);
+          if (neighbours.size() < minimumPoints) continue;
+
+          const int cluster = static_cast<int>(result.clusterCount++);
+          result.labels[i] = cluster;
+          frontier.assign(neighbours.begin(), neighbours.end());
+          while (!frontier.empty())
+          {
+              const std::size_t j = frontier.back();
+              frontier.pop_back();
+              if (result.labels[j] == Clustering::noise) result.labels[j] = cluster;
+              if (visited[j]) continue;
+              visited[j] = true;
+              findNeighbours(j);
+              if (neighbours.size() >= minimumPoints)
+              {
+                  frontier.insert(frontier.end(), neighbours.begin(), neighbours.end());
+              }
+          }
+      }
+      return result;
+  }
+}
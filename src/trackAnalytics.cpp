@@ -0,0 +1,59 @@
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+#include <thread>
+
+#include "parseNMEA.h"
+#include "workStealing.h"
+#include "trackAnalytics.h"
+
+namespace GPS
+{
+  TrackSummary summariseTrack(const std::vector<Position> & track)
+  {
+      TrackSummary summary;
+      summary.numPositions = track.size();
+      if (track.empty()) return summary;
+
+      summary.minLatitude  = summary.maxLatitude  = track.front().latitude();
+      summary.minLongitude = summary.maxLongitude = track.front().longitude();
+      summary.minElevation = summary.maxElevation = track.front().elevation();
+
+      for (std::size_t i = 1; i < track.size(); ++i)
+      {
+          const Position & pos = track[i];
+          summary.totalDistance += Position::horizontalDistanceBetween(track[i-1], pos);
+
+          summary.minLatitude  = std::min(summary.minLatitude,  pos.latitude());
+          summary.maxLatitude  = std::max(summary.maxLatitude,  pos.latitude());
+          summary.minLongitude = std::min(summary.minLongitude, pos.longitude());
+          summary.maxLongitude = std::max(summary.maxLongitude, pos.longitude());
+          summary.minElevation = std::min(summary.minElevation, pos.elevation());
+          summary.maxElevation = std::max(summary.maxElevation, pos.elevation());
+      }
+      return summary;
+  }
+
+  std::vector<TrackSummary> summariseLogs(const std::vector<std::string> & logFilePaths, unsigned threads)
+  {
+      if (threads == 0) threads = std::thread::hardware_concurrency();
+
+      std::vector<TrackSummary> summaries(logFilePaths.size());
+      WorkStealingPool pool(threads);
+
+      for (std::size_t i = 0; i < logFilePaths.size(); ++i)
+      {
+          pool.submit([&logFilePaths, &summaries, i]
+          {
+              std::ifstream log{logFilePaths[i]};
+              if (!log.good())
+                  throw std::invalid_argument("Could not open log file: " + logFilePaths[i]);
+
+              summaries[i] = summariseTrack(NMEA::positionsFromLog(log));
+              summaries[i].logFile = logFilePaths[i];
+          });
+      }
+      pool.wait();
+      return summaries;
+  }
+}
@@ -0,0 +1,116 @@
+#include <memory>
+#include <type_traits>
+
+#include "fixFilter.h"
+#include "trackStore.h"
+
+namespace GPS
+{
+  namespace
+  {
+      const std::size_t initialDirectoryCapacity = 16;
+
+      // Chunks are raw storage, as Fixes cannot be default constructed; nothing needs destroying.
+      static_assert(std::is_trivially_destructible_v<Fix>);
+      std::allocator<Fix> chunkAllocator;
+      std::allocator<seconds> timeAllocator;
+  }
+
+  std::pair<std::size_t, std::size_t> TrackSnapshot::indicesBetween(seconds from, seconds to) const
+  {
+      // The first index in [low, high) whose Fix is not before 'time' (or, if 'inclusive' is
+      // false, is after it), by binary search.
+      auto search = [this](std::size_t low, std::size_t high, seconds time, bool inclusive)
+      {
+          while (low < high)
+          {
+              const std::size_t middle = low + (high - low) / 2;
+              const seconds t = trackTime(middle);
+              if (t < time || (!inclusive && t == time)) low = middle + 1;
+              else high = middle;
+          }
+          return low;
+      };
+      if (to < from) return {0, 0};
+      const std::size_t first = search(0, count, from, true);
+
+      // Ranges are usually short, so the end is found by galloping from the start, which
+      // touches fewer (and nearer) Fixes than a second search of the whole track.
+      std::size_t low = first, step = 1;
+      while (low + step < count && trackTime(low + step) <= to)
+      {
+          low += step;
+          step *= 2;
+      }
+      return {first, search(low, std::min(low + step, count), to, false)};
+  }
+
+  std::vector<Fix> TrackSnapshot::fixes(std::size_t first, std::size_t last) const
+  {
+      std::vector<Fix> result;
+      if (first < std::min(last, count)) result.reserve(std::min(last, count) - first);
+      forEachSpan(first, last, [&result](std::span<const Fix> span) { result.insert(result.end(), span.begin(), span.end()); });
+      return result;
+  }
+
+  TrackStore::TrackStore()
+  {
+      directories.push_back(std::make_unique<Chunk []>(initialDirectoryCapacity));
+      directoryCapacity = initialDirectoryCapacity;
+      directory.store(directories.back().get(), std::memory_order_release);
+  }
+
+  TrackStore::~TrackStore()
+  {
+      for (const Chunk & chunk : chunks)
+      {
+          chunkAllocator.deallocate(chunk.fixes, chunkSize);
+          timeAllocator.deallocate(chunk.times, chunkSize);
+      }
+  }
+
+  void TrackStore::addChunk()
+  {
+      if (chunks.size() == directoryCapacity)
+      {
+          // Publish a larger copy of the directory; readers holding the old one still see valid chunks.
+          auto larger = std::make_unique<Chunk []>(directoryCapacity * 2);
+          std::copy(chunks.begin(), chunks.end(), larger.get());
+          directories.push_back(std::move(larger));
+          directoryCapacity *= 2;
+          directory.store(directories.back().get(), std::memory_order_release);
+      }
+      const Chunk chunk {chunkAllocator.allocate(chunkSize), timeAllocator.allocate(chunkSize)};
+      // No reader looks at this entry until a Fix in the chunk is published.
+      directories.back()[chunks.size()] = chunk;
+      chunks.push_back(chunk);
+  }
+
+  void TrackStore::append(const Fix & fix)
+  {
+      const std::size_t count = published.load(std::memory_order_relaxed);
+      const std::size_t offset = count % chunkSize;
+      if (count > 0)
+      {
+          // Counted on from the last Fix, as Resampler does, so that midnight adds a day.
+          const Fix & last = offset == 0 ? chunks.back().fixes[chunkSize - 1] : chunks.back().fixes[offset - 1];
+          lastTrackTime += elapsedTime(last.time, fix.time);
+      }
+      else
+      {
+          lastTrackTime = fix.time;
+      }
+      if (offset == 0) addChunk();
+      std::construct_at(chunks.back().fixes + offset, fix);
+      chunks.back().times[offset] = lastTrackTime;
+      published.store(count + 1, std::memory_order_release);
+  }
+
+  TrackSnapshot TrackStore::snapshot() const
+  {
+      // The count is loaded first: the directory loaded after it is at least as new as the
+      // one that was current when that count was published, so it lists every chunk needed.
+      const std::size_t count = published.load(std::memory_order_acquire);
+      return TrackSnapshot(directory.load(std::memory_order_acquire), count);
+  }
+}
@@ -0,0 +1,142 @@
+#include <utility>
+
+#include "workStealing.h"
+
+namespace GPS
+{
+  namespace
+  {
+      // The pool and index of the worker running on this thread, if any.
+      thread_local const WorkStealingPool * currentPool = nullptr;
+      thread_local unsigned currentWorker = 0;
+  }
+
+  WorkStealingPool::WorkStealingPool(unsigned threads)
+  {
+      if (threads == 0) threads = 1;
+      for (unsigned i = 0; i < threads; ++i)
+      {
+          queues.push_back(std::make_unique<WorkerQueue>());
+      }
+      for (unsigned i = 0; i < threads; ++i)
+      {
+          workers.emplace_back(&WorkStealingPool::runWorker, this, i);
+      }
+  }
+
+  WorkStealingPool::~WorkStealingPool()
+  {
+      {
+          std::unique_lock<std::mutex> lock(stateMutex);
+          allDone.wait(lock, [this]{ return unfinished == 0; });
+          stopping = true;
+      }
+      workAvailable.notify_all();
+      for (std::thread & worker : workers)
+      {
+          worker.join();
+      }
+  }
+
+  void WorkStealingPool::submit(Task task)
+  {
+      const unsigned target = (currentPool == this) ? currentWorker
+                                                    : nextQueue++ % queues.size();
+      {
+          /* Counted before the task is pushed, so that a worker taking it cannot decrement
+           * 'queued' first (wrapping it), and under the state mutex so that a worker about
+           * to sleep cannot miss it.
+           */
+          std::lock_guard<std::mutex> lock(stateMutex);
+          ++unfinished;
+          ++queued;
+      }
+      {
+          std::lock_guard<std::mutex> lock(queues[target]->mutex);
+          queues[target]->tasks.push_back(std::move(task));
+      }
+      workAvailable.notify_one();
+  }
+
+  void WorkStealingPool::wait()
+  {
+      std::unique_lock<std::mutex> lock(stateMutex);
+      allDone.wait(lock, [this]{ return unfinished == 0; });
+      if (firstError)
+      {
+          std::rethrow_exception(std::exchange(firstError, nullptr));
+      }
+  }
+
+  unsigned WorkStealingPool::threadCount() const
+  {
+      return static_cast<unsigned>(workers.size());
+  }
+
+  unsigned long WorkStealingPool::stealCount() const
+  {
+      return steals;
+  }
+
+  bool WorkStealingPool::takeTask(unsigned worker, Task & task)
+  {
+      {
+          WorkerQueue & own = *queues[worker];
+          std::lock_guard<std::mutex> lock(own.mutex);
+          if (!own.tasks.empty())
+          {
+              task = std::move(own.tasks.back());
+              own.tasks.pop_back();
+              --queued;
+              return true;
+          }
+      }
+      for (std::size_t offset = 1; offset < queues.size(); ++offset)
+      {
+          WorkerQueue & victim = *queues[(worker + offset) % queues.size()];
+          std::lock_guard<std::mutex> lock(victim.mutex);
+          if (!victim.tasks.empty())
+          {
+              task = std::move(victim.tasks.front());
+              victim.tasks.pop_front();
+              --queued;
+              ++steals;
+              return true;
+          }
+      }
+      return false;
+  }
+
+  void WorkStealingPool::runWorker(unsigned worker)
+  {
+      currentPool = this;
+      currentWorker = worker;
+
+      Task task;
+      while (true)
+      {
+          if (!takeTask(worker, task))
+          {
+              std::unique_lock<std::mutex> lock(stateMutex);
+              workAvailable.wait(lock, [this]{ return stopping || queued > 0; });
+              if (stopping && queued == 0) return;
+              continue;
+          }
+
+          std::exception_ptr error;
+          try
+          {
+              task();
+          }
+          catch (...)
+          {
+              error = std::current_exception();
+          }
+          task = nullptr;
+
+          std::lock_guard<std::mutex> lock(stateMutex);
+          if (error && !firstError) firstError = error;
+          if (--unfinished == 0) allDone.notify_all();
+      }
+  }
+}
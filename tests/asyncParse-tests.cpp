@@ -0,0 +1,107 @@
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+
+#include "logs.h"
+#include "parseNMEA.h"
+#include "asyncParse.h"
+
+using namespace GPS;
+using namespace NMEA;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( AsyncPositionsFromLog )
+
+const std::string validGLLSentence = "$GPGLL,5425.31,N,107.03,W,82610*69";
+const std::string validRMCSentence = "$GPRMC,113922.000,A,3722.5993,N,00559.2458,W,0.000,0.00,150914,,A*62";
+
+std::vector<Position> collect(std::istream & log, AsyncParseOptions options = {})
+{
+    std::vector<Position> positions;
+    for (const Position & pos : asyncPositionsFromLog(log, options))
+    {
+        positions.push_back(pos);
+    }
+    return positions;
+}
+
+void checkMatchesPositionsFromLog(std::string filename, AsyncParseOptions options)
+{
+    std::string logFilepath = LogFiles::NMEALogsDir + filename;
+    std::ifstream log1{logFilepath}, log2{logFilepath};
+    BOOST_REQUIRE_MESSAGE( log1.good() , "Could not open log file: " + logFilepath );
+
+    std::vector<Position> expected = positionsFromLog(log1);
+    std::vector<Position> positions = collect(log2, options);
+
+    BOOST_REQUIRE_EQUAL( positions.size() , expected.size() );
+    for (std::size_t i = 0; i < expected.size(); ++i)
+    {
+        BOOST_CHECK_EQUAL( positions[i].latitude() , expected[i].latitude() );
+        BOOST_CHECK_EQUAL( positions[i].longitude() , expected[i].longitude() );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( EmptyLog )
+{
+    std::stringstream log("");
+    BOOST_CHECK_EQUAL( collect(log).size() , 0u );
+}
+
+BOOST_AUTO_TEST_CASE( SkipsInvalidLines )
+{
+    std::stringstream log;
+    log << "@Sonygps/ver3.0/wgs-84/" << std::endl << std::endl;
+    log << validGLLSentence << std::endl;
+    log << "$GPGLL,5425.31,N,107.03,W,82610*24" << std::endl;
+    log << validRMCSentence << std::endl;
+
+    BOOST_CHECK_EQUAL( collect(log).size() , 2u );
+}
+
+BOOST_AUTO_TEST_CASE( FinalSentenceWithoutLineBreak )
+{
+    std::stringstream log;
+    log << validGLLSentence << std::endl << validRMCSentence;
+
+    BOOST_CHECK_EQUAL( collect(log).size() , 2u );
+}
+
+BOOST_AUTO_TEST_CASE( LargeLogsWithDefaultBlocks )
+{
+    checkMatchesPositionsFromLog("gll.log", {});
+    checkMatchesPositionsFromLog("gga_rmc-1.log", {});
+}
+
+BOOST_AUTO_TEST_CASE( SentencesStraddlingTinyBlocks )
+{
+    AsyncParseOptions options;
+    options.blockSize = 7;
+    options.queueDepth = 1;
+    checkMatchesPositionsFromLog("gga_rmc-2.log", options);
+}
+
+BOOST_AUTO_TEST_CASE( ConsumerStoppingEarly )
+{
+    std::ifstream log{LogFiles::NMEALogsDir + "gll.log"};
+    AsyncParseOptions options;
+    options.blockSize = 64;
+    options.queueDepth = 1;
+
+    unsigned count = 0;
+    for (const Position & pos : asyncPositionsFromLog(log, options))
+    {
+        (void)pos;
+        if (++count == 10) break; // the blocked reader must be released
+    }
+    BOOST_CHECK_EQUAL( count , 10u );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,142 @@
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+
+#include "logs.h"
+#include "parseNMEA.h"
+
+using namespace GPS;
+using namespace NMEA;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+// Count every heap allocation made by the test program.
+namespace
+{
+    std::atomic<unsigned long> heapAllocations{0};
+}
+
+void * operator new(std::size_t size)
+{
+    ++heapAllocations;
+    if (void * p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+// std::pmr::new_delete_resource() uses the aligned form.
+void * operator new(std::size_t size, std::align_val_t alignment)
+{
+    ++heapAllocations;
+    const std::size_t align = static_cast<std::size_t>(alignment);
+    if (void * p = std::aligned_alloc(align, (size + align - 1) / align * align)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void * p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void * p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void * p, std::align_val_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void * p, std::size_t, std::align_val_t) noexcept
+{
+    std::free(p);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( BatchParserTests )
+
+std::string readNMEAlogFile(std::string filename)
+{
+    std::string logFilepath = LogFiles::NMEALogsDir + filename;
+    std::ifstream log{logFilepath};
+    BOOST_REQUIRE_MESSAGE( log.good() , "Could not open log file: " + logFilepath );
+    std::stringstream contents;
+    contents << log.rdbuf();
+    return contents.str();
+}
+
+BOOST_AUTO_TEST_CASE( ArenaSentenceDataMatchesSentenceData )
+{
+    const std::string sentence = "$GPGGA,113922.000,3722.5993,N,00559.2458,W,1,0,,4.0,M,,M,,*40";
+    std::pmr::monotonic_buffer_resource arena;
+
+    SentenceData heapData = parseSentenceData(sentence);
+    ArenaSentenceData arenaData = parseSentenceData(std::string_view(sentence), &arena);
+
+    BOOST_CHECK_EQUAL( std::string_view(arenaData.format) , heapData.format );
+    BOOST_REQUIRE_EQUAL( arenaData.dataFields.size() , heapData.dataFields.size() );
+    for (std::size_t i = 0; i < heapData.dataFields.size(); ++i)
+    {
+        BOOST_CHECK_EQUAL( std::string_view(arenaData.dataFields[i]) , heapData.dataFields[i] );
+    }
+    BOOST_CHECK_EQUAL( interpretSentenceData(arenaData).latitude() , interpretSentenceData(heapData).latitude() );
+}
+
+BOOST_AUTO_TEST_CASE( SamePositionsAsPositionsFromLog )
+{
+    const std::string contents = readNMEAlogFile("gga_rmc-1.log");
+    std::stringstream log1(contents), log2(contents);
+
+    std::vector<Position> expected = positionsFromLog(log1);
+
+    BatchParser parser;
+    std::vector<Position> positions;
+    while (parser.parseBatch(log2, positions, 50)) {}
+
+    BOOST_REQUIRE_EQUAL( positions.size() , expected.size() );
+    for (std::size_t i = 0; i < expected.size(); ++i)
+    {
+        BOOST_CHECK_EQUAL( positions[i].latitude() , expected[i].latitude() );
+        BOOST_CHECK_EQUAL( positions[i].longitude() , expected[i].longitude() );
+        BOOST_CHECK_EQUAL( positions[i].elevation() , expected[i].elevation() );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( NoSteadyStateHeapAllocations )
+{
+    std::stringstream log(readNMEAlogFile("gga_rmc-1.log") + readNMEAlogFile("gll.log"));
+    const std::size_t batchSize = 50;
+
+    BatchParser parser;
+    std::vector<Position> positions;
+    positions.reserve(batchSize);
+
+    // The first batch sizes the line buffer.
+    parser.parseBatch(log, positions, batchSize);
+
+    unsigned long batches = 0;
+    const unsigned long allocationsBefore = heapAllocations;
+    while (true)
+    {
+        positions.clear();
+        const bool more = parser.parseBatch(log, positions, batchSize);
+        ++batches;
+        if (!more) break;
+    }
+    const unsigned long allocationsAfter = heapAllocations;
+
+    BOOST_CHECK_GT( batches , 10u );
+    BOOST_CHECK_EQUAL( allocationsAfter - allocationsBefore , 0u );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,128 @@
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+#include "geometry.h"
+#include "earth.h"
+#include "cartesian.h"
+
+using namespace GPS;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( Cartesian )
+
+const double percentageAccuracy = 0.0001; // 1 part in a million
+
+// All at sea level, since horizontalDistanceBetween() ignores elevation.
+const std::vector<Position> referencePositions = {
+    Earth::EquatorialMeridian, Earth::Pontianak, Position(Earth::CliftonCampus.latitude(), Earth::CliftonCampus.longitude()),
+    Position(45, 45), Position(-80, -120), Position(80, 170), Earth::NorthPole
+};
+
+// A sea-level Position offset from 'origin' by the given bearing and distance along the surface.
+Position offset(const Position & origin, degrees bearing, metres distance)
+{
+    const radians lat1 = degToRad(origin.latitude()), lon1 = degToRad(origin.longitude());
+    const radians theta = degToRad(bearing), delta = distance / Earth::meanRadius;
+    const radians lat2 = std::asin(std::sin(lat1) * std::cos(delta) + std::cos(lat1) * std::sin(delta) * std::cos(theta));
+    const radians lon2 = lon1 + std::atan2(std::sin(theta) * std::sin(delta) * std::cos(lat1),
+                                           std::cos(delta) - std::sin(lat1) * std::sin(lat2));
+    return Position(radToDeg(lat2), normaliseDeg(radToDeg(lon2)));
+}
+
+BOOST_AUTO_TEST_CASE( ECEFAxes )
+{
+    const ECEF meridian = toECEF(Earth::EquatorialMeridian);
+    const ECEF pole = toECEF(Earth::NorthPole);
+
+    BOOST_CHECK_CLOSE( meridian.x , Earth::meanRadius , percentageAccuracy );
+    BOOST_CHECK_SMALL( meridian.y , 1e-6 );
+    BOOST_CHECK_SMALL( meridian.z , 1e-6 );
+    BOOST_CHECK_SMALL( pole.x , 1e-6 );
+    BOOST_CHECK_CLOSE( pole.z , Earth::meanRadius , percentageAccuracy );
+}
+
+BOOST_AUTO_TEST_CASE( ECEFRoundTrip )
+{
+    for (const Position & pos : referencePositions)
+    {
+        const Position elevated(pos.latitude(), pos.longitude(), 123.4);
+        const Position back = fromECEF(toECEF(elevated));
+        BOOST_CHECK_SMALL( back.latitude() - elevated.latitude() , 1e-9 );
+        BOOST_CHECK_SMALL( normaliseDeg(back.longitude() - elevated.longitude()) * std::cos(degToRad(pos.latitude())) , 1e-9 );
+        BOOST_CHECK_SMALL( back.elevation() - elevated.elevation() , 1e-6 );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( ChordMatchesHaversine )
+{
+    for (const Position & origin : referencePositions)
+    {
+        for (metres distance : {10.0, 1000.0, 10000.0})
+        {
+            const Position other = offset(origin, 30, distance);
+            BOOST_CHECK_CLOSE( distanceBetween(toECEF(origin), toECEF(other)) ,
+                               Position::horizontalDistanceBetween(origin, other) , percentageAccuracy );
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( ENUMatchesHaversine )
+{
+    for (const Position & origin : referencePositions)
+    {
+        const LocalFrame frame(origin);
+        for (degrees bearing : {0.0, 90.0, 200.0})
+        {
+            const Position p1 = offset(origin, bearing, 1000);
+            const Position p2 = offset(origin, bearing + 45, 1500);
+            const ENU e1 = frame.toENU(p1), e2 = frame.toENU(p2);
+
+            BOOST_CHECK_CLOSE( pythagoras(e1.east, e1.north) , 1000 , percentageAccuracy );
+            BOOST_CHECK_CLOSE( pythagoras(e2.east - e1.east, e2.north - e1.north) ,
+                               Position::horizontalDistanceBetween(p1, p2) , 0.01 );
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( ENUDirections )
+{
+    const Position origin = referencePositions[2];
+    const LocalFrame frame(origin);
+    const ENU north = frame.toENU(offset(origin, 0, 100));
+    const ENU east = frame.toENU(offset(origin, 90, 100));
+    const ENU up = frame.toENU(Position(origin.latitude(), origin.longitude(), 10));
+
+    BOOST_CHECK_CLOSE( north.north , 100 , percentageAccuracy );
+    BOOST_CHECK_SMALL( north.east , 1e-6 );
+    BOOST_CHECK_CLOSE( east.east , 100 , percentageAccuracy );
+    BOOST_CHECK_CLOSE( up.up , 10 , percentageAccuracy );
+    BOOST_CHECK_SMALL( up.east , 1e-6 );
+}
+
+BOOST_AUTO_TEST_CASE( ENURoundTripAndBatch )
+{
+    const LocalFrame frame(Earth::CityCampus);
+    std::vector<Position> positions;
+    for (int i = 0; i < 8; ++i) positions.push_back(offset(Earth::CityCampus, 45 * i, 100 * i));
+    std::vector<ENU> enus(positions.size());
+
+    frame.toENU(positions.data(), enus.data(), positions.size());
+
+    for (std::size_t i = 0; i < positions.size(); ++i)
+    {
+        const ENU single = frame.toENU(positions[i]);
+        BOOST_CHECK_EQUAL( enus[i].east , single.east );
+        BOOST_CHECK_EQUAL( enus[i].north , single.north );
+
+        const Position back = frame.toPosition(enus[i]);
+        BOOST_CHECK_SMALL( back.latitude() - positions[i].latitude() , 1e-9 );
+        BOOST_CHECK_SMALL( back.longitude() - positions[i].longitude() , 1e-9 );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,155 @@
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "logs.h"
+#include "parseNMEA.h"
+#include "columnarExport.h"
+
+using namespace GPS;
+using namespace NMEA;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( ColumnarExportTests )
+
+std::string readNMEAlogFile(std::string filename)
+{
+    std::string logFilepath = LogFiles::NMEALogsDir + filename;
+    std::ifstream log{logFilepath};
+    BOOST_REQUIRE_MESSAGE( log.good() , "Could not open log file: " + logFilepath );
+    std::stringstream contents;
+    contents << log.rdbuf();
+    return contents.str();
+}
+
+BOOST_AUTO_TEST_CASE( EmptyFile )
+{
+    std::stringstream file;
+    {
+        ColumnarWriter writer(file);
+    }
+
+    ColumnarReader reader(file);
+    BOOST_CHECK_EQUAL( reader.rows() , 0u );
+    BOOST_CHECK_EQUAL( reader.batchCount() , 0u );
+    BOOST_CHECK( reader.formatDictionary().empty() );
+}
+
+BOOST_AUTO_TEST_CASE( LogThatFailsBeforeEnd )
+{
+    std::stringstream log("$GPGLL,5425.31,N,107.03,W,82610*69\n"), file;
+    log.setstate(std::ios::failbit);
+
+    BOOST_CHECK_EQUAL( exportColumnar(log, file) , 0u );
+}
+
+BOOST_AUTO_TEST_CASE( RoundTrip )
+{
+    const std::vector<Fix> fixes = {
+        {Position(51.5, -2.6, 10), 3600},
+        {Position(-37.1, 144.4), 3601.5},
+        {Position(0, 0, -3), 86399}
+    };
+    const std::vector<std::string> formats = {"GGA", "RMC", "GGA"};
+
+    std::stringstream file;
+    ColumnarWriter writer(file, 2);
+    for (std::size_t i = 0; i < fixes.size(); ++i) writer.append(fixes[i], formats[i]);
+    writer.finish();
+
+    ColumnarReader reader(file);
+    BOOST_REQUIRE_EQUAL( reader.rows() , 3u );
+    BOOST_REQUIRE_EQUAL( reader.batchCount() , 2u );
+    BOOST_REQUIRE_EQUAL( reader.formatDictionary().size() , 2u );
+
+    std::size_t row = 0;
+    for (std::size_t b = 0; b < reader.batchCount(); ++b)
+    {
+        const ColumnBatch batch = reader.readBatch(b);
+        for (std::size_t i = 0; i < batch.latitudes.size(); ++i, ++row)
+        {
+            BOOST_CHECK_EQUAL( batch.latitudes[i] , fixes[row].position.latitude() );
+            BOOST_CHECK_EQUAL( batch.longitudes[i] , fixes[row].position.longitude() );
+            BOOST_CHECK_EQUAL( batch.elevations[i] , fixes[row].position.elevation() );
+            BOOST_CHECK_EQUAL( batch.times[i] , fixes[row].time );
+            BOOST_CHECK_EQUAL( reader.formatDictionary()[batch.formats[i]] , formats[row] );
+        }
+    }
+    BOOST_CHECK_EQUAL( row , 3u );
+}
+
+BOOST_AUTO_TEST_CASE( BatchesAreAligned )
+{
+    std::stringstream file;
+    ColumnarWriter writer(file, 3);
+    for (int i = 0; i < 7; ++i) writer.append({Position(i, i), double(i)}, "GLL");
+    writer.finish();
+
+    ColumnarReader reader(file);
+    BOOST_REQUIRE_EQUAL( reader.batchCount() , 3u );
+    for (std::size_t b = 0; b < reader.batchCount(); ++b)
+    {
+        BOOST_CHECK_EQUAL( reader.readBatch(b).times.size() , b < 2 ? 3u : 1u );
+    }
+    BOOST_CHECK_EQUAL( reader.readBatch(2).latitudes[0] , 6 );
+}
+
+BOOST_AUTO_TEST_CASE( ExportMatchesFixesFromLog )
+{
+    const std::string contents = readNMEAlogFile("gga_rmc-1.log");
+    std::stringstream log1(contents), log2(contents), file;
+
+    const std::vector<Fix> fixes = fixesFromLog(log1);
+    const std::uint64_t rows = exportColumnar(log2, file, 100);
+
+    BOOST_REQUIRE_EQUAL( rows , fixes.size() );
+    ColumnarReader reader(file);
+    BOOST_REQUIRE_EQUAL( reader.rows() , fixes.size() );
+    BOOST_CHECK_EQUAL( reader.formatDictionary().size() , 2u );
+
+    std::size_t row = 0;
+    for (std::size_t b = 0; b < reader.batchCount(); ++b)
+    {
+        const ColumnBatch batch = reader.readBatch(b);
+        for (std::size_t i = 0; i < batch.times.size(); ++i, ++row)
+        {
+            BOOST_CHECK_EQUAL( batch.latitudes[i] , fixes[row].position.latitude() );
+            BOOST_CHECK_EQUAL( batch.times[i] , fixes[row].time );
+        }
+    }
+    // Pos 0: $GPGGA,094627.000,...  Pos 1: $GPRMC,094627.000,...
+    BOOST_CHECK_EQUAL( reader.formatDictionary()[reader.readBatch(0).formats[0]] , "GGA" );
+    BOOST_CHECK_EQUAL( reader.formatDictionary()[reader.readBatch(0).formats[1]] , "RMC" );
+}
+
+BOOST_AUTO_TEST_CASE( AppendAfterFinish )
+{
+    std::stringstream file;
+    ColumnarWriter writer(file);
+    writer.finish();
+
+    BOOST_CHECK_THROW( writer.append({Position(0, 0), 0}, "GLL") , std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_CASE( InvalidFiles )
+{
+    std::stringstream notColumnar("$GPGLL,5425.31,N,107.03,W,82610*69");
+    BOOST_CHECK_THROW( ColumnarReader reader(notColumnar) , std::invalid_argument );
+
+    std::stringstream file;
+    {
+        ColumnarWriter writer(file);
+        writer.append({Position(0, 0), 0}, "GLL");
+    }
+    std::stringstream truncated(file.str().substr(0, file.str().size() - 3));
+    BOOST_CHECK_THROW( ColumnarReader reader(truncated) , std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,177 @@
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <zlib.h>
+
+#include "logs.h"
+#include "parseNMEA.h"
+#include "compressedLog.h"
+
+using namespace GPS;
+using namespace NMEA;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( CompressedLogTests )
+
+std::string readNMEAlogFile(std::string filename)
+{
+    std::string logFilepath = LogFiles::NMEALogsDir + filename;
+    std::ifstream log{logFilepath};
+    BOOST_REQUIRE_MESSAGE( log.good() , "Could not open log file: " + logFilepath );
+    std::stringstream contents;
+    contents << log.rdbuf();
+    return contents.str();
+}
+
+// Compresses 'text' as a single gzip member.
+std::string gzip(const std::string & text)
+{
+    z_stream z {};
+    BOOST_REQUIRE_EQUAL( deflateInit2(&z, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 16 + MAX_WBITS, 8, Z_DEFAULT_STRATEGY) , Z_OK );
+    std::string compressed(deflateBound(&z, text.size()), '\0');
+    z.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(text.data()));
+    z.avail_in = text.size();
+    z.next_out = reinterpret_cast<Bytef *>(compressed.data());
+    z.avail_out = compressed.size();
+    BOOST_REQUIRE_EQUAL( deflate(&z, Z_FINISH) , Z_STREAM_END );
+    compressed.resize(z.total_out);
+    deflateEnd(&z);
+    return compressed;
+}
+
+std::string readAll(std::istream & in)
+{
+    std::stringstream contents;
+    contents << in.rdbuf();
+    return contents.str();
+}
+
+void checkSamePositions(const std::vector<Position> & positions, const std::vector<Position> & expected)
+{
+    BOOST_REQUIRE_EQUAL( positions.size() , expected.size() );
+    for (std::size_t i = 0; i < expected.size(); ++i)
+    {
+        BOOST_CHECK_EQUAL( positions[i].latitude() , expected[i].latitude() );
+        BOOST_CHECK_EQUAL( positions[i].longitude() , expected[i].longitude() );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( DecompressesGzip )
+{
+    const std::string contents = readNMEAlogFile("gga_rmc-1.log");
+    std::stringstream compressed(gzip(contents));
+
+    DecompressingStream log(compressed);
+
+    BOOST_CHECK( readAll(log) == contents );
+}
+
+BOOST_AUTO_TEST_CASE( SmallBlocks )
+{
+    // Blocks much smaller than a sentence, to exercise every boundary.
+    const std::string contents = readNMEAlogFile("gll.log");
+    std::stringstream compressed(gzip(contents));
+
+    DecompressingStream log(compressed, AsyncParseOptions{7, 2});
+
+    BOOST_CHECK( readAll(log) == contents );
+}
+
+BOOST_AUTO_TEST_CASE( UncompressedPassesThrough )
+{
+    const std::string contents = readNMEAlogFile("gll.log");
+    std::stringstream plain(contents);
+
+    DecompressingStream log(plain);
+
+    BOOST_CHECK( readAll(log) == contents );
+}
+
+BOOST_AUTO_TEST_CASE( ConcatenatedMembers )
+{
+    const std::string part1 = readNMEAlogFile("gll.log");
+    const std::string part2 = readNMEAlogFile("gga_rmc-1.log");
+    std::stringstream compressed(gzip(part1) + gzip(part2));
+
+    DecompressingStream log(compressed, AsyncParseOptions{1000, 4});
+
+    BOOST_CHECK( readAll(log) == part1 + part2 );
+}
+
+BOOST_AUTO_TEST_CASE( PositionsFromCompressedLog )
+{
+    const std::string contents = readNMEAlogFile("gga_rmc-1.log");
+    std::stringstream plain(contents), compressed(gzip(contents));
+
+    DecompressingStream log(compressed);
+
+    checkSamePositions(positionsFromLog(log), positionsFromLog(plain));
+}
+
+BOOST_AUTO_TEST_CASE( AsyncPipeline )
+{
+    const std::string contents = readNMEAlogFile("gga_rmc-1.log");
+    std::stringstream plain(contents), compressed(gzip(contents));
+
+    std::vector<Position> positions;
+    for (const Position & pos : asyncPositionsFromCompressedLog(compressed, AsyncParseOptions{4096, 2}))
+    {
+        positions.push_back(pos);
+    }
+
+    checkSamePositions(positions, positionsFromLog(plain));
+}
+
+BOOST_AUTO_TEST_CASE( ConsumerCanStopEarly )
+{
+    std::stringstream compressed(gzip(readNMEAlogFile("gga_rmc-1.log")));
+
+    std::size_t count = 0;
+    for (const Position & pos : asyncPositionsFromCompressedLog(compressed, AsyncParseOptions{256, 1}))
+    {
+        (void) pos;
+        if (++count == 5) break;
+    }
+
+    BOOST_CHECK_EQUAL( count , 5u );
+}
+
+BOOST_AUTO_TEST_CASE( TruncatedGzipThrows )
+{
+    const std::string compressed = gzip(readNMEAlogFile("gga_rmc-1.log"));
+    std::stringstream truncated(compressed.substr(0, compressed.size() / 2));
+
+    DecompressingStream log(truncated);
+
+    BOOST_CHECK_THROW( positionsFromLog(log) , std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_CASE( CorruptGzipThrows )
+{
+    std::string compressed = gzip(readNMEAlogFile("gga_rmc-1.log"));
+    for (std::size_t i = 20; i < 40; ++i) compressed[i] = '\xFF';
+    std::stringstream corrupt(compressed);
+
+    std::vector<Position> positions;
+    BOOST_CHECK_THROW( for (const Position & pos : asyncPositionsFromCompressedLog(corrupt)) positions.push_back(pos) ,
+                       std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_CASE( ZstdIsReported )
+{
+    std::stringstream zstd(std::string("\x28\xB5\x2F\xFD", 4) + "rest of frame");
+
+    DecompressingStream log(zstd);
+
+    BOOST_CHECK_THROW( positionsFromLog(log) , std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,218 @@
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "logs.h"
+#include "parseNMEA.h"
+#include "compressedTrack.h"
+
+using namespace GPS;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( CompressedTrackTests )
+
+const degrees halfUnit = 0.5 / (60 * 100000);
+
+std::vector<Fix> logFixes(const std::string & filename)
+{
+    std::string logFilepath = LogFiles::NMEALogsDir + filename;
+    std::ifstream log{logFilepath};
+    BOOST_REQUIRE_MESSAGE( log.good() , "Could not open log file: " + logFilepath );
+    return NMEA::fixesFromLog(log);
+}
+
+CompressedTrack compressed(const std::vector<Fix> & fixes)
+{
+    CompressedTrack track;
+    for (const Fix & fix : fixes) track.append(fix);
+    return track;
+}
+
+// Whether 'decoded' is 'original' at the stored resolution.
+bool matches(const Fix & decoded, const Fix & original)
+{
+    return std::abs(decoded.position.latitude() - original.position.latitude()) <= halfUnit
+        && std::abs(decoded.position.longitude() - original.position.longitude()) <= halfUnit
+        && std::abs(decoded.position.elevation() - original.position.elevation()) <= 0.005 + 1e-9
+        && std::abs(decoded.time - original.time) <= 0.0005 + 1e-9;
+}
+
+bool allMatch(const std::vector<Fix> & decoded, const std::vector<Fix> & original)
+{
+    return decoded.size() == original.size()
+        && std::equal(decoded.begin(), decoded.end(), original.begin(), matches);
+}
+
+bool identical(const std::vector<Fix> & a, const std::vector<Fix> & b)
+{
+    return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [](const Fix & x, const Fix & y)
+    {
+        return x.position.latitude() == y.position.latitude() && x.position.longitude() == y.position.longitude()
+            && x.position.elevation() == y.position.elevation() && x.time == y.time;
+    });
+}
+
+BOOST_AUTO_TEST_CASE( EmptyTrack )
+{
+    CompressedTrack track;
+    track.seal();
+
+    BOOST_CHECK_EQUAL( track.size(), 0 );
+    BOOST_CHECK_EQUAL( track.chunkCount(), 0 );
+    BOOST_CHECK( track.fixes().empty() );
+    BOOST_CHECK( track.fixesBetween(0, 86400).empty() );
+}
+
+BOOST_AUTO_TEST_CASE( RoundTripsLogs )
+{
+    for (std::string filename : {"gga_rmc-1.log", "gga_rmc-2.log", "gll.log"})
+    {
+        const std::vector<Fix> original = logFixes(filename);
+        CompressedTrack track = compressed(original);
+        BOOST_CHECK_MESSAGE( allMatch(track.fixes(), original) , filename );
+        track.seal();
+        const std::vector<Fix> decoded = track.fixes();
+        BOOST_CHECK_MESSAGE( allMatch(decoded, original) , filename );
+
+        // Decoded Fixes are already at the stored resolution, so compress without change.
+        BOOST_CHECK_MESSAGE( identical(compressed(decoded).fixes(), decoded) , filename );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( CompressesLogs )
+{
+    // The three logs in one track, so that most chunks are full.
+    std::vector<Fix> original;
+    for (std::string filename : {"gga_rmc-1.log", "gga_rmc-2.log", "gll.log"})
+    {
+        const std::vector<Fix> fixes = logFixes(filename);
+        original.insert(original.end(), fixes.begin(), fixes.end());
+    }
+    CompressedTrack track = compressed(original);
+    track.seal();
+
+    BOOST_CHECK_LT( static_cast<double>(track.bytesUsed()) / track.size(), 4.0 );
+}
+
+BOOST_AUTO_TEST_CASE( ChunksAndPendingFixes )
+{
+    std::vector<Fix> original;
+    for (int i = 0; i < 2500; ++i) original.push_back({Position(52.9 + i * 1e-5, -1.2 - i * 2e-5, 58 + i % 7), 36000 + i * 0.2});
+    CompressedTrack track = compressed(original);
+
+    BOOST_CHECK_EQUAL( track.size(), 2500 );
+    BOOST_CHECK_EQUAL( track.chunkCount(), 3 );
+    BOOST_CHECK_EQUAL( track.summary(2).count, 2500 - 2 * CompressedTrack::chunkSize );
+    BOOST_CHECK( allMatch(track.fixes(), original) );
+
+    track.seal();
+    track.append(original.front());
+    BOOST_CHECK_EQUAL( track.chunkCount(), 4 );
+    BOOST_CHECK_EQUAL( track.size(), 2501 );
+}
+
+BOOST_AUTO_TEST_CASE( ExtremeValues )
+{
+    // Poles, the anti-meridian, jumps that need 64-bit codes, times out of order, and a
+    // time beyond 2^51 milliseconds.
+    const std::vector<Fix> original {
+        {Position(90, 180, 8848.86), 0}, {Position(-90, -180, -430.5), 86399.999},
+        {Position(0, 0, 0), 0.001}, {Position(45.123456, -179.999999, 1e6), 43200},
+        {Position(45.123456, -179.999999, 1e6), 43200}, {Position(-0.000001, 0.000001, -1e6), 1e7},
+        {Position(89.999999, 179.999999, 0), -1}, {Position(1, 1, 1), 3e12 + 0.125}
+    };
+    CompressedTrack track = compressed(original);
+    track.seal();
+
+    BOOST_CHECK( allMatch(track.fixes(), original) );
+}
+
+BOOST_AUTO_TEST_CASE( ColumnsMatchFixes )
+{
+    // Full chunks and Fixes held uncompressed, then the same after sealing.
+    std::vector<Fix> original = logFixes("gga_rmc-1.log");
+    for (int i = 0; i < 1500; ++i) original.push_back({Position(52.9 + i * 1e-5, -1.2 - i * 2e-5, 58 + i % 7), 36000 + i * 0.2});
+    CompressedTrack track = compressed(original);
+
+    for (int sealed = 0; sealed < 2; ++sealed)
+    {
+        const std::vector<Fix> fixes = track.fixes();
+        const FixColumns columns = track.columns();
+        BOOST_REQUIRE_EQUAL( columns.size(), fixes.size() );
+        BOOST_REQUIRE_EQUAL( columns.latitudes.size(), fixes.size() );
+        BOOST_REQUIRE_EQUAL( columns.longitudes.size(), fixes.size() );
+        BOOST_REQUIRE_EQUAL( columns.elevations.size(), fixes.size() );
+        std::vector<Fix> rebuilt;
+        for (std::size_t i = 0; i < columns.size(); ++i) rebuilt.push_back(columns.fix(i));
+        BOOST_CHECK( identical(rebuilt, fixes) );
+        track.seal();
+    }
+
+    // Appending to existing columns.
+    FixColumns columns;
+    for (std::size_t chunk = 0; chunk < track.chunkCount(); ++chunk) track.decodeChunkColumns(chunk, columns);
+    BOOST_CHECK_EQUAL( columns.size(), original.size() );
+    BOOST_CHECK_EQUAL( columns.times.back(), track.fixes().back().time );
+}
+
+BOOST_AUTO_TEST_CASE( Summaries )
+{
+    const std::vector<Fix> original = logFixes("gga_rmc-2.log");
+    const CompressedTrack track = compressed(original);
+
+    for (std::size_t chunk = 0; chunk < track.chunkCount(); ++chunk)
+    {
+        const ChunkSummary summary = track.summary(chunk);
+        std::vector<Fix> fixes;
+        track.decodeChunk(chunk, fixes);
+        BOOST_REQUIRE_EQUAL( fixes.size(), summary.count );
+
+        const auto [earliest, latest] = std::minmax_element(fixes.begin(), fixes.end(),
+                                                            [](const Fix & a, const Fix & b) { return a.time < b.time; });
+        BOOST_CHECK_EQUAL( summary.earliest, earliest->time );
+        BOOST_CHECK_EQUAL( summary.latest, latest->time );
+        for (const Fix & fix : fixes)
+        {
+            BOOST_CHECK( fix.position.latitude() >= summary.minLatitude && fix.position.latitude() <= summary.maxLatitude );
+            BOOST_CHECK( fix.position.longitude() >= summary.minLongitude && fix.position.longitude() <= summary.maxLongitude );
+            BOOST_CHECK( fix.position.elevation() >= summary.minElevation && fix.position.elevation() <= summary.maxElevation );
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( RangeQueries )
+{
+    // A day of Fixes a second apart, drifting north-east.
+    CompressedTrack track;
+    for (int i = 0; i < 86400; ++i) track.append({Position(52 + i * 1e-5, -2 + i * 1e-5, 100), static_cast<seconds>(i)});
+    const std::vector<Fix> all = track.fixes();
+
+    auto between = [&](seconds from, seconds to)
+    {
+        std::vector<Fix> expected;
+        std::copy_if(all.begin(), all.end(), std::back_inserter(expected),
+                     [=](const Fix & fix) { return fix.time >= from && fix.time <= to; });
+        return expected;
+    };
+    BOOST_CHECK( identical(track.fixesBetween(3000.5, 5000), between(3000.5, 5000)) );
+    BOOST_CHECK_EQUAL( track.fixesBetween(3000.5, 5000).size(), 2000 );
+    BOOST_CHECK_EQUAL( track.fixesBetween(86399, 1e6).size(), 1 );
+    BOOST_CHECK( track.fixesBetween(90000, 1e6).empty() );
+
+    const std::vector<Fix> within = track.fixesWithin(Position(52.1, -2), Position(52.2, -1.85));
+    BOOST_CHECK_EQUAL( within.size(), 5001 );
+    BOOST_CHECK( std::all_of(within.begin(), within.end(), [](const Fix & fix)
+    {
+        return fix.position.latitude() >= 52.1 && fix.position.longitude() <= -1.85;
+    }) );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,141 @@
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "logs.h"
+#include "earth.h"
+#include "parseNMEA.h"
+#include "densityGrid.h"
+
+using namespace GPS;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( DensityGridTests )
+
+const Position southWest(52.9, -1.2);
+const Position northEast(53.0, -1.1);
+
+BOOST_AUTO_TEST_CASE( InvalidGrids )
+{
+    BOOST_CHECK_THROW( DensityGrid(southWest, northEast, 0) , std::invalid_argument );
+    BOOST_CHECK_THROW( DensityGrid(northEast, southWest, 100) , std::invalid_argument );
+    BOOST_CHECK_THROW( DensityGrid(southWest, Position(53.0, -1.2), 100) , std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_CASE( CellSizesInMetres )
+{
+    const metres cellSize = 1000;
+    DensityGrid grid(southWest, northEast, cellSize);
+
+    // 0.1 degrees of latitude is about 11.1km; 0.1 degrees of longitude at 53N is about 6.7km.
+    BOOST_CHECK_EQUAL( grid.rows(), 12 );
+    BOOST_CHECK_EQUAL( grid.columns(), 7 );
+}
+
+BOOST_AUTO_TEST_CASE( BinsPositions )
+{
+    DensityGrid grid(southWest, northEast, 1000);
+
+    grid.add(southWest);                   // south-west corner cell
+    grid.add(Position(52.9001, -1.1999));  // same cell
+    grid.add(Position(52.91, -1.2));       // 1.1km north: next row
+    grid.add(Position(52.9, -1.18));       // 1.3km east: next column
+    grid.add(Position(52.8, -1.15));       // south of the grid
+    grid.add(Position(52.95, -1.0));       // east of the grid
+
+    BOOST_CHECK_EQUAL( grid.count(0, 0), 2 );
+    BOOST_CHECK_EQUAL( grid.count(1, 0), 1 );
+    BOOST_CHECK_EQUAL( grid.count(0, 1), 1 );
+    BOOST_CHECK_EQUAL( grid.total(), 4 );
+    BOOST_CHECK_EQUAL( grid.outside(), 2 );
+    BOOST_CHECK_THROW( grid.count(grid.rows(), 0) , std::out_of_range );
+}
+
+BOOST_AUTO_TEST_CASE( GridExtendsToWholeCells )
+{
+    const metres oneDegreeOfLatitude = Earth::polarCircumference / 360;
+    DensityGrid grid(Position(0, 0), Position(0.9, 0.9), oneDegreeOfLatitude);
+
+    grid.add(Position(0.95, 0.95)); // beyond the corner, but in the only cell
+    grid.add(Position(1.01, 0.5));
+
+    BOOST_CHECK_EQUAL( grid.rows(), 1 );
+    BOOST_CHECK_EQUAL( grid.columns(), 1 );
+    BOOST_CHECK_EQUAL( grid.count(0, 0), 1 );
+    BOOST_CHECK_EQUAL( grid.outside(), 1 );
+}
+
+BOOST_AUTO_TEST_CASE( ParallelBinningMatchesSequential )
+{
+    std::string logFilepath = LogFiles::NMEALogsDir + "gga_rmc-1.log";
+    std::ifstream log{logFilepath};
+    BOOST_REQUIRE_MESSAGE( log.good() , "Could not open log file: " + logFilepath );
+    const std::vector<Position> logPositions = NMEA::positionsFromLog(log);
+    BOOST_REQUIRE( !logPositions.empty() );
+
+    // Enough copies that every thread gets a share.
+    std::vector<Position> positions;
+    while (positions.size() < (1 << 18)) positions.insert(positions.end(), logPositions.begin(), logPositions.end());
+
+    const auto [minLat, maxLat] = std::minmax_element(logPositions.begin(), logPositions.end(),
+        [](const Position & p1, const Position & p2) { return p1.latitude() < p2.latitude(); });
+    const auto [minLon, maxLon] = std::minmax_element(logPositions.begin(), logPositions.end(),
+        [](const Position & p1, const Position & p2) { return p1.longitude() < p2.longitude(); });
+    // Trim the eastern edge, so some Positions fall outside.
+    const Position sw(minLat->latitude(), minLon->longitude());
+    const Position ne(maxLat->latitude(), (minLon->longitude() + maxLon->longitude()) / 2);
+
+    DensityGrid sequential(sw, ne, 50);
+    for (const Position & pos : positions) sequential.add(pos);
+
+    DensityGrid parallel(sw, ne, 50);
+    parallel.add(positions, 4);
+
+    BOOST_CHECK_EQUAL( parallel.total(), sequential.total() );
+    BOOST_CHECK_EQUAL( parallel.outside(), sequential.outside() );
+    BOOST_CHECK_GT( sequential.outside(), 0 );
+    BOOST_CHECK_EQUAL( sequential.total() + sequential.outside(), positions.size() );
+    for (std::size_t r = 0; r < sequential.rows(); ++r)
+        for (std::size_t c = 0; c < sequential.columns(); ++c)
+            BOOST_REQUIRE_EQUAL( parallel.count(r, c), sequential.count(r, c) );
+}
+
+BOOST_AUTO_TEST_CASE( EightBitPGM )
+{
+    DensityGrid grid(Position(0, 0), Position(1.9, 2.9), Earth::polarCircumference / 360);
+    grid.add(Position(0.5, 0.5));
+    grid.add(Position(0.5, 0.5));
+    grid.add(Position(1.5, 2.5));
+
+    std::ostringstream image;
+    grid.writePGM(image);
+
+    // North at the top: the northern row comes first.
+    const std::string expected = std::string("P5\n3 2\n2\n") + '\0' + '\0' + '\1' + '\2' + '\0' + '\0';
+    BOOST_CHECK( image.str() == expected );
+}
+
+BOOST_AUTO_TEST_CASE( SixteenBitPGM )
+{
+    DensityGrid grid(Position(0, 0), Position(0.9, 1.9), Earth::polarCircumference / 360);
+    for (int i = 0; i < 1000; ++i) grid.add(Position(0.5, 0.5));
+    for (int i = 0; i < 500; ++i) grid.add(Position(0.5, 1.5));
+
+    std::ostringstream image;
+    grid.writePGM(image);
+
+    const std::string header = "P5\n2 1\n65535\n";
+    const std::string expected = header + '\xFF' + '\xFF' + '\x80' + '\x00';
+    BOOST_CHECK( image.str() == expected );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
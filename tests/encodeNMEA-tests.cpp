@@ -0,0 +1,125 @@
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <fstream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "logs.h"
+#include "parseNMEA.h"
+#include "encodeNMEA.h"
+
+using namespace GPS;
+using namespace NMEA;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( EncodeSentenceTests )
+
+const Fix sevilla { Position(37.38603667, -5.99298, 30), 9*3600 + 46*60 + 27 };
+
+// Parses an encoded sentence back into a Fix.
+Fix roundTrip(std::string_view format, const Fix & fix)
+{
+    const std::string sentence = encodeSentence(format, fix);
+    BOOST_REQUIRE_MESSAGE( isWellFormedSentence(sentence) , sentence );
+    BOOST_REQUIRE_MESSAGE( hasCorrectChecksum(sentence) , sentence );
+    const std::optional<Fix> parsed = fixFromLine(sentence);
+    BOOST_REQUIRE_MESSAGE( parsed.has_value() , sentence );
+    return *parsed;
+}
+
+BOOST_AUTO_TEST_CASE( MatchesReceiverOutput )
+{
+    // The first fix of gga_rmc-1.log.
+    const std::string gga = encodeSentence("GGA", sevilla);
+    const std::string rmc = encodeSentence("RMC", sevilla);
+    const std::string gll = encodeSentence("GLL", sevilla);
+
+    BOOST_CHECK_EQUAL( gga.substr(0, gga.find('*')), "$GPGGA,094627.000,3723.1622,N,00559.5788,W,1,08,1.0,30.0,M,0.0,M,," );
+    BOOST_CHECK_EQUAL( rmc.substr(0, rmc.find('*')), "$GPRMC,094627.000,A,3723.1622,N,00559.5788,W,0.000,0.00,,,A" );
+    BOOST_CHECK_EQUAL( gll.substr(0, gll.find('*')), "$GPGLL,3723.1622,N,00559.5788,W,094627.000" );
+}
+
+BOOST_AUTO_TEST_CASE( WritesIntoBuffer )
+{
+    char buffer[maxEncodedSentenceLength];
+    const std::size_t length = encodeSentence("GGA", sevilla, 0, buffer);
+
+    BOOST_CHECK_EQUAL( buffer[length - 1], '\n' );
+    BOOST_CHECK_EQUAL( std::string(buffer, length - 1), encodeSentence("GGA", sevilla) );
+}
+
+BOOST_AUTO_TEST_CASE( UnsupportedFormat )
+{
+    BOOST_CHECK_THROW( encodeSentence("ZDA", sevilla) , std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_CASE( RoundTripsEveryHemisphere )
+{
+    for (const Position pos : {Position(51.5, -0.1, 12.3), Position(-33.8688, 151.2093, -4.5),
+                               Position(0, 0, 0), Position(-89.9999, -179.9999, 8848.8), Position(90, 180, 0)})
+    {
+        for (const char * format : {"GLL", "GGA", "RMC"})
+        {
+            const Fix parsed = roundTrip(format, {pos, 45296.789});
+            BOOST_CHECK_SMALL( parsed.position.latitude() - pos.latitude(), 1e-6 );
+            BOOST_CHECK_SMALL( parsed.position.longitude() - pos.longitude(), 1e-6 );
+            BOOST_CHECK_SMALL( parsed.time - 45296.789, 1e-6 );
+        }
+        BOOST_CHECK_SMALL( roundTrip("GGA", {pos, 0}).position.elevation() - pos.elevation(), 0.05 );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( RoundingCarries )
+{
+    // 59.99999 minutes rounds up into the next degree; 59.9999 seconds into the next day.
+    const Fix parsed = roundTrip("GGA", {Position(52.9999999, -1.9999999), 86399.9999});
+
+    BOOST_CHECK_EQUAL( encodeSentence("GLL", {Position(52.9999999, -1.9999999), 86399.9999}).substr(0, 42),
+                       "$GPGLL,5300.0000,N,00200.0000,W,000000.000" );
+    BOOST_CHECK_EQUAL( parsed.time, 0 );
+}
+
+BOOST_AUTO_TEST_CASE( GroundSpeed )
+{
+    const std::optional<LazySentence> sentence = LazySentence::fromLine(encodeSentence("RMC", sevilla, 12.5));
+
+    BOOST_REQUIRE( sentence.has_value() );
+    BOOST_CHECK_CLOSE( sentence->groundSpeed(), 12.5, 0.001 );
+}
+
+BOOST_AUTO_TEST_CASE( ReencodesLog )
+{
+    std::string logFilepath = LogFiles::NMEALogsDir + "gga_rmc-1.log";
+    std::ifstream log{logFilepath};
+    BOOST_REQUIRE_MESSAGE( log.good() , "Could not open log file: " + logFilepath );
+
+    std::string line;
+    unsigned count = 0;
+    while (std::getline(log, line))
+    {
+        const std::optional<LazySentence> original = LazySentence::fromLine(line);
+        if (!original || !isSupportedSentenceFormat(original->format())) continue;
+        const bool rmc = original->format() == "RMC";
+        const Fix fix {original->position(), original->time()};
+        const std::string reencoded = encodeSentence(original->format(), fix, rmc ? original->groundSpeed() : 0);
+
+        // The time, coordinates, and speed or elevation, are written as the receiver wrote them.
+        const SentenceData expected = parseSentenceData(line);
+        const SentenceData actual = parseSentenceData(reencoded);
+        static const std::vector<std::size_t> rmcFields {0, 2, 3, 4, 5, 6}, ggaFields {0, 1, 2, 3, 4, 8};
+        for (std::size_t field : rmc ? rmcFields : ggaFields)
+        {
+            BOOST_CHECK_EQUAL( actual.dataFields[field], expected.dataFields[field] );
+        }
+        ++count;
+    }
+    BOOST_CHECK_GT( count, 600 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,143 @@
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <cmath>
+#include <functional>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <fstream>
+
+#include "logs.h"
+#include "earth.h"
+#include "parseNMEA.h"
+#include "encodeNMEA.h"
+#include "fixFilter.h"
+
+using namespace GPS;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( JumpFilterTests )
+
+// A Position 'north' metres due north of CliftonCampus.
+Position northOfClifton(metres north)
+{
+    return Position(Earth::CliftonCampus.latitude() + Earth::latitudeSubtendedBy(north),
+                    Earth::CliftonCampus.longitude());
+}
+
+BOOST_AUTO_TEST_CASE( ElapsedTimeAcrossMidnight )
+{
+    BOOST_CHECK_EQUAL( elapsedTime(100, 160) , 60 );
+    BOOST_CHECK_EQUAL( elapsedTime(86390, 10) , 20 );
+}
+
+BOOST_AUTO_TEST_CASE( InvalidMaxSpeed )
+{
+    BOOST_CHECK_THROW( JumpFilter(0) , std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_CASE( RejectsSingleJump )
+{
+    JumpFilter filter(50); // 50 m/s
+
+    BOOST_CHECK( filter.accept({northOfClifton(0), 0}) );
+    BOOST_CHECK( filter.accept({northOfClifton(40), 1}) );
+    BOOST_CHECK( ! filter.accept({northOfClifton(5000), 2}) );
+    BOOST_CHECK( filter.accept({northOfClifton(120), 3}) );
+    BOOST_CHECK_EQUAL( filter.rejectedCount() , 1u );
+}
+
+BOOST_AUTO_TEST_CASE( IdenticalFixesWithSameTime )
+{
+    JumpFilter filter(50);
+
+    BOOST_CHECK( filter.accept({northOfClifton(0), 10}) );
+    BOOST_CHECK( filter.accept({northOfClifton(0), 10}) );
+    BOOST_CHECK( ! filter.accept({northOfClifton(1), 10}) );
+}
+
+BOOST_AUTO_TEST_CASE( ResynchronisesAfterRepeatedRejections )
+{
+    JumpFilter filter(50, 3);
+
+    BOOST_CHECK( filter.accept({northOfClifton(0), 0}) );
+    for (int i = 1; i <= 3; ++i)
+    {
+        BOOST_CHECK( ! filter.accept({northOfClifton(10000 + i), static_cast<seconds>(i)}) );
+    }
+    BOOST_CHECK( filter.accept({northOfClifton(10004), 4}) );
+    BOOST_CHECK( filter.accept({northOfClifton(10005), 5}) );
+}
+
+BOOST_AUTO_TEST_CASE( FilteringWhileParsing )
+{
+    const std::string logFilepath = LogFiles::NMEALogsDir + "gga_rmc-1.log";
+    std::ifstream file{logFilepath};
+    BOOST_REQUIRE_MESSAGE( file.good() , "Could not open log file: " + logFilepath );
+    std::stringstream contents;
+    contents << file.rdbuf();
+    const std::vector<Fix> unfiltered = NMEA::fixesFromLog(contents);
+    BOOST_REQUIRE_EQUAL( unfiltered.size() , 632u );
+
+    // A walk, so no Fix of the log is rejected; then a sentence 10km away a second later.
+    const Fix & last = unfiltered.back();
+    const Fix jump {Position(last.position.latitude() + Earth::latitudeSubtendedBy(10000), last.position.longitude()),
+                    last.time + 1};
+    std::stringstream log(contents.str() + NMEA::encodeSentence("GGA", jump) + "\n");
+    JumpFilter filter(100);
+
+    const std::vector<Fix> fixes = NMEA::fixesFromLog(log, std::ref(filter));
+
+    BOOST_CHECK_EQUAL( filter.rejectedCount() , 1u );
+    BOOST_REQUIRE_EQUAL( fixes.size() , unfiltered.size() );
+    for (std::size_t i = 1; i < fixes.size(); ++i)
+    {
+        BOOST_CHECK_LE( Position::horizontalDistanceBetween(fixes[i-1].position, fixes[i].position) ,
+                        100 * elapsedTime(fixes[i-1].time, fixes[i].time) );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( KalmanSmootherTests )
+
+BOOST_AUTO_TEST_CASE( InvalidParameters )
+{
+    BOOST_CHECK_THROW( KalmanSmoother(0, 5) , std::invalid_argument );
+    BOOST_CHECK_THROW( KalmanSmoother(1, 0) , std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_CASE( ReducesNoiseOnSteadyTrack )
+{
+    // Travelling north at 10 m/s, with 5m of position noise.
+    std::mt19937 random(3);
+    std::normal_distribution<double> noise(0, 5);
+    KalmanSmoother smoother(0.1, 5);
+
+    double rawError = 0, smoothedError = 0;
+    const int numFixes = 300;
+    for (int t = 0; t < numFixes; ++t)
+    {
+        const Position truth = JumpFilterTests::northOfClifton(10.0 * t);
+        const Position measured = JumpFilterTests::northOfClifton(10.0 * t + noise(random));
+        const Fix smoothed = smoother.smooth({measured, static_cast<seconds>(t)});
+
+        BOOST_CHECK_EQUAL( smoothed.time , t );
+        if (t >= 20) // once the filter has converged
+        {
+            rawError += Position::horizontalDistanceBetween(truth, measured);
+            smoothedError += Position::horizontalDistanceBetween(truth, smoothed.position);
+        }
+    }
+    BOOST_CHECK_LT( smoothedError , rawError / 2 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
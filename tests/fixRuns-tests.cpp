@@ -0,0 +1,154 @@
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "logs.h"
+#include "parseNMEA.h"
+#include "fixRuns.h"
+
+using namespace GPS;
+using namespace NMEA;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( FixRunsTests )
+
+// Three sentences at one position, with a sentence 18.5m north of it in between.
+const std::string stationaryLog =
+    "$GPGLL,5425.31,N,107.03,W,82611*68\n"
+    "$GPGLL,5425.31,N,107.03,W,noon*54\n" // invalid time: ignored
+    "$GPGLL,5425.31,N,107.03,W,82612*6B\n"
+    "$GPGLL,5425.32,N,107.03,W,82613*69\n"
+    "$GPGLL,5425.31,N,107.03,W,82614*6D\n";
+
+std::fstream openNMEAlogFile(std::string filename)
+{
+    std::string logFilepath = LogFiles::NMEALogsDir + filename;
+    std::fstream log{logFilepath};
+    BOOST_REQUIRE_MESSAGE( log.good() , "Could not open log file: " + logFilepath );
+    return log;
+}
+
+BOOST_AUTO_TEST_CASE( EmptyLog )
+{
+    std::stringstream log("");
+
+    BOOST_CHECK( fixRunsFromLog(log).empty() );
+
+    // A stream whose reads fail before its end is reached.
+    std::stringstream failed(stationaryLog);
+    failed.setstate(std::ios::failbit);
+    BOOST_CHECK( fixRunsFromLog(failed).empty() );
+}
+
+BOOST_AUTO_TEST_CASE( IdenticalSentencesCollapse )
+{
+    std::stringstream log(stationaryLog);
+
+    const std::vector<FixRun> runs = fixRunsFromLog(log);
+
+    BOOST_REQUIRE_EQUAL( runs.size() , 3u );
+    BOOST_CHECK_EQUAL( runs[0].count , 2u );
+    BOOST_CHECK_EQUAL( runs[0].firstTime , 8*3600 + 26*60 + 11 );
+    BOOST_CHECK_EQUAL( runs[0].lastTime , 8*3600 + 26*60 + 12 );
+    BOOST_CHECK_CLOSE( runs[0].position.latitude() , ddmTodd("5425.31") , 0.0001 );
+    BOOST_CHECK_EQUAL( runs[1].count , 1u );
+    BOOST_CHECK_EQUAL( runs[2].count , 1u );
+    BOOST_CHECK_EQUAL( runs[2].firstTime , runs[2].lastTime );
+}
+
+BOOST_AUTO_TEST_CASE( NearbySentencesCollapseWithinEpsilon )
+{
+    std::stringstream log1(stationaryLog), log2(stationaryLog);
+
+    const std::vector<FixRun> tight = fixRunsFromLog(log1, 10);
+    const std::vector<FixRun> loose = fixRunsFromLog(log2, 20);
+
+    BOOST_CHECK_EQUAL( tight.size() , 3u );
+    BOOST_REQUIRE_EQUAL( loose.size() , 1u );
+    BOOST_CHECK_EQUAL( loose[0].count , 4u );
+    BOOST_CHECK_EQUAL( loose[0].lastTime , 8*3600 + 26*60 + 14 );
+}
+
+BOOST_AUTO_TEST_CASE( DifferentFormatsAtSamePositionCollapse )
+{
+    std::stringstream log(
+        "$GPGGA,094627.000,3723.1622,N,00559.5788,W,1,0,,30.0,M,,M,,*7A\n"
+        "$GPRMC,094627.000,A,3723.1622,N,00559.5788,W,0.000,0.00,150914,,A*6F\n");
+
+    const std::vector<FixRun> runs = fixRunsFromLog(log);
+
+    BOOST_REQUIRE_EQUAL( runs.size() , 1u );
+    BOOST_CHECK_EQUAL( runs[0].count , 2u );
+    BOOST_CHECK_EQUAL( runs[0].position.elevation() , 30 ); // from the GGA sentence
+}
+
+BOOST_AUTO_TEST_CASE( InvalidSentencesDoNotExtendRuns )
+{
+    const std::string log =
+        "$GPGGA,094627.000,3723.1622,N,00559.5788,W,1,0,,30.0,M,,M,,*7A\n"
+        "$GPGGA,094628.000,3723.1622,N,00559.5788,W,1,0,,M30,M,,M,,*26\n" // invalid elevation
+        "$GPGGA,094629.000,3723.1622,N,00559.5788,W,1,0,,30.0,M,,M,,*74\n";
+    std::stringstream log1(log), log2(log);
+
+    const std::vector<FixRun> runs = fixRunsFromLog(log1);
+
+    BOOST_REQUIRE_EQUAL( runs.size() , 1u );
+    BOOST_CHECK_EQUAL( runs[0].count , fixesFromLog(log2).size() );
+    BOOST_CHECK_EQUAL( runs[0].count , 2u );
+    BOOST_CHECK_EQUAL( runs[0].lastTime , 9*3600 + 46*60 + 29 );
+}
+
+BOOST_AUTO_TEST_CASE( RunsCoverSameFixesAsFixesFromLog )
+{
+    std::fstream log1 = openNMEAlogFile("gga_rmc-1.log");
+    std::fstream log2 = openNMEAlogFile("gga_rmc-1.log");
+
+    const std::vector<Fix> fixes = fixesFromLog(log1);
+    const std::vector<FixRun> runs = fixRunsFromLog(log2);
+
+    BOOST_CHECK_LT( runs.size() , fixes.size() );
+    std::size_t i = 0;
+    for (const FixRun & run : runs)
+    {
+        BOOST_REQUIRE_LE( i + run.count , fixes.size() );
+        BOOST_CHECK_EQUAL( run.firstTime , fixes[i].time );
+        BOOST_CHECK_EQUAL( run.lastTime , fixes[i + run.count - 1].time );
+        for (std::size_t j = i; j < i + run.count; ++j)
+        {
+            BOOST_CHECK_EQUAL( fixes[j].position.latitude() , run.position.latitude() );
+            BOOST_CHECK_EQUAL( fixes[j].position.longitude() , run.position.longitude() );
+        }
+        i += run.count;
+    }
+    BOOST_CHECK_EQUAL( i , fixes.size() );
+}
+
+BOOST_AUTO_TEST_CASE( StreamingStage )
+{
+    RunLengthDeduplicator deduplicator;
+
+    BOOST_CHECK( ! deduplicator.add(*LazySentence::fromLine("$GPGLL,5425.31,N,107.03,W,82611*68")) );
+    BOOST_CHECK( ! deduplicator.add(*LazySentence::fromLine("$GPGLL,5425.31,N,107.03,W,82612*6B")) );
+    const std::optional<FixRun> completed = deduplicator.add(*LazySentence::fromLine("$GPGLL,5425.32,N,107.03,W,82613*69"));
+    BOOST_REQUIRE( completed );
+    BOOST_CHECK_EQUAL( completed->count , 2u );
+
+    const std::optional<FixRun> last = deduplicator.finish();
+    BOOST_REQUIRE( last );
+    BOOST_CHECK_EQUAL( last->count , 1u );
+    BOOST_CHECK( ! deduplicator.finish() );
+}
+
+BOOST_AUTO_TEST_CASE( NegativeEpsilon )
+{
+    BOOST_CHECK_THROW( RunLengthDeduplicator(-1) , std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
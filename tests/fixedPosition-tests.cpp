@@ -0,0 +1,144 @@
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "logs.h"
+#include "parseNMEA.h"
+#include "fixedPosition.h"
+
+using namespace GPS;
+using namespace NMEA;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( FixedPositionTests )
+
+BOOST_AUTO_TEST_CASE( Size )
+{
+    BOOST_CHECK_EQUAL( sizeof(FixedPosition) , 12u );
+}
+
+BOOST_AUTO_TEST_CASE( FromUnits )
+{
+    FixedPosition pos(523456789, -11840251, 5800);
+
+    BOOST_CHECK_EQUAL( pos.latitude() , 52.3456789 );
+    BOOST_CHECK_EQUAL( pos.longitude() , -1.1840251 );
+    BOOST_CHECK_EQUAL( pos.elevation() , 58.0 );
+}
+
+BOOST_AUTO_TEST_CASE( OutOfRangeUnits )
+{
+    BOOST_CHECK_THROW( FixedPosition(900000001, 0) , std::invalid_argument );
+    BOOST_CHECK_THROW( FixedPosition(0, -1800000001) , std::invalid_argument );
+    BOOST_CHECK_NO_THROW( FixedPosition(-900000000, 1800000000) );
+}
+
+BOOST_AUTO_TEST_CASE( FromDDMIsExact )
+{
+    // 37 degrees 23.1622 minutes = 37.38603666... degrees, rounded to 37.3860367
+    FixedPosition pos("3723.1622", 'N', "00559.5788", 'W', "30.0");
+
+    BOOST_CHECK_EQUAL( pos.latitudeUnits() , 373860367 );
+    BOOST_CHECK_EQUAL( pos.longitudeUnits() , -59929800 );
+    BOOST_CHECK_EQUAL( pos.elevationCentimetres() , 3000 );
+}
+
+BOOST_AUTO_TEST_CASE( FromDDMBearings )
+{
+    FixedPosition ne("5425.31", 'N', "107.03", 'E');
+    FixedPosition sw("5425.31", 'S', "107.03", 'W');
+
+    BOOST_CHECK_EQUAL( ne.latitudeUnits() , -sw.latitudeUnits() );
+    BOOST_CHECK_EQUAL( ne.longitudeUnits() , -sw.longitudeUnits() );
+    BOOST_CHECK_GT( ne.latitudeUnits() , 0 );
+    BOOST_CHECK_GT( ne.longitudeUnits() , 0 );
+}
+
+BOOST_AUTO_TEST_CASE( FromDDMNegativeElevation )
+{
+    FixedPosition pos("5425.31", 'N', "107.03", 'E', "-12.345");
+
+    BOOST_CHECK_EQUAL( pos.elevationCentimetres() , -1235 );
+}
+
+BOOST_AUTO_TEST_CASE( FromDDMMatchesPosition )
+{
+    Position expected("5425.31", 'N', "107.03", 'W', "4.0");
+    FixedPosition pos("5425.31", 'N', "107.03", 'W', "4.0");
+
+    BOOST_CHECK_SMALL( pos.latitude() - expected.latitude() , 1e-7 );
+    BOOST_CHECK_SMALL( pos.longitude() - expected.longitude() , 1e-7 );
+    BOOST_CHECK_EQUAL( pos.elevation() , expected.elevation() );
+}
+
+BOOST_AUTO_TEST_CASE( FromDDMInvalid )
+{
+    BOOST_CHECK_THROW( FixedPosition("", 'N', "107.03", 'W') , std::invalid_argument );
+    BOOST_CHECK_THROW( FixedPosition("fivethousand", 'N', "107.03", 'W') , std::invalid_argument );
+    BOOST_CHECK_THROW( FixedPosition("54.25.31", 'N', "107.03", 'W') , std::invalid_argument );
+    BOOST_CHECK_THROW( FixedPosition("-5425.31", 'N', "107.03", 'W') , std::invalid_argument );
+    BOOST_CHECK_THROW( FixedPosition("5425.31", 'X', "107.03", 'W') , std::invalid_argument );
+    BOOST_CHECK_THROW( FixedPosition("5425.31", 'N', "107.03", 'N') , std::invalid_argument );
+    BOOST_CHECK_THROW( FixedPosition("9100.00", 'N', "107.03", 'W') , std::invalid_argument );
+    BOOST_CHECK_THROW( FixedPosition("5425.31", 'N', "107.03", 'W', "high") , std::invalid_argument );
+    BOOST_CHECK_THROW( FixedPosition("5.42531e3", 'N', "107.03", 'W') , std::invalid_argument );
+    BOOST_CHECK_THROW( FixedPosition("5425.31x", 'N', "107.03", 'W') , std::invalid_argument );
+    BOOST_CHECK_THROW( FixedPosition("5425.31", 'N', "107.03", 'W', "1e2") , std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_CASE( RoundTripThroughPosition )
+{
+    const std::vector<FixedPosition> positions = {
+        FixedPosition(0, 0),
+        FixedPosition(900000000, 0, 1),
+        FixedPosition(-900000000, -1800000000, -1),
+        FixedPosition(529124995, -11840251, 5800),
+        FixedPosition(1, -1, 214748364)
+    };
+    for (const FixedPosition & pos : positions)
+    {
+        BOOST_CHECK( FixedPosition(pos.toPosition()) == pos );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( FixedPositionsFromLog )
+{
+    for (std::string name : {"gll.log", "gga_rmc-1.log"})
+    {
+        std::ifstream log1{LogFiles::NMEALogsDir + name}, log2{LogFiles::NMEALogsDir + name};
+        BOOST_REQUIRE( log1.good() );
+
+        std::vector<Position> expected = positionsFromLog(log1);
+        std::vector<FixedPosition> positions = fixedPositionsFromLog(log2);
+
+        BOOST_REQUIRE_EQUAL( positions.size() , expected.size() );
+        for (std::size_t i = 0; i < expected.size(); ++i)
+        {
+            BOOST_CHECK( positions[i] == FixedPosition(expected[i]) );
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( FixedPositionsFromLogRequirePlainDecimals )
+{
+    // positionsFromLog() accepts all three lines; the last two are not plain decimals.
+    const std::string lines = "$GPGLL,5425.31,N,107.03,W,82610*69\n"
+                              "$GPGLL,5.42531e3,N,107.03,W,82610*3F\n"
+                              "$GPGLL,5425.31x,N,107.03,W,82610*11\n";
+    std::stringstream log1(lines), log2(lines);
+
+    BOOST_CHECK_EQUAL( positionsFromLog(log1).size() , 3 );
+    const std::vector<FixedPosition> positions = fixedPositionsFromLog(log2);
+    BOOST_REQUIRE_EQUAL( positions.size() , 1 );
+    BOOST_CHECK( positions[0] == FixedPosition("5425.31", 'N', "107.03", 'W') );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,107 @@
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+#include "earth.h"
+#include "geodesic.h"
+
+using namespace GPS;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( GeodesicDistance )
+
+// Reference values from GeographicLib (C. F. F. Karney), accurate to a few nanometres.
+
+const metres millimetre = 0.001;
+const degrees azimuthAccuracy = 1e-6;
+
+BOOST_AUTO_TEST_CASE( EllipsoidConstantsAreCompileTime )
+{
+    static_assert(Earth::WGS84.a == 6378137.0);
+    static_assert(Earth::WGS84.b < Earth::WGS84.a);
+    BOOST_CHECK_CLOSE( Earth::WGS84.b , 6356752.314245 , 1e-9 );
+}
+
+BOOST_AUTO_TEST_CASE( CoincidentPositions )
+{
+    BOOST_CHECK_EQUAL( geodesicDistanceBetween(Earth::CliftonCampus, Earth::CliftonCampus) , 0 );
+    BOOST_CHECK_EQUAL( geodesicDistanceBetween(Earth::NorthPole, Earth::NorthPole) , 0 );
+}
+
+BOOST_AUTO_TEST_CASE( FlindersPeakToBuninyong )
+{
+    // Vincenty's own test line.
+    const Position flindersPeak(-37.95103342, 144.42486789);
+    const Position buninyong(-37.65282114, 143.92649554);
+
+    const Geodesic g = geodesicBetween(flindersPeak, buninyong);
+
+    BOOST_CHECK_SMALL( g.distance - 54972.2705053984 , millimetre );
+    BOOST_CHECK_SMALL( g.initialAzimuth - -53.13183997354282 , azimuthAccuracy );
+    BOOST_CHECK_SMALL( g.finalAzimuth - -52.82636855419643 , azimuthAccuracy );
+}
+
+BOOST_AUTO_TEST_CASE( ShortHighLatitudeLine )
+{
+    const Geodesic g = geodesicBetween(Position(53.3817, -1.4802), Position(52.5, -1.9));
+
+    BOOST_CHECK_SMALL( g.distance - 102097.88357821546 , millimetre );
+    BOOST_CHECK_SMALL( g.initialAzimuth - -163.7852292917493 , azimuthAccuracy );
+    BOOST_CHECK_SMALL( g.finalAzimuth - -164.12024596072504 , azimuthAccuracy );
+}
+
+BOOST_AUTO_TEST_CASE( Symmetric )
+{
+    const Position p1(-37.95103342, 144.42486789);
+    const Position p2(-37.65282114, 143.92649554);
+
+    BOOST_CHECK_CLOSE( geodesicDistanceBetween(p1, p2) , geodesicDistanceBetween(p2, p1) , 1e-10 );
+}
+
+BOOST_AUTO_TEST_CASE( NearPole )
+{
+    const Geodesic g = geodesicBetween(Earth::EquatorialMeridian, Position(89.9999, 10));
+
+    BOOST_CHECK_SMALL( g.distance - 10001954.729603019 , millimetre );
+    BOOST_CHECK_SMALL( g.initialAzimuth - 1.742323473209819e-05 , azimuthAccuracy );
+}
+
+BOOST_AUTO_TEST_CASE( EquatorialAntipodes )
+{
+    const Geodesic g = geodesicBetween(Earth::EquatorialMeridian, Earth::EquatorialAntiMeridian);
+
+    // Half a meridian, over a pole.
+    BOOST_CHECK_SMALL( g.distance - 20003931.458625447 , millimetre );
+    BOOST_CHECK_SMALL( g.initialAzimuth , azimuthAccuracy );
+    BOOST_CHECK_CLOSE( g.finalAzimuth , 180 , azimuthAccuracy );
+}
+
+BOOST_AUTO_TEST_CASE( NearAntipodes )
+{
+    // Vincenty's iteration does not converge for these.
+    BOOST_CHECK_SMALL( geodesicDistanceBetween(Earth::EquatorialMeridian, Position(0.5, 179.5)) - 19936288.578965314 , millimetre );
+    BOOST_CHECK_SMALL( geodesicDistanceBetween(Earth::EquatorialMeridian, Position(0.5, 179.7)) - 19944127.420750458 , millimetre );
+    BOOST_CHECK_SMALL( geodesicDistanceBetween(Position(10, 20), Position(-10, -160.0001)) - 20003931.457702395 , millimetre );
+}
+
+BOOST_AUTO_TEST_CASE( LegDistancesMatchPairwise )
+{
+    const std::vector<Position> track = {
+        Earth::CliftonCampus, Earth::CityCampus, Earth::Pontianak,
+        Earth::EquatorialMeridian, Earth::EquatorialAntiMeridian, Earth::NorthPole
+    };
+    std::vector<metres> legs(track.size() - 1);
+
+    geodesicLegDistances(track.data(), track.size(), legs.data());
+
+    for (std::size_t i = 0; i < legs.size(); ++i)
+    {
+        BOOST_CHECK_EQUAL( legs[i] , geodesicDistanceBetween(track[i], track[i+1]) );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
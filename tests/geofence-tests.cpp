@@ -0,0 +1,178 @@
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "geometry.h"
+#include "earth.h"
+#include "geofence.h"
+
+using namespace GPS;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( Geofences )
+
+// A square of roughly 1km around CliftonCampus.
+std::vector<Position> cliftonSquare()
+{
+    const degrees lat = Earth::CliftonCampus.latitude();
+    const degrees lon = Earth::CliftonCampus.longitude();
+    return { Position(lat - 0.005, lon - 0.008), Position(lat - 0.005, lon + 0.008),
+             Position(lat + 0.005, lon + 0.008), Position(lat + 0.005, lon - 0.008) };
+}
+
+BOOST_AUTO_TEST_CASE( Circle )
+{
+    GeofenceSet fences;
+    GeofenceSet::FenceId id = fences.addCircle(Earth::CliftonCampus, 1000);
+
+    BOOST_CHECK( fences.contains(id, Earth::CliftonCampus) );
+    BOOST_CHECK( fences.contains(id, Position(Earth::CliftonCampus.latitude() + Earth::latitudeSubtendedBy(990),
+                                              Earth::CliftonCampus.longitude())) );
+    BOOST_CHECK( ! fences.contains(id, Position(Earth::CliftonCampus.latitude() + Earth::latitudeSubtendedBy(1010),
+                                                Earth::CliftonCampus.longitude())) );
+    BOOST_CHECK( ! fences.contains(id, Earth::CityCampus) );
+}
+
+// The Position on the parallel through 'centre' that is 'distance' east of it (west if negative).
+Position alongParallel(Position centre, metres distance)
+{
+    const double halfChord = std::sin(std::abs(distance) / (2 * Earth::meanRadius)) / std::cos(degToRad(centre.latitude()));
+    const degrees lonOffset = radToDeg(2 * std::asin(halfChord));
+    return Position(centre.latitude(), centre.longitude() + (distance < 0 ? -lonOffset : lonOffset));
+}
+
+BOOST_AUTO_TEST_CASE( CircleEastAndWestEdges )
+{
+    GeofenceSet fences;
+    for (auto [centre, radius] : {std::pair{Earth::EquatorialMeridian, 1000.0}, std::pair{Earth::CliftonCampus, 200.0},
+                                  std::pair{Position(70, 20), 5000.0}})
+    {
+        GeofenceSet::FenceId id = fences.addCircle(centre, radius);
+        for (metres side : {1.0, -1.0})
+        {
+            BOOST_CHECK( fences.contains(id, alongParallel(centre, side * (radius - 0.1))) );
+            BOOST_CHECK( ! fences.contains(id, alongParallel(centre, side * (radius + 0.1))) );
+
+            std::vector<GeofenceSet::FenceId> containing;
+            fences.fencesContaining(alongParallel(centre, side * (radius - 0.1)), containing);
+            BOOST_CHECK( std::find(containing.begin(), containing.end(), id) != containing.end() );
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( Polygon )
+{
+    GeofenceSet fences;
+    GeofenceSet::FenceId id = fences.addPolygon(cliftonSquare());
+
+    BOOST_CHECK( fences.contains(id, Earth::CliftonCampus) );
+    BOOST_CHECK( ! fences.contains(id, Earth::CityCampus) );
+    BOOST_CHECK( ! fences.contains(id, Position(Earth::CliftonCampus.latitude() + 0.006, Earth::CliftonCampus.longitude())) );
+}
+
+BOOST_AUTO_TEST_CASE( ConcavePolygon )
+{
+    // An L shape: the notch at the top right is outside.
+    GeofenceSet fences;
+    GeofenceSet::FenceId id = fences.addPolygon({ Position(0,0), Position(0,2), Position(1,2),
+                                                  Position(1,1), Position(2,1), Position(2,0) });
+
+    BOOST_CHECK( fences.contains(id, Position(0.5,1.5)) );
+    BOOST_CHECK( fences.contains(id, Position(1.5,0.5)) );
+    BOOST_CHECK( ! fences.contains(id, Position(1.5,1.5)) );
+}
+
+BOOST_AUTO_TEST_CASE( InvalidFences )
+{
+    GeofenceSet fences;
+    BOOST_CHECK_THROW( fences.addCircle(Earth::CliftonCampus, 0) , std::invalid_argument );
+    BOOST_CHECK_THROW( fences.addPolygon({ Position(0,0), Position(1,1) }) , std::invalid_argument );
+    BOOST_CHECK_THROW( GeofenceSet(0) , std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_CASE( LargeAndPolarFences )
+{
+    GeofenceSet fences;
+    GeofenceSet::FenceId polar = fences.addCircle(Earth::NorthPole, 100000);
+    GeofenceSet::FenceId antiMeridian = fences.addCircle(Earth::EquatorialAntiMeridian, 100000);
+
+    std::vector<GeofenceSet::FenceId> found;
+    fences.fencesContaining(Position(89.5, 123), found);
+    BOOST_CHECK( found == std::vector<GeofenceSet::FenceId>{polar} );
+
+    fences.fencesContaining(Position(0.1, -179.9), found);
+    BOOST_CHECK( found == std::vector<GeofenceSet::FenceId>{antiMeridian} );
+}
+
+BOOST_AUTO_TEST_CASE( GridQueriesMatchBruteForce )
+{
+    std::mt19937 random(42);
+    std::uniform_real_distribution<double> lat(52.8, 53.0), lon(-1.3, -1.0), radius(50, 2000);
+
+    GeofenceSet fences(0.005);
+    for (int i = 0; i < 500; ++i)
+    {
+        const Position centre(lat(random), lon(random));
+        if (i % 2 == 0)
+        {
+            fences.addCircle(centre, radius(random));
+        }
+        else
+        {
+            const degrees d = 0.002 + (i % 7) * 0.001;
+            fences.addPolygon({ Position(centre.latitude() - d, centre.longitude()),
+                                Position(centre.latitude(), centre.longitude() + d),
+                                Position(centre.latitude() + d, centre.longitude()) });
+        }
+    }
+
+    std::vector<GeofenceSet::FenceId> found;
+    for (int i = 0; i < 2000; ++i)
+    {
+        const Position pos(lat(random), lon(random));
+        std::vector<GeofenceSet::FenceId> expected;
+        for (GeofenceSet::FenceId id = 0; id < fences.size(); ++id)
+        {
+            if (fences.contains(id, pos)) expected.push_back(id);
+        }
+        fences.fencesContaining(pos, found);
+        BOOST_REQUIRE( found == expected );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( MonitorEnterAndExitEvents )
+{
+    GeofenceSet fences;
+    GeofenceSet::FenceId clifton = fences.addCircle(Earth::CliftonCampus, 1000);
+    GeofenceSet::FenceId city = fences.addCircle(Earth::CityCampus, 1000);
+    GeofenceMonitor monitor(fences);
+    std::vector<GeofenceEvent> events;
+
+    monitor.update(Earth::CliftonCampus, events);
+    BOOST_REQUIRE_EQUAL( events.size() , 1u );
+    BOOST_CHECK( events[0].type == GeofenceEvent::Type::Enter );
+    BOOST_CHECK_EQUAL( events[0].fence , clifton );
+
+    events.clear();
+    monitor.update(Earth::CliftonCampus, events);
+    BOOST_CHECK( events.empty() );
+
+    monitor.update(Earth::CityCampus, events);
+    BOOST_REQUIRE_EQUAL( events.size() , 2u );
+    BOOST_CHECK( events[0].type == GeofenceEvent::Type::Exit );
+    BOOST_CHECK_EQUAL( events[0].fence , clifton );
+    BOOST_CHECK( events[1].type == GeofenceEvent::Type::Enter );
+    BOOST_CHECK_EQUAL( events[1].fence , city );
+
+    BOOST_CHECK( monitor.insideFences() == std::vector<GeofenceSet::FenceId>{city} );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
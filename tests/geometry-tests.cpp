@@ -0,0 +1,123 @@
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "geometry.h"
+#include "earth.h"
+
+using namespace GPS;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( BatchGeometry )
+
+const std::vector<degrees> angles = { 0, 1, -1, 45.5, 90, -90, 179.999, 180, -180, 180.001,
+                                      -180.001, 270, -270, 359, 360, -360, 540, -540, 1000, -12345.678 };
+
+BOOST_AUTO_TEST_CASE( ConstantsAreCompileTime )
+{
+    static_assert(degToRad(halfRotation) == pi);
+    static_assert(radToDeg(pi) == halfRotation);
+}
+
+BOOST_AUTO_TEST_CASE( EarthConstantsAreCompileTime )
+{
+    static_assert(Earth::NorthPole.latitude() == poleLatitude);
+    static_assert(Earth::EquatorialAntiMeridian.longitude() == antiMeridianLongitude);
+    static_assert(Earth::CliftonCampus.elevation() == 58);
+    static_assert(Earth::latitudeSubtendedBy(Earth::polarCircumference / 4) == poleLatitude);
+
+    constexpr Position site(51.5, -2.6, 10);
+    static_assert(site.latitude() == 51.5 && site.longitude() == -2.6 && site.elevation() == 10);
+}
+
+BOOST_AUTO_TEST_CASE( ConstexprConstructorStillValidatesAtRunTime )
+{
+    volatile degrees badLatitude = 90.5;
+    volatile degrees badLongitude = -180.5;
+
+    BOOST_CHECK_THROW( Position(badLatitude, 0) , std::invalid_argument );
+    BOOST_CHECK_THROW( Position(0, badLongitude) , std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_CASE( DegToRadMatchesScalar )
+{
+    // The listed angles, and a sweep of 100,000 over [-500,870].
+    std::vector<degrees> in = angles;
+    for (int i = 0; i < 100000; ++i) in.push_back(-500 + i * 0.0137);
+    std::vector<radians> out(in.size());
+    degToRad(in.data(), out.data(), in.size());
+
+    std::size_t mismatches = 0;
+    for (std::size_t i = 0; i < in.size(); ++i) mismatches += out[i] != degToRad(in[i]);
+    BOOST_CHECK_EQUAL( mismatches , 0u );
+}
+
+BOOST_AUTO_TEST_CASE( RadToDegMatchesScalarInPlace )
+{
+    std::vector<double> values = angles;
+    for (int i = 0; i < 100000; ++i) values.push_back(-10 + i * 0.0002);
+    const std::vector<double> in = values;
+    radToDeg(values.data(), values.data(), values.size());
+
+    std::size_t mismatches = 0;
+    for (std::size_t i = 0; i < in.size(); ++i) mismatches += values[i] != radToDeg(in[i]);
+    BOOST_CHECK_EQUAL( mismatches , 0u );
+}
+
+BOOST_AUTO_TEST_CASE( NormaliseDegMatchesScalar )
+{
+    std::vector<degrees> out(angles.size());
+    normaliseDeg(angles.data(), out.data(), angles.size());
+
+    for (std::size_t i = 0; i < angles.size(); ++i)
+    {
+        BOOST_CHECK_GT( out[i] , -halfRotation );
+        BOOST_CHECK_LE( out[i] , halfRotation );
+        BOOST_CHECK_SMALL( out[i] - normaliseDeg(angles[i]) , 1e-9 );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( NormaliseDegLargeAndNonFinite )
+{
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    const double infinity = std::numeric_limits<double>::infinity();
+    const std::vector<degrees> large = { 7.7e11 + 90, -7.7e11 - 90, 1e12 + 45, -1e12 - 45, 3.6e15 + 18, -3.6e15 - 18 };
+    const std::vector<degrees> special = { nan, infinity, -infinity };
+
+    std::vector<degrees> out(large.size());
+    normaliseDeg(large.data(), out.data(), large.size());
+    for (std::size_t i = 0; i < large.size(); ++i)
+    {
+        BOOST_CHECK_GT( out[i] , -halfRotation );
+        BOOST_CHECK_LE( out[i] , halfRotation );
+        BOOST_CHECK_SMALL( out[i] - normaliseDeg(large[i]) , std::abs(large[i]) * 1e-15 );
+    }
+
+    out.resize(special.size());
+    normaliseDeg(special.data(), out.data(), special.size());
+    for (degrees angle : out) BOOST_CHECK( std::isnan(angle) );
+}
+
+BOOST_AUTO_TEST_CASE( ToECEF )
+{
+    const std::vector<degrees> lat = { 0, 0, 90, -90, 0 };
+    const std::vector<degrees> lon = { 0, 90, 0, 0, 180 };
+    const std::vector<metres> ele = { 0, 0, 0, 0, 100 };
+    std::vector<metres> x(5), y(5), z(5);
+
+    Earth::toECEF(lat.data(), lon.data(), ele.data(), x.data(), y.data(), z.data(), 5);
+
+    const metres r = Earth::meanRadius;
+    BOOST_CHECK_CLOSE( x[0] , r , 1e-9 );      BOOST_CHECK_SMALL( y[0] , 1e-6 ); BOOST_CHECK_SMALL( z[0] , 1e-6 );
+    BOOST_CHECK_SMALL( x[1] , 1e-6 );          BOOST_CHECK_CLOSE( y[1] , r , 1e-9 );
+    BOOST_CHECK_CLOSE( z[2] , r , 1e-9 );      BOOST_CHECK_CLOSE( z[3] , -r , 1e-9 );
+    BOOST_CHECK_CLOSE( x[4] , -(r + 100) , 1e-9 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,143 @@
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+
+#include "logs.h"
+#include "parseNMEA.h"
+
+using namespace GPS;
+using namespace NMEA;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( LazySentenceTests )
+
+const std::string validGGASentence = "$GPGGA,113922.000,3722.5993,N,00559.2458,W,1,0,,4.0,M,,M,,*40";
+const std::string validRMCSentence = "$GPRMC,113922.000,A,3722.5993,N,00559.2458,W,10.5,0.00,150914,,A*56";
+
+// Well-formed, with a correct checksum and a valid time, but a latitude of 99 degrees.
+const std::string invalidLatitudeGGASentence = "$GPGGA,113922.000,9922.5993,N,00559.2458,W,1,0,,4.0,M,,M,,*44";
+
+std::fstream openNMEAlogFile(std::string filename)
+{
+    std::string logFilepath = LogFiles::NMEALogsDir + filename;
+    std::fstream log{logFilepath};
+    BOOST_REQUIRE_MESSAGE( log.good() , "Could not open log file: " + logFilepath );
+    return log;
+}
+
+BOOST_AUTO_TEST_CASE( RejectsInvalidSentences )
+{
+    BOOST_CHECK( ! LazySentence::fromLine("") );
+    BOOST_CHECK( ! LazySentence::fromLine("$GPGGA,113922.000*00") );   // bad checksum
+    BOOST_CHECK( ! LazySentence::fromLine("$GPMSS,55,27,318.0,100,*66") ); // unsupported format
+    BOOST_CHECK( ! LazySentence::fromLine("GPGLL,5425.31,N,107.03,W,82610*69") );
+}
+
+BOOST_AUTO_TEST_CASE( FieldsMatchParseSentenceData )
+{
+    const std::optional<LazySentence> lazy = LazySentence::fromLine(validGGASentence);
+    const SentenceData data = parseSentenceData(validGGASentence);
+
+    BOOST_REQUIRE( lazy );
+    BOOST_CHECK_EQUAL( lazy->format() , data.format );
+    BOOST_REQUIRE_EQUAL( lazy->fieldCount() , data.dataFields.size() );
+    for (std::size_t i = 0; i < data.dataFields.size(); ++i)
+    {
+        BOOST_CHECK_EQUAL( lazy->field(i) , data.dataFields[i] );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( DecodesMatchEagerInterpretation )
+{
+    const std::optional<LazySentence> lazy = LazySentence::fromLine(validGGASentence);
+    const SentenceData data = parseSentenceData(validGGASentence);
+    BOOST_REQUIRE( lazy );
+
+    const Position expected = interpretSentenceData(data);
+    BOOST_CHECK_EQUAL( lazy->position().latitude() , expected.latitude() );
+    BOOST_CHECK_EQUAL( lazy->position().longitude() , expected.longitude() );
+    BOOST_CHECK_EQUAL( lazy->position().elevation() , expected.elevation() );
+    BOOST_CHECK_EQUAL( lazy->time() , interpretSentenceTime(data) );
+}
+
+BOOST_AUTO_TEST_CASE( PositionIsCached )
+{
+    const std::optional<LazySentence> lazy = LazySentence::fromLine(validGGASentence);
+    BOOST_REQUIRE( lazy );
+
+    BOOST_CHECK_EQUAL( &lazy->position() , &lazy->position() );
+}
+
+BOOST_AUTO_TEST_CASE( CopiesAreIndependentOfTheOriginal )
+{
+    std::optional<LazySentence> original = LazySentence::fromLine(validGGASentence);
+    BOOST_REQUIRE( original );
+    const LazySentence copy = *original;
+    original.reset();
+
+    BOOST_CHECK_EQUAL( copy.field(1) , "3722.5993" );
+    BOOST_CHECK_CLOSE( copy.position().latitude() , ddmTodd("3722.5993") , 0.0001 );
+}
+
+BOOST_AUTO_TEST_CASE( FieldsAreOnlyCheckedWhenAccessed )
+{
+    const std::optional<LazySentence> lazy = LazySentence::fromLine(invalidLatitudeGGASentence);
+    BOOST_REQUIRE( lazy );
+
+    BOOST_CHECK_EQUAL( lazy->time() , 11*3600 + 39*60 + 22 );
+    BOOST_CHECK_THROW( lazy->position() , std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_CASE( GroundSpeed )
+{
+    const std::optional<LazySentence> rmc = LazySentence::fromLine(validRMCSentence);
+    const std::optional<LazySentence> gga = LazySentence::fromLine(validGGASentence);
+    const std::optional<LazySentence> badSpeed =
+        LazySentence::fromLine("$GPRMC,113922.000,A,3722.5993,N,00559.2458,W,fast,0.00,150914,,A*4C");
+    BOOST_REQUIRE( rmc && gga && badSpeed );
+
+    BOOST_CHECK_CLOSE( rmc->groundSpeed() , 10.5 * 1852 / 3600 , 0.0001 );
+    BOOST_CHECK_THROW( gga->groundSpeed() , std::invalid_argument );
+    BOOST_CHECK_THROW( badSpeed->groundSpeed() , std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_CASE( TimeWindowMatchesFilteredFixes )
+{
+    std::fstream log1 = openNMEAlogFile("gga_rmc-1.log");
+    std::fstream log2 = openNMEAlogFile("gga_rmc-1.log");
+    const seconds from = 10*3600, to = 11*3600;
+
+    std::vector<Fix> expected;
+    for (const Fix & fix : fixesFromLog(log1))
+    {
+        if (fix.time >= from && fix.time <= to) expected.push_back(fix);
+    }
+    const std::vector<Fix> fixes = fixesInTimeWindow(log2, from, to);
+
+    BOOST_REQUIRE( ! expected.empty() );
+    BOOST_REQUIRE_EQUAL( fixes.size() , expected.size() );
+    for (std::size_t i = 0; i < expected.size(); ++i)
+    {
+        BOOST_CHECK_EQUAL( fixes[i].time , expected[i].time );
+        BOOST_CHECK_EQUAL( fixes[i].position.latitude() , expected[i].position.latitude() );
+        BOOST_CHECK_EQUAL( fixes[i].position.longitude() , expected[i].position.longitude() );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( TimeWindowSkipsInvalidPositionsOutsideIt )
+{
+    std::stringstream log;
+    log << invalidLatitudeGGASentence << std::endl << validRMCSentence << std::endl;
+
+    const seconds t = 11*3600 + 39*60 + 22;
+    BOOST_CHECK_EQUAL( fixesInTimeWindow(log, t, t).size() , 1u );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,199 @@
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "logs.h"
+#include "parseNMEA.h"
+#include "logIndex.h"
+
+using namespace GPS;
+using namespace NMEA;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( LogIndexTests )
+
+std::string readNMEAlogFile(std::string filename)
+{
+    std::string logFilepath = LogFiles::NMEALogsDir + filename;
+    std::ifstream log{logFilepath};
+    BOOST_REQUIRE_MESSAGE( log.good() , "Could not open log file: " + logFilepath );
+    std::stringstream contents;
+    contents << log.rdbuf();
+    return contents.str();
+}
+
+void checkSameFixes(const std::vector<Fix> & fixes, const std::vector<Fix> & expected)
+{
+    BOOST_REQUIRE_EQUAL( fixes.size() , expected.size() );
+    for (std::size_t i = 0; i < expected.size(); ++i)
+    {
+        BOOST_CHECK_EQUAL( fixes[i].time , expected[i].time );
+        BOOST_CHECK_EQUAL( fixes[i].position.latitude() , expected[i].position.latitude() );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( EntriesAreAtIntervals )
+{
+    std::stringstream log(readNMEAlogFile("gga_rmc-1.log"));
+    const LogIndex index = LogIndex::build(log, 60);
+
+    BOOST_REQUIRE_GT( index.entries().size() , 10u );
+    BOOST_CHECK( index.isTimeOrdered() );
+    BOOST_CHECK_EQUAL( index.indexedBytes() , log.str().size() );
+
+    // First entry: $GPGGA,094627.000,... at the start of the first sentence line.
+    BOOST_CHECK_EQUAL( index.entries()[0].time , 9*3600 + 46*60 + 27 );
+    BOOST_CHECK_EQUAL( log.str().substr(index.entries()[0].offset, 7) , "$GPGGA," );
+
+    for (std::size_t i = 1; i < index.entries().size(); ++i)
+    {
+        const LogIndex::Entry & entry = index.entries()[i];
+        BOOST_CHECK_GE( entry.time , 60 * std::floor(index.entries()[i-1].time / 60) + 60 );
+        BOOST_CHECK_EQUAL( log.str()[entry.offset] , '$' );
+        BOOST_CHECK_EQUAL( LazySentence::fromLine(log.str().substr(entry.offset, log.str().find('\n', entry.offset) - entry.offset))->time() ,
+                           entry.time );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( FixesBetweenMatchesFullScan )
+{
+    const std::string contents = readNMEAlogFile("gga_rmc-1.log");
+    std::stringstream log(contents);
+    const LogIndex index = LogIndex::build(log, 60);
+
+    for (auto [from, to] : { std::pair<seconds,seconds>{0, 86400},
+                             {10*3600, 10*3600 + 600},
+                             {10*3600 + 30, 10*3600 + 30},
+                             {11*3600 + 37*60 + 20, 12*3600},
+                             {23*3600, 23*3600 + 60} })
+    {
+        std::stringstream full(contents);
+        checkSameFixes(index.fixesBetween(log, from, to), fixesInTimeWindow(full, from, to));
+    }
+}
+
+BOOST_AUTO_TEST_CASE( QuerySkipsEarlierPartOfLog )
+{
+    std::stringstream log(readNMEAlogFile("gga_rmc-1.log"));
+    const LogIndex index = LogIndex::build(log, 60);
+
+    BOOST_CHECK_EQUAL( index.offsetFor(0) , 0u );
+    BOOST_CHECK_GT( index.offsetFor(11*3600) , 0u );
+    BOOST_CHECK_GT( index.offsetFor(11*3600 + 30*60) , index.offsetFor(11*3600) );
+    BOOST_CHECK_EQUAL( index.offsetFor(86399) , index.entries().back().offset );
+}
+
+BOOST_AUTO_TEST_CASE( UnorderedLogFallsBackToFullScan )
+{
+    // Two copies of a log: the second goes back in time.
+    const std::string contents = readNMEAlogFile("gga_rmc-1.log") + readNMEAlogFile("gga_rmc-1.log");
+    std::stringstream log(contents), full(contents);
+    const LogIndex index = LogIndex::build(log, 60);
+    const seconds from = 10*3600, to = 10*3600 + 600;
+
+    BOOST_CHECK( ! index.isTimeOrdered() );
+    BOOST_CHECK_EQUAL( index.offsetFor(from) , 0u );
+    checkSameFixes(index.fixesBetween(log, from, to), fixesInTimeWindow(full, from, to));
+}
+
+BOOST_AUTO_TEST_CASE( SaveAndLoad )
+{
+    std::stringstream log(readNMEAlogFile("gll.log"));
+    const LogIndex index = LogIndex::build(log, 30);
+    std::stringstream sidecar;
+
+    index.save(sidecar);
+    const LogIndex loaded = LogIndex::load(sidecar);
+
+    BOOST_CHECK_EQUAL( loaded.interval() , 30 );
+    BOOST_CHECK_EQUAL( loaded.isTimeOrdered() , index.isTimeOrdered() );
+    BOOST_CHECK_EQUAL( loaded.indexedBytes() , index.indexedBytes() );
+    BOOST_REQUIRE_EQUAL( loaded.entries().size() , index.entries().size() );
+    for (std::size_t i = 0; i < index.entries().size(); ++i)
+    {
+        BOOST_CHECK_EQUAL( loaded.entries()[i].time , index.entries()[i].time );
+        BOOST_CHECK_EQUAL( loaded.entries()[i].offset , index.entries()[i].offset );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( LoadRejectsInvalidData )
+{
+    std::stringstream notAnIndex("$GPGLL,5425.31,N,107.03,W,82610*69");
+    std::stringstream truncated;
+    LogIndex::build(notAnIndex, 60).save(truncated);
+    const std::string bytes = truncated.str();
+    std::stringstream cut(bytes.substr(0, bytes.size() - 1));
+
+    notAnIndex.clear();
+    notAnIndex.seekg(0);
+    BOOST_CHECK_THROW( LogIndex::load(notAnIndex) , std::invalid_argument );
+    BOOST_CHECK_THROW( LogIndex::load(cut) , std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_CASE( SidecarFileIsCreatedAndReused )
+{
+    const std::filesystem::path logPath = std::filesystem::temp_directory_path() / "logIndex-tests.log";
+    {
+        std::ofstream copy(logPath);
+        copy << readNMEAlogFile("gga_rmc-1.log");
+    }
+    std::filesystem::remove(LogIndex::sidecarPath(logPath.string()));
+
+    const LogIndex built = LogIndex::forFile(logPath.string(), 60);
+    BOOST_REQUIRE( std::filesystem::exists(LogIndex::sidecarPath(logPath.string())) );
+    const LogIndex reused = LogIndex::forFile(logPath.string(), 60);
+
+    BOOST_CHECK_EQUAL( reused.entries().size() , built.entries().size() );
+    BOOST_CHECK_EQUAL( reused.indexedBytes() , std::filesystem::file_size(logPath) );
+
+    std::filesystem::remove(LogIndex::sidecarPath(logPath.string()));
+    std::filesystem::remove(logPath);
+}
+
+BOOST_AUTO_TEST_CASE( SidecarIsRebuiltWhenLogIsRewrittenAtSameSize )
+{
+    const std::filesystem::path logPath = std::filesystem::temp_directory_path() / "logIndex-tests-rewritten.log";
+    std::vector<std::string> lines;
+    {
+        std::istringstream contents(readNMEAlogFile("gga_rmc-1.log"));
+        for (std::string line; std::getline(contents, line); ) lines.push_back(line);
+        std::ofstream copy(logPath);
+        for (const std::string & line : lines) copy << line << '\n';
+    }
+    std::filesystem::remove(LogIndex::sidecarPath(logPath.string()));
+    const LogIndex built = LogIndex::forFile(logPath.string(), 60);
+    BOOST_REQUIRE( built.isTimeOrdered() );
+
+    // The same lines in reverse order: the same size, but going back in time.
+    const auto modified = std::filesystem::last_write_time(logPath);
+    {
+        std::ofstream rewrite(logPath);
+        for (auto line = lines.rbegin(); line != lines.rend(); ++line) rewrite << *line << '\n';
+    }
+    std::filesystem::last_write_time(logPath, modified + std::chrono::seconds(10));
+    BOOST_REQUIRE_EQUAL( std::filesystem::file_size(logPath) , built.indexedBytes() );
+
+    const LogIndex rebuilt = LogIndex::forFile(logPath.string(), 60);
+    BOOST_CHECK( ! rebuilt.isTimeOrdered() );
+
+    std::filesystem::remove(LogIndex::sidecarPath(logPath.string()));
+    std::filesystem::remove(logPath);
+}
+
+BOOST_AUTO_TEST_CASE( NonPositiveInterval )
+{
+    std::stringstream log;
+    BOOST_CHECK_THROW( LogIndex::build(log, 0) , std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
@@ -10,6 +10,7 @@
 #include <fstream>
 #include <sstream>
 #include <iostream>
+#include <memory>
 
 #include "logs.h"
 #include "parseNMEA.h"
@@ -605,6 +606,40 @@ BOOST_AUTO_TEST_CASE( LogWithoutLineBreaks )
     BOOST_CHECK_EQUAL( positions.size() , expectedSize );
 }
 
+BOOST_AUTO_TEST_CASE( FinalSentenceWithoutLineBreak )
+{
+    std::stringstream log;
+    log << validGLLSentence << std::endl << validRMCSentence;
+
+    std::vector<Position> positions = positionsFromLog(log);
+
+    BOOST_REQUIRE_EQUAL( positions.size() , 2 );
+    BOOST_CHECK_CLOSE( positions[1].latitude() , rmcPos.latitude() , percentageAccuracy );
+}
+
+BOOST_AUTO_TEST_CASE( StreamThatFailsBeforeEnd )
+{
+    // Reads fail, but the end of the stream is never reached.
+    auto failedLog = []
+    {
+        auto log = std::make_unique<std::stringstream>(validGLLSentence + "\n");
+        log->setstate(std::ios::failbit);
+        return log;
+    };
+
+    BOOST_CHECK( positionsFromLog(*failedLog()).empty() );
+    ParseStats stats;
+    BOOST_CHECK( positionsFromLog(*failedLog(), stats).empty() );
+    BOOST_CHECK( fixedPositionsFromLog(*failedLog()).empty() );
+    BOOST_CHECK( fixesFromLog(*failedLog()).empty() );
+    BOOST_CHECK( fixesInTimeWindow(*failedLog(), 0, 86400).empty() );
+
+    BatchParser parser;
+    std::vector<Position> positions;
+    BOOST_CHECK( !parser.parseBatch(*failedLog(), positions, 100) );
+    BOOST_CHECK( positions.empty() );
+}
+
 BOOST_AUTO_TEST_CASE( LogWithIllFormedSentences )
 {
     std::stringstream log;
@@ -752,3 +787,150 @@ BOOST_AUTO_TEST_CASE( LargeLog_GGA_RMC )
 BOOST_AUTO_TEST_SUITE_END()
 
 /////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( PositionsFromLogStats )
+
+const std::string validGLLSentence = "$GPGLL,5425.31,N,107.03,W,82610*69";
+const std::string validRMCSentence = "$GPRMC,113922.000,A,3722.5993,N,00559.2458,W,0.000,0.00,150914,,A*62";
+
+std::string mixedLog()
+{
+    std::stringstream log;
+    log << "@Sonygps/ver3.0/wgs-84/" << std::endl;                              // ill-formed
+    log << validGLLSentence << std::endl;
+    log << "$GPGLL,5425.31,N,107.03,W,82610*24" << std::endl;                   // bad checksum
+    log << "$GPMSS,55,27,318.0,100,*66" << std::endl;                           // unsupported
+    log << std::endl;                                                           // blank, not counted
+    log << "$GPGLL,5425.31,X,107.03,W,82610*7F" << std::endl;                   // invalid data
+    log << validRMCSentence << std::endl;
+    return log.str();
+}
+
+BOOST_AUTO_TEST_CASE( CountsEachRejectReason )
+{
+    std::stringstream log(mixedLog());
+    ParseStats stats;
+
+    std::vector<Position> positions = positionsFromLog(log, stats);
+
+    BOOST_CHECK_EQUAL( positions.size() , 2u );
+    BOOST_CHECK_EQUAL( stats.linesRead , 6u );
+    BOOST_CHECK_EQUAL( stats.accepted , 2u );
+    BOOST_CHECK_EQUAL( stats.illFormed , 1u );
+    BOOST_CHECK_EQUAL( stats.badChecksum , 1u );
+    BOOST_CHECK_EQUAL( stats.unsupportedFormat , 1u );
+    BOOST_CHECK_EQUAL( stats.invalidData , 1u );
+    BOOST_CHECK_EQUAL( stats.rejected() , 4u );
+    BOOST_CHECK_EQUAL( stats.accepted + stats.rejected() , stats.linesRead );
+}
+
+BOOST_AUTO_TEST_CASE( CountsBytesOfNonBlankLines )
+{
+    std::stringstream log;
+    log << validGLLSentence << std::endl << std::endl << validRMCSentence << std::endl;
+    ParseStats stats;
+
+    positionsFromLog(log, stats);
+
+    BOOST_CHECK_EQUAL( stats.bytesRead , validGLLSentence.length() + validRMCSentence.length() );
+}
+
+BOOST_AUTO_TEST_CASE( CallbackReceivesRejectedLines )
+{
+    std::stringstream log(mixedLog());
+    ParseStats stats;
+    std::vector<std::pair<RejectReason,std::string>> rejects;
+
+    positionsFromLog(log, stats, [&](RejectReason reason, const std::string & line)
+    {
+        rejects.emplace_back(reason, line);
+    });
+
+    BOOST_REQUIRE_EQUAL( rejects.size() , 4u );
+    BOOST_CHECK( rejects[0].first == RejectReason::IllFormed );
+    BOOST_CHECK( rejects[1].first == RejectReason::BadChecksum );
+    BOOST_CHECK( rejects[2].first == RejectReason::UnsupportedFormat );
+    BOOST_CHECK( rejects[3].first == RejectReason::InvalidData );
+    BOOST_CHECK_EQUAL( rejects[3].second , "$GPGLL,5425.31,X,107.03,W,82610*7F" );
+}
+
+BOOST_AUTO_TEST_CASE( StatsAccumulateAcrossRuns )
+{
+    ParseStats total;
+    for (int run = 0; run < 3; ++run)
+    {
+        std::stringstream log(mixedLog());
+        ParseStats local;
+        positionsFromLog(log, local);
+        total += local;
+    }
+
+    BOOST_CHECK_EQUAL( total.linesRead , 18u );
+    BOOST_CHECK_EQUAL( total.accepted , 6u );
+    BOOST_CHECK_EQUAL( total.rejected() , 12u );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( FixesFromLog )
+
+BOOST_AUTO_TEST_CASE( TimeOfDay )
+{
+    BOOST_CHECK_EQUAL( timeOfDay("000000") , 0 );
+    BOOST_CHECK_EQUAL( timeOfDay("094627.000") , 9*3600 + 46*60 + 27 );
+    BOOST_CHECK_EQUAL( timeOfDay("82319") , 8*3600 + 23*60 + 19 );
+    BOOST_CHECK_CLOSE( timeOfDay("235959.5") , 86399.5 , 0.0001 );
+}
+
+BOOST_AUTO_TEST_CASE( InvalidTimeOfDay )
+{
+    BOOST_CHECK_THROW( timeOfDay("") , std::invalid_argument );
+    BOOST_CHECK_THROW( timeOfDay(".5") , std::invalid_argument );
+    BOOST_CHECK_THROW( timeOfDay("noon") , std::invalid_argument );
+    BOOST_CHECK_THROW( timeOfDay("246000") , std::invalid_argument );
+    BOOST_CHECK_THROW( timeOfDay("126100") , std::invalid_argument );
+    BOOST_CHECK_THROW( timeOfDay("1234567") , std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_CASE( SentenceTimes )
+{
+    BOOST_CHECK_EQUAL( interpretSentenceTime(parseSentenceData("$GPGLL,5425.31,N,107.03,W,82610*69")) , 8*3600 + 26*60 + 10 );
+    BOOST_CHECK_EQUAL( interpretSentenceTime(parseSentenceData("$GPRMC,113922.000,A,3722.5993,N,00559.2458,W,0.000,0.00,150914,,A*62")) , 11*3600 + 39*60 + 22 );
+    BOOST_CHECK_THROW( interpretSentenceTime(parseSentenceData("$GPMSS,55,27,318.0,100,*66")) , std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_CASE( LargeLog_GGA_RMC )
+{
+    std::fstream log = PositionsFromLog::openNMEAlogFile("gga_rmc-1.log");
+
+    std::vector<Fix> fixes = fixesFromLog(log);
+
+    BOOST_REQUIRE_EQUAL( fixes.size() , 632u );
+    // Pos 0: $GPGGA,094627.000,3723.1622,N,00559.5788,W,1,0,,30.0,M,,M,,*7A
+    BOOST_CHECK_CLOSE( fixes[0].position.latitude() , ddmTodd("3723.1622") , 0.0001 );
+    BOOST_CHECK_EQUAL( fixes[0].time , 9*3600 + 46*60 + 27 );
+    // Pos 501: $GPRMC,113720.000,A,3722.5563,N,00559.2403,W,0.000,0.00,150914,,A*63
+    BOOST_CHECK_EQUAL( fixes[501].time , 11*3600 + 37*60 + 20 );
+}
+
+BOOST_AUTO_TEST_CASE( StageCanDropAndModifyFixes )
+{
+    std::fstream log = PositionsFromLog::openNMEAlogFile("gll.log");
+
+    std::vector<Fix> fixes = fixesFromLog(log, [](Fix & fix)
+    {
+        fix.time += 1;
+        return fix.time < 12*3600;
+    });
+
+    BOOST_REQUIRE( ! fixes.empty() );
+    // Pos 0: $GPGLL,5425.32,N,107.11,W,82319*65
+    BOOST_CHECK_EQUAL( fixes[0].time , 8*3600 + 23*60 + 20 );
+    for (const Fix & fix : fixes) BOOST_CHECK_LT( fix.time , 12*3600 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
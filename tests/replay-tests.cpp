@@ -0,0 +1,200 @@
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "earth.h"
+#include "parseNMEA.h"
+#include "encodeNMEA.h"
+#include "replay.h"
+
+using namespace GPS;
+using namespace NMEA;
+
+namespace
+{
+  const std::string sampleLog = "$GPGLL,5425.32,N,107.11,W,82319*65\n"
+                                "\n"
+                                "$GPGLL,5425.32,N,107.1,W,82429*50\r\n"
+                                "$GPGLL,5425.31,N,107.09,W,82446*62";
+
+  // Reads everything from a file descriptor until end of file.
+  std::string readAll(int fd)
+  {
+      std::string result;
+      char buffer[4096];
+      ssize_t n;
+      while ((n = ::read(fd, buffer, sizeof(buffer))) > 0) result.append(buffer, n);
+      return result;
+  }
+
+  // A UDP socket bound to an ephemeral port on the loopback interface.
+  struct LoopbackReceiver
+  {
+      int fd;
+      std::uint16_t port;
+
+      LoopbackReceiver()
+      {
+          fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+          sockaddr_in address {};
+          address.sin_family = AF_INET;
+          address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+          BOOST_REQUIRE( ::bind(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) == 0 );
+          socklen_t length = sizeof(address);
+          ::getsockname(fd, reinterpret_cast<sockaddr *>(&address), &length);
+          port = ntohs(address.sin_port);
+          // Large enough for every test's traffic, so no datagram is dropped.
+          const int bufferBytes = 1 << 20;
+          ::setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &bufferBytes, sizeof(bufferBytes));
+      }
+
+      ~LoopbackReceiver() { ::close(fd); }
+
+      std::string receive()
+      {
+          char buffer[65536];
+          const ssize_t n = ::recv(fd, buffer, sizeof(buffer), 0);
+          return n > 0 ? std::string(buffer, n) : std::string();
+      }
+  };
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( ReplayTests )
+
+BOOST_AUTO_TEST_CASE( LogThroughPipe )
+{
+    int fds[2];
+    BOOST_REQUIRE( ::pipe(fds) == 0 );
+
+    std::string received;
+    std::thread reader([&]{ received = readAll(fds[0]); });
+    {
+        ReplaySink sink = ReplaySink::toFileDescriptor(fds[1]);
+        const ReplayStats stats = replay(logSource(sampleLog, 2), sink);
+        BOOST_CHECK_EQUAL( stats.sentences, 6 );
+    }
+    ::close(fds[1]);
+    reader.join();
+    ::close(fds[0]);
+
+    // Blank lines are dropped, line endings normalised, and a final newline added.
+    const std::string once = "$GPGLL,5425.32,N,107.11,W,82319*65\n"
+                             "$GPGLL,5425.32,N,107.1,W,82429*50\n"
+                             "$GPGLL,5425.31,N,107.09,W,82446*62\n";
+    BOOST_CHECK_EQUAL( received, once + once );
+}
+
+BOOST_AUTO_TEST_CASE( SyntheticTrafficParses )
+{
+    int fds[2];
+    BOOST_REQUIRE( ::pipe(fds) == 0 );
+
+    std::string received;
+    std::thread reader([&]{ received = readAll(fds[0]); });
+    {
+        ReplaySink sink = ReplaySink::toFileDescriptor(fds[1]);
+        ReplayOptions options;
+        options.maxSentences = 1000;
+        replay(syntheticSource(Earth::CliftonCampus, 200, 10, 5), sink, options);
+    }
+    ::close(fds[1]);
+    reader.join();
+    ::close(fds[0]);
+
+    std::istringstream traffic(received);
+    const std::vector<Fix> fixes = fixesFromLog(traffic);
+    BOOST_REQUIRE_EQUAL( fixes.size(), 1000 );
+    for (const Fix & fix : fixes)
+    {
+        BOOST_CHECK_CLOSE( Position::horizontalDistanceBetween(fix.position, Earth::CliftonCampus), 200, 0.1 );
+    }
+    BOOST_CHECK_CLOSE( fixes.back().time, 499 / 5.0, 0.0001 );
+}
+
+BOOST_AUTO_TEST_CASE( UDPLoopback )
+{
+    LoopbackReceiver receiver;
+
+    ReplaySink sink = ReplaySink::toUDP("127.0.0.1", receiver.port, 0);
+    ReplayOptions options;
+    options.maxSentences = 10;
+    replay(syntheticSource(Earth::CliftonCampus, 200, 10, 5), sink, options);
+
+    for (int i = 0; i < 10; ++i)
+    {
+        const std::string datagram = receiver.receive();
+        BOOST_REQUIRE_EQUAL( datagram.back(), '\n' );
+        BOOST_CHECK( fixFromLine(datagram.substr(0, datagram.size() - 1)).has_value() );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( UDPPacksSentences )
+{
+    LoopbackReceiver receiver;
+    {
+        ReplaySink sink = ReplaySink::toUDP("127.0.0.1", receiver.port, 1472);
+        ReplayOptions options;
+        options.maxSentences = 100;
+        replay(syntheticSource(Earth::CliftonCampus, 200, 10, 5), sink, options);
+    }
+
+    std::size_t sentences = 0, datagrams = 0;
+    while (sentences < 100)
+    {
+        const std::string datagram = receiver.receive();
+        BOOST_REQUIRE( !datagram.empty() );
+        BOOST_CHECK_LE( datagram.size(), 1472 );
+        BOOST_CHECK_EQUAL( datagram.back(), '\n' );
+        sentences += std::count(datagram.begin(), datagram.end(), '\n');
+        ++datagrams;
+    }
+    BOOST_CHECK_EQUAL( sentences, 100 );
+    BOOST_CHECK_LT( datagrams, 10 );
+}
+
+BOOST_AUTO_TEST_CASE( InvalidAddress )
+{
+    BOOST_CHECK_THROW( ReplaySink::toUDP("localhost:x", 9), std::runtime_error );
+}
+
+BOOST_AUTO_TEST_CASE( HoldsRate )
+{
+    int fds[2];
+    BOOST_REQUIRE( ::pipe(fds) == 0 );
+    std::thread reader([&]{ readAll(fds[0]); });
+
+    ReplayStats stats;
+    {
+        ReplaySink sink = ReplaySink::toFileDescriptor(fds[1]);
+        ReplayOptions options;
+        options.sentencesPerSecond = 4000;
+        options.batchSize = 20;
+        options.maxSentences = 820;
+        stats = replay(syntheticSource(Earth::CliftonCampus, 200, 10, 5), sink, options);
+    }
+    ::close(fds[1]);
+    reader.join();
+    ::close(fds[0]);
+
+    // The last batch is due after 800 sentences, at 0.2s.
+    BOOST_CHECK_EQUAL( stats.sentences, 820 );
+    BOOST_CHECK_GE( stats.elapsed.count(), 0.2 );
+    BOOST_CHECK_LT( stats.elapsed.count(), 1.0 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,169 @@
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <cmath>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "logs.h"
+#include "earth.h"
+#include "parseNMEA.h"
+#include "resample.h"
+
+using namespace GPS;
+
+namespace
+{
+  std::vector<Fix> resampleStreaming(const std::vector<Fix> & fixes, seconds interval, seconds maxGap, GapPolicy policy)
+  {
+      Resampler resampler(interval, maxGap, policy);
+      std::vector<Fix> samples;
+      for (const Fix & fix : fixes) resampler.add(fix, samples);
+      return samples;
+  }
+
+  std::vector<seconds> timesOf(const std::vector<Fix> & fixes)
+  {
+      std::vector<seconds> times;
+      for (const Fix & fix : fixes) times.push_back(fix.time);
+      return times;
+  }
+
+  const Position A(52.9, -1.2, 100);
+  const Position B(52.9, -1.1, 200);
+  const Position C(53.0, -1.1, 0);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( InterpolateTests )
+
+const double percentageAccuracy = 0.0001;
+
+BOOST_AUTO_TEST_CASE( Endpoints )
+{
+    const Position start = interpolate(A, B, 0);
+    const Position end = interpolate(A, B, 1);
+
+    BOOST_CHECK_EQUAL( start.latitude(), A.latitude() );
+    BOOST_CHECK_EQUAL( start.longitude(), A.longitude() );
+    BOOST_CHECK_EQUAL( end.latitude(), B.latitude() );
+    BOOST_CHECK_EQUAL( end.elevation(), B.elevation() );
+}
+
+BOOST_AUTO_TEST_CASE( AlongTheGreatCircle )
+{
+    // The great circle between two points on a parallel bulges towards the pole.
+    const Position mid = interpolate(Position(45, 0), Position(45, 90), 0.5);
+
+    BOOST_CHECK_CLOSE( mid.latitude(), radToDeg(std::atan(std::sqrt(2.0))), percentageAccuracy );
+    BOOST_CHECK_CLOSE( mid.longitude(), 45, percentageAccuracy );
+}
+
+BOOST_AUTO_TEST_CASE( DistanceProportionalToFraction )
+{
+    const metres total = Position::horizontalDistanceBetween(A, C);
+    for (double fraction : {0.1, 0.25, 0.5, 0.9})
+    {
+        const Position p = interpolate(A, C, fraction);
+        BOOST_CHECK_CLOSE( Position::horizontalDistanceBetween(A, p), fraction * total, percentageAccuracy );
+        BOOST_CHECK_CLOSE( Position::horizontalDistanceBetween(p, C), (1 - fraction) * total, percentageAccuracy );
+        BOOST_CHECK_CLOSE( p.elevation(), 100 * (1 - fraction), percentageAccuracy );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( CoincidentPositions )
+{
+    const Position p = interpolate(A, A, 0.3);
+
+    BOOST_CHECK_CLOSE( p.latitude(), A.latitude(), percentageAccuracy );
+    BOOST_CHECK_CLOSE( p.longitude(), A.longitude(), percentageAccuracy );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( ResamplerTests )
+
+BOOST_AUTO_TEST_CASE( InvalidParameters )
+{
+    BOOST_CHECK_THROW( Resampler(0, 10) , std::invalid_argument );
+    BOOST_CHECK_THROW( Resampler(1, -1) , std::invalid_argument );
+    BOOST_CHECK_THROW( resampleTrack({}, -1, 10) , std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_CASE( SamplesOnTheGrid )
+{
+    const std::vector<Fix> fixes { {A, 10.5}, {B, 13}, {C, 20} };
+
+    const std::vector<Fix> samples = resampleStreaming(fixes, 2, 60, GapPolicy::Omit);
+
+    BOOST_CHECK( timesOf(samples) == std::vector<seconds>({12, 14, 16, 18, 20}) );
+    BOOST_CHECK_EQUAL( samples.back().position.latitude(), C.latitude() );
+    // 12s is 60% of the way from A to B.
+    BOOST_CHECK_CLOSE( samples[0].position.elevation(), 160, 0.0001 );
+}
+
+BOOST_AUTO_TEST_CASE( GapPolicies )
+{
+    const std::vector<Fix> fixes { {A, 0}, {B, 10}, {C, 100} };
+
+    const std::vector<Fix> interpolated = resampleStreaming(fixes, 10, 30, GapPolicy::Interpolate);
+    const std::vector<Fix> omitted = resampleStreaming(fixes, 10, 30, GapPolicy::Omit);
+    const std::vector<Fix> held = resampleStreaming(fixes, 10, 30, GapPolicy::HoldLast);
+
+    BOOST_CHECK_EQUAL( interpolated.size(), 11 );
+    BOOST_CHECK( timesOf(omitted) == std::vector<seconds>({0, 10, 100}) );
+    BOOST_REQUIRE_EQUAL( held.size(), 11 );
+    for (int i = 2; i < 10; ++i)
+    {
+        BOOST_CHECK_EQUAL( held[i].position.longitude(), B.longitude() );
+        BOOST_CHECK_NE( interpolated[i].position.latitude(), B.latitude() );
+    }
+    BOOST_CHECK_EQUAL( held.back().position.latitude(), C.latitude() );
+}
+
+BOOST_AUTO_TEST_CASE( AcrossMidnight )
+{
+    const std::vector<Fix> fixes { {A, 86395}, {A, 86395}, {B, 5} };
+
+    const std::vector<Fix> samples = resampleStreaming(fixes, 5, 60, GapPolicy::Omit);
+
+    BOOST_CHECK( timesOf(samples) == std::vector<seconds>({86395, 0, 5}) );
+    BOOST_CHECK_CLOSE( samples[1].position.elevation(), 150, 0.0001 );
+}
+
+BOOST_AUTO_TEST_CASE( BatchMatchesStreamingOnLog )
+{
+    std::string logFilepath = LogFiles::NMEALogsDir + "gll.log";
+    std::ifstream log{logFilepath};
+    BOOST_REQUIRE_MESSAGE( log.good() , "Could not open log file: " + logFilepath );
+    const std::vector<Fix> fixes = NMEA::fixesFromLog(log);
+    BOOST_REQUIRE( !fixes.empty() );
+
+    for (GapPolicy policy : {GapPolicy::Interpolate, GapPolicy::Omit, GapPolicy::HoldLast})
+    {
+        const std::vector<Fix> streamed = resampleStreaming(fixes, 1, 30, policy);
+        const std::vector<Fix> batched = resampleTrack(fixes, 1, 30, policy);
+
+        BOOST_REQUIRE_EQUAL( batched.size(), streamed.size() );
+        for (std::size_t i = 0; i < streamed.size(); ++i)
+        {
+            BOOST_REQUIRE_EQUAL( batched[i].time, streamed[i].time );
+            BOOST_REQUIRE_SMALL( batched[i].position.latitude() - streamed[i].position.latitude(), 1e-9 );
+            BOOST_REQUIRE_SMALL( batched[i].position.longitude() - streamed[i].position.longitude(), 1e-9 );
+            BOOST_REQUIRE_SMALL( batched[i].position.elevation() - streamed[i].position.elevation(), 1e-6 );
+        }
+    }
+
+    // gll.log has gaps of more than 30s, so omitting them drops samples.
+    BOOST_CHECK_LT( resampleTrack(fixes, 1, 30, GapPolicy::Omit).size(),
+                    resampleTrack(fixes, 1, 30, GapPolicy::Interpolate).size() );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
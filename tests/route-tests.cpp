@@ -0,0 +1,146 @@
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include "geometry.h"
+#include "earth.h"
+#include "route.h"
+
+using namespace GPS;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( RouteFromGPX )
+
+BOOST_AUTO_TEST_CASE( ReadsRoutePoints )
+{
+    std::stringstream gpx;
+    gpx << "<?xml version=\"1.0\"?><gpx><rte><name>Clifton</name>"
+        << "<rtept lat=\"52.9\" lon=\"-1.2\"><ele>58</ele><name>A</name></rtept>"
+        << "<rtept lon='-1.1' lat='52.95'/>"
+        << "</rte></gpx>";
+
+    std::vector<Position> route = routeFromGPX(gpx);
+
+    BOOST_REQUIRE_EQUAL( route.size() , 2u );
+    BOOST_CHECK_EQUAL( route[0].latitude() , 52.9 );
+    BOOST_CHECK_EQUAL( route[0].longitude() , -1.2 );
+    BOOST_CHECK_EQUAL( route[0].elevation() , 58 );
+    BOOST_CHECK_EQUAL( route[1].latitude() , 52.95 );
+    BOOST_CHECK_EQUAL( route[1].elevation() , 0 );
+}
+
+BOOST_AUTO_TEST_CASE( InvalidGPX )
+{
+    std::stringstream noPoints("<gpx><rte></rte></gpx>");
+    std::stringstream missingLon("<gpx><rte><rtept lat=\"52.9\"/></rte></gpx>");
+    std::stringstream badLat("<gpx><rte><rtept lat=\"north\" lon=\"1\"/></rte></gpx>");
+
+    BOOST_CHECK_THROW( routeFromGPX(noPoints) , std::invalid_argument );
+    BOOST_CHECK_THROW( routeFromGPX(missingLon) , std::invalid_argument );
+    BOOST_CHECK_THROW( routeFromGPX(badLat) , std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( RouteDeviation )
+
+const double percentageAccuracy = 0.5;
+
+// A route heading due north from CliftonCampus, with points 100m apart.
+std::vector<Position> northboundRoute(int numPoints)
+{
+    std::vector<Position> route;
+    for (int i = 0; i < numPoints; ++i)
+    {
+        route.emplace_back(Earth::CliftonCampus.latitude() + Earth::latitudeSubtendedBy(100 * i),
+                           Earth::CliftonCampus.longitude());
+    }
+    return route;
+}
+
+// A Position 'north' metres along and 'east' metres beside the northbound route.
+Position offRoute(metres north, metres east)
+{
+    const degrees lat = Earth::CliftonCampus.latitude() + Earth::latitudeSubtendedBy(north);
+    return Position(lat, Earth::CliftonCampus.longitude() + Earth::longitudeSubtendedBy(east, lat));
+}
+
+BOOST_AUTO_TEST_CASE( InvalidMonitors )
+{
+    BOOST_CHECK_THROW( RouteDeviationMonitor({Earth::CliftonCampus}, 50) , std::invalid_argument );
+    BOOST_CHECK_THROW( RouteDeviationMonitor(northboundRoute(3), 0) , std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_CASE( FollowingTheRoute )
+{
+    RouteDeviationMonitor monitor(northboundRoute(100), 50);
+
+    for (int i = 0; i < 98; ++i)
+    {
+        RouteDeviationMonitor::Match match = monitor.update(offRoute(100 * i + 50, 10));
+        BOOST_CHECK( ! match.deviating );
+        BOOST_CHECK_EQUAL( match.segment , static_cast<std::size_t>(i) );
+        BOOST_CHECK_CLOSE( match.crossTrackDistance , 10 , percentageAccuracy );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( DeviatingAndRejoining )
+{
+    RouteDeviationMonitor monitor(northboundRoute(100), 50);
+
+    BOOST_CHECK( ! monitor.update(offRoute(1050, 0)).deviating );
+
+    RouteDeviationMonitor::Match match = monitor.update(offRoute(1150, 200));
+    BOOST_CHECK( match.deviating );
+    BOOST_CHECK_EQUAL( match.segment , 11u );
+    BOOST_CHECK_CLOSE( match.crossTrackDistance , 200 , percentageAccuracy );
+
+    // Rejoining much further along the route.
+    match = monitor.update(offRoute(5050, -20));
+    BOOST_CHECK( ! match.deviating );
+    BOOST_CHECK_EQUAL( match.segment , 50u );
+    BOOST_CHECK_CLOSE( match.crossTrackDistance , 20 , percentageAccuracy );
+}
+
+BOOST_AUTO_TEST_CASE( BeyondTheEndOfTheRoute )
+{
+    RouteDeviationMonitor monitor(northboundRoute(10), 50);
+
+    RouteDeviationMonitor::Match match = monitor.update(offRoute(1000, 0));
+    BOOST_CHECK( match.deviating );
+    BOOST_CHECK_EQUAL( match.segment , 8u );
+    BOOST_CHECK_CLOSE( match.crossTrackDistance , 100 , percentageAccuracy );
+}
+
+BOOST_AUTO_TEST_CASE( NearestAtTheEdgeOfTheSearchWindow )
+{
+    // A fix between two north-south stretches of route, 999.5m from one and 999.8m from the
+    // other, with a grid cell boundary just beyond the nearer.  The search window must still
+    // reach the nearer stretch's cell, or the further one is reported.
+    const degrees lat = Earth::CliftonCampus.latitude(), boundary = -1.15, cellSize = 0.05;
+    const double metresPerDegree = degToRad(1) * Earth::meanRadius * std::cos(degToRad(lat));
+    for (double side : {-1.0, 1.0}) // the nearer stretch is west, then east, of the fix
+    {
+        const degrees nearLon = boundary + side * 1e-9;
+        const degrees fixLon = nearLon - side * 999.5 / metresPerDegree;
+        const degrees farLon = fixLon - side * 999.8 / metresPerDegree;
+        RouteDeviationMonitor monitor({Position(lat - 0.02, nearLon), Position(lat + 0.045, nearLon),
+                                       Position(lat + 0.045, farLon), Position(lat - 0.02, farLon)}, 1000, cellSize);
+
+        RouteDeviationMonitor::Match match = monitor.update(Position(lat, fixLon));
+        BOOST_CHECK( ! match.deviating );
+        BOOST_CHECK_EQUAL( match.segment , 0u );
+        BOOST_CHECK_CLOSE( match.crossTrackDistance , 999.5 , 0.001 );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
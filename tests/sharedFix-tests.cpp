@@ -0,0 +1,155 @@
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+
+#include "logs.h"
+#include "sharedFix.h"
+
+using namespace GPS;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( SharedFixTests )
+
+// A segment name that no other test process uses.
+std::string segmentName(const std::string & test)
+{
+    return "/parseNMEA-tests-" + std::to_string(::getpid()) + "-" + test;
+}
+
+// Every field of the i'th fix is derived from i, so a torn copy is inconsistent.
+Fix countedFix(unsigned long long i)
+{
+    return { Position(std::fmod(i * 1e-3, 90), std::fmod(i * 2e-3, 180), i % 1000), static_cast<seconds>(i) };
+}
+
+bool consistent(const PublishedFix & published)
+{
+    const unsigned long long i = static_cast<unsigned long long>(published.fix.time);
+    const Fix expected = countedFix(i);
+    return published.fix.position.latitude() == expected.position.latitude()
+        && published.fix.position.longitude() == expected.position.longitude()
+        && published.fix.position.elevation() == expected.position.elevation()
+        && published.groundSpeed == static_cast<speed>(i)
+        && published.sequence == i;
+}
+
+BOOST_AUTO_TEST_CASE( NothingBeforeFirstPublish )
+{
+    FixPublisher publisher(segmentName("empty"));
+    FixSubscriber subscriber(segmentName("empty"));
+
+    BOOST_CHECK_EQUAL( subscriber.sequence(), 0 );
+    BOOST_CHECK( !subscriber.tryLatest().has_value() );
+    BOOST_CHECK( !subscriber.latest().has_value() );
+}
+
+BOOST_AUTO_TEST_CASE( ReadsLatestFix )
+{
+    FixPublisher publisher(segmentName("latest"));
+    FixSubscriber subscriber(segmentName("latest"));
+
+    publisher.publish({Position(52.9, -1.2, 58), 3600});
+    const auto before = std::chrono::steady_clock::now().time_since_epoch();
+    publisher.publish({Position(-33.8688, 151.2093, -4.5), 3601.5}, 12.5);
+
+    const std::optional<PublishedFix> latest = subscriber.tryLatest();
+    BOOST_REQUIRE( latest.has_value() );
+    BOOST_CHECK_EQUAL( latest->fix.position.latitude(), -33.8688 );
+    BOOST_CHECK_EQUAL( latest->fix.position.longitude(), 151.2093 );
+    BOOST_CHECK_EQUAL( latest->fix.position.elevation(), -4.5 );
+    BOOST_CHECK_EQUAL( latest->fix.time, 3601.5 );
+    BOOST_CHECK_EQUAL( latest->groundSpeed, 12.5 );
+    BOOST_CHECK_EQUAL( latest->sequence, 2 );
+    BOOST_CHECK( latest->publishedAt >= before );
+    BOOST_CHECK_EQUAL( publisher.published(), 2 );
+    BOOST_CHECK_EQUAL( subscriber.sequence(), 2 );
+}
+
+BOOST_AUTO_TEST_CASE( UnknownSpeedIsNaN )
+{
+    FixPublisher publisher(segmentName("speed"));
+    FixSubscriber subscriber(segmentName("speed"));
+    publisher.publish({Position(0, 0), 0});
+
+    BOOST_CHECK( std::isnan(subscriber.latest()->groundSpeed) );
+}
+
+BOOST_AUTO_TEST_CASE( MissingSegment )
+{
+    BOOST_CHECK_THROW( FixSubscriber(segmentName("missing")) , std::runtime_error );
+}
+
+BOOST_AUTO_TEST_CASE( SegmentRemovedWithPublisher )
+{
+    {
+        FixPublisher publisher(segmentName("removed"));
+    }
+    BOOST_CHECK_THROW( FixSubscriber(segmentName("removed")) , std::runtime_error );
+}
+
+BOOST_AUTO_TEST_CASE( PublishesLog )
+{
+    std::string logFilepath = LogFiles::NMEALogsDir + "gga_rmc-1.log";
+    std::ifstream log{logFilepath};
+    BOOST_REQUIRE_MESSAGE( log.good() , "Could not open log file: " + logFilepath );
+
+    FixPublisher publisher(segmentName("log"));
+    FixSubscriber subscriber(segmentName("log"));
+    const std::size_t published = publishFixesFromLog(log, publisher);
+
+    BOOST_CHECK_GT( published, 600 );
+    BOOST_CHECK_EQUAL( subscriber.sequence(), published );
+    BOOST_CHECK( subscriber.latest().has_value() );
+}
+
+BOOST_AUTO_TEST_CASE( NoTornReadsAcrossProcesses )
+{
+    const unsigned long long fixes = 2000000;
+    // Named before forking, as the child has a different process ID.
+    const std::string name = segmentName("processes");
+    FixPublisher publisher(name);
+
+    const pid_t child = ::fork();
+    BOOST_REQUIRE( child >= 0 );
+    if (child == 0)
+    {
+        // The reader: exits with status 1 on a torn or out-of-order copy.
+        int status = 0;
+        try {
+            FixSubscriber subscriber(name);
+            unsigned long long last = 0;
+            while (last < fixes)
+            {
+                const std::optional<PublishedFix> copy = subscriber.tryLatest();
+                if (!copy) continue;
+                if (!consistent(*copy) || copy->sequence < last) status = 1;
+                last = copy->sequence;
+            }
+        }
+        catch (const std::runtime_error &) {
+            status = 2;
+        }
+        ::_exit(status);
+    }
+
+    for (unsigned long long i = 1; i <= fixes; ++i) publisher.publish(countedFix(i), static_cast<speed>(i));
+
+    int status;
+    BOOST_REQUIRE( ::waitpid(child, &status, 0) == child );
+    BOOST_REQUIRE( WIFEXITED(status) );
+    BOOST_CHECK_EQUAL( WEXITSTATUS(status), 0 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,255 @@
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "logs.h"
+#include "earth.h"
+#include "cartesian.h"
+#include "parseNMEA.h"
+#include "similarity.h"
+
+using namespace GPS;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( SimilarityTests )
+
+const double percentTolerance = 1e-6;
+const SimilarityOptions unbanded {SimilarityMeasure::DTW, 1};
+
+// A noisy lap of an ellipse about Clifton Campus, of 'n' positions.
+std::vector<Position> lap(std::size_t n, metres radius, unsigned seed)
+{
+    std::mt19937 random(seed);
+    std::normal_distribution<double> noise(0, 5);
+    const LocalFrame frame(Earth::CliftonCampus);
+    std::vector<Position> positions;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const double angle = 2 * pi * i / n;
+        positions.push_back(frame.toPosition({radius * std::cos(angle) + noise(random),
+                                              radius * 0.6 * std::sin(angle) + noise(random), 0}));
+    }
+    return positions;
+}
+
+// The dynamic programme over the whole matrix, with cells outside the band left out.
+metres naiveDistance(const std::vector<Position> & a, const std::vector<Position> & b, SimilarityOptions options)
+{
+    const std::int64_t n = a.size(), m = b.size();
+    const std::int64_t width = std::max(static_cast<std::int64_t>(std::min(options.band, 1.0) * (n-1) * (m-1)),
+                                        std::max(n-1, m-1));
+    const metres infinity = std::numeric_limits<metres>::infinity();
+    std::vector<std::vector<metres>> cost(n, std::vector<metres>(m, infinity));
+    for (std::int64_t i = 0; i < n; ++i)
+    {
+        for (std::int64_t j = 0; j < m; ++j)
+        {
+            if (std::abs(i * (m-1) - j * (n-1)) > width) continue;
+            metres before = (i == 0 && j == 0) ? 0 : infinity;
+            if (i > 0) before = std::min(before, cost[i-1][j]);
+            if (j > 0) before = std::min(before, cost[i][j-1]);
+            if (i > 0 && j > 0) before = std::min(before, cost[i-1][j-1]);
+
+            const metres distance = Position::horizontalDistanceBetween(a[i], b[j]);
+            cost[i][j] = options.measure == SimilarityMeasure::DTW ? before + distance : std::max(before, distance);
+        }
+    }
+    return cost[n-1][m-1];
+}
+
+std::vector<Position> logPositions(const std::string & filename)
+{
+    std::string logFilepath = LogFiles::NMEALogsDir + filename;
+    std::ifstream log{logFilepath};
+    BOOST_REQUIRE_MESSAGE( log.good() , "Could not open log file: " + logFilepath );
+    return NMEA::positionsFromLog(log);
+}
+
+BOOST_AUTO_TEST_CASE( MatchesNaiveDistances )
+{
+    const std::vector<std::vector<Position>> tracks {lap(200, 500, 1), lap(130, 520, 2), lap(1, 500, 3), lap(61, 300, 4)};
+    for (SimilarityMeasure measure : {SimilarityMeasure::DTW, SimilarityMeasure::DiscreteFrechet})
+    {
+        for (double band : {0.0, 0.02, 0.1, 0.5, 1.0})
+        {
+            const SimilarityOptions options {measure, band};
+            for (const std::vector<Position> & a : tracks)
+            {
+                for (const std::vector<Position> & b : tracks)
+                {
+                    BOOST_CHECK_CLOSE( trajectoryDistance(Trajectory(a), Trajectory(b), options),
+                                       naiveDistance(a, b, options), percentTolerance );
+                }
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( MatchesNaiveDistancesOnLogs )
+{
+    const std::vector<Position> a = logPositions("gga_rmc-1.log");
+    const std::vector<Position> b = logPositions("gll.log");
+    for (SimilarityMeasure measure : {SimilarityMeasure::DTW, SimilarityMeasure::DiscreteFrechet})
+    {
+        for (double band : {0.1, 1.0})
+        {
+            const SimilarityOptions options {measure, band};
+            BOOST_CHECK_CLOSE( trajectoryDistance(Trajectory(a), Trajectory(b), options),
+                               naiveDistance(a, b, options), percentTolerance );
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( IdenticalAndSymmetric )
+{
+    const Trajectory a(lap(300, 400, 5)), b(lap(240, 400, 6));
+    for (SimilarityMeasure measure : {SimilarityMeasure::DTW, SimilarityMeasure::DiscreteFrechet})
+    {
+        const SimilarityOptions options {measure, 0.05};
+        BOOST_CHECK_EQUAL( trajectoryDistance(a, a, options), 0 );
+        BOOST_CHECK_CLOSE( trajectoryDistance(a, b, options), trajectoryDistance(b, a, options), percentTolerance );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( SinglePoints )
+{
+    const std::vector<Position> track = lap(50, 200, 7);
+    const Trajectory point({Earth::CliftonCampus}), trajectory(track);
+
+    metres sum = 0, greatest = 0;
+    for (const Position & position : track)
+    {
+        const metres distance = Position::horizontalDistanceBetween(Earth::CliftonCampus, position);
+        sum += distance;
+        greatest = std::max(greatest, distance);
+    }
+    BOOST_CHECK_CLOSE( trajectoryDistance(point, trajectory), sum, percentTolerance );
+    BOOST_CHECK_CLOSE( trajectoryDistance(trajectory, point), sum, percentTolerance );
+    BOOST_CHECK_CLOSE( trajectoryDistance(point, trajectory, {SimilarityMeasure::DiscreteFrechet, 0}), greatest, percentTolerance );
+    BOOST_CHECK_CLOSE( trajectoryDistance(point, Trajectory({Earth::CityCampus})),
+                       Position::horizontalDistanceBetween(Earth::CliftonCampus, Earth::CityCampus), percentTolerance );
+
+    // Distances up to half the globe.
+    const std::vector<Position> far {Earth::EquatorialAntiMeridian, Earth::Pontianak, Earth::EquatorialMeridian};
+    BOOST_CHECK_CLOSE( trajectoryDistance(Trajectory({Earth::NorthPole, Earth::CliftonCampus}), Trajectory(far), unbanded),
+                       naiveDistance({Earth::NorthPole, Earth::CliftonCampus}, far, unbanded), percentTolerance );
+}
+
+BOOST_AUTO_TEST_CASE( NarrowerBandsCostMore )
+{
+    const Trajectory a(lap(400, 500, 8)), b(lap(150, 450, 9));
+    metres previous = 0;
+    for (double band : {1.0, 0.3, 0.1, 0.01, 0.0})
+    {
+        const metres distance = trajectoryDistance(a, b, {SimilarityMeasure::DTW, band});
+        BOOST_CHECK_GE( distance, previous );
+        previous = distance;
+    }
+}
+
+BOOST_AUTO_TEST_CASE( LowerBounds )
+{
+    std::vector<Trajectory> tracks;
+    for (unsigned seed = 10; seed < 16; ++seed) tracks.emplace_back(lap(100 + 20 * seed, 300 + 30 * seed, seed));
+    tracks.emplace_back(logPositions("gga_rmc-2.log"));
+
+    for (SimilarityMeasure measure : {SimilarityMeasure::DTW, SimilarityMeasure::DiscreteFrechet})
+    {
+        for (double band : {0.0, 0.05, 1.0})
+        {
+            const SimilarityOptions options {measure, band};
+            for (const Trajectory & a : tracks)
+            {
+                for (const Trajectory & b : tracks)
+                {
+                    const metres bound = trajectoryLowerBound(a, b, options);
+                    BOOST_CHECK_GE( bound, 0 );
+                    BOOST_CHECK_LE( bound, trajectoryDistance(a, b, options) * (1 + 1e-9) );
+                }
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( EarlyAbandoning )
+{
+    const Trajectory a(lap(300, 500, 20)), b(lap(280, 600, 21));
+    for (SimilarityMeasure measure : {SimilarityMeasure::DTW, SimilarityMeasure::DiscreteFrechet})
+    {
+        const SimilarityOptions options {measure, 0.1};
+        const metres distance = trajectoryDistance(a, b, options);
+        BOOST_CHECK_EQUAL( trajectoryDistance(a, b, options, distance * 1.001), distance );
+        BOOST_CHECK_EQUAL( trajectoryDistance(a, b, options, distance * 0.999), std::numeric_limits<metres>::infinity() );
+        BOOST_CHECK_EQUAL( trajectoryDistance(a, b, options, 0), std::numeric_limits<metres>::infinity() );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( NearestMatchesExhaustiveSearch )
+{
+    std::vector<Trajectory> candidates;
+    for (unsigned seed = 30; seed < 60; ++seed) candidates.emplace_back(lap(150 + seed, 200 + 10 * seed, seed));
+
+    for (SimilarityMeasure measure : {SimilarityMeasure::DTW, SimilarityMeasure::DiscreteFrechet})
+    {
+        const SimilarityOptions options {measure, 0.1};
+        for (metres radius : {250.0, 430.0, 700.0, 2000.0})
+        {
+            const Trajectory query(lap(180, radius, 99));
+            const std::vector<metres> distances = distanceMatrix({query}, candidates, options, 1).front();
+            const auto nearest = std::min_element(distances.begin(), distances.end());
+
+            const TrajectoryMatch match = nearestTrajectory(query, candidates, options);
+            BOOST_CHECK_EQUAL( match.index, nearest - distances.begin() );
+            BOOST_CHECK_CLOSE( match.distance, *nearest, percentTolerance );
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( ThreadCountsAgree )
+{
+    std::vector<Trajectory> queries, candidates;
+    for (unsigned seed = 0; seed < 5; ++seed) queries.emplace_back(lap(120, 300 + 50 * seed, 100 + seed));
+    for (unsigned seed = 0; seed < 9; ++seed) candidates.emplace_back(lap(100 + 10 * seed, 280 + 40 * seed, 200 + seed));
+
+    const std::vector<std::vector<metres>> serial = distanceMatrix(queries, candidates, {}, 1);
+    const std::vector<TrajectoryMatch> serialMatches = nearestTrajectories(queries, candidates, {}, 1);
+    BOOST_REQUIRE_EQUAL( serial.size(), queries.size() );
+    BOOST_REQUIRE_EQUAL( serialMatches.size(), queries.size() );
+    for (unsigned threads : {2u, 4u, 0u})
+    {
+        BOOST_CHECK( distanceMatrix(queries, candidates, {}, threads) == serial );
+        const std::vector<TrajectoryMatch> matches = nearestTrajectories(queries, candidates, {}, threads);
+        for (std::size_t q = 0; q < queries.size(); ++q)
+        {
+            BOOST_CHECK_EQUAL( matches[q].index, serialMatches[q].index );
+            BOOST_CHECK_EQUAL( matches[q].distance, serialMatches[q].distance );
+            BOOST_CHECK_EQUAL( matches[q].distance, serial[q][matches[q].index] );
+        }
+    }
+    BOOST_CHECK( distanceMatrix({}, candidates).empty() );
+}
+
+BOOST_AUTO_TEST_CASE( InvalidArguments )
+{
+    const Trajectory empty(std::vector<Position>{}), track(lap(10, 100, 40));
+    BOOST_CHECK_THROW( trajectoryDistance(empty, track), std::invalid_argument );
+    BOOST_CHECK_THROW( trajectoryDistance(track, empty), std::invalid_argument );
+    BOOST_CHECK_THROW( trajectoryLowerBound(empty, track), std::invalid_argument );
+    BOOST_CHECK_THROW( trajectoryDistance(track, track, {SimilarityMeasure::DTW, -0.1}), std::invalid_argument );
+    BOOST_CHECK_THROW( nearestTrajectory(track, {}), std::invalid_argument );
+    BOOST_CHECK_THROW( distanceMatrix({track}, {track, empty}, unbanded, 2), std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,241 @@
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "logs.h"
+#include "earth.h"
+#include "cartesian.h"
+#include "parseNMEA.h"
+#include "stops.h"
+
+using namespace GPS;
+
+namespace
+{
+  const LocalFrame campus(Earth::CliftonCampus);
+
+  Fix fixAt(metres east, metres north, seconds time)
+  {
+      return { campus.toPosition({east, north, 0}), time };
+  }
+
+  // The quadratic stay-point algorithm that StopDetector streams.
+  std::vector<Stop> referenceStops(const std::vector<Fix> & fixes, metres radius, seconds minimumDwell)
+  {
+      std::vector<Stop> stops;
+      std::size_t i = 0;
+      while (i < fixes.size())
+      {
+          std::size_t j = i + 1;
+          while (j < fixes.size() &&
+                 Position::horizontalDistanceBetween(fixes[i].position, fixes[j].position) <= radius) ++j;
+          if (j - 1 > i && fixes[j-1].time - fixes[i].time >= minimumDwell)
+          {
+              stops.push_back({fixes[i].position, fixes[i].time, fixes[j-1].time, j - i});
+              i = j;
+          }
+          else ++i;
+      }
+      return stops;
+  }
+
+  // The brute-force DBSCAN that clusterPositions() indexes.
+  Clustering referenceClustering(const std::vector<Position> & positions, metres epsilon, std::size_t minimumPoints)
+  {
+      const std::size_t n = positions.size();
+      auto neighbours = [&](std::size_t i)
+      {
+          std::vector<std::size_t> result;
+          for (std::size_t j = 0; j < n; ++j)
+              if (Position::horizontalDistanceBetween(positions[i], positions[j]) <= epsilon) result.push_back(j);
+          return result;
+      };
+
+      Clustering result;
+      result.labels.assign(n, Clustering::noise);
+      std::vector<bool> visited(n, false);
+      for (std::size_t i = 0; i < n; ++i)
+      {
+          if (visited[i]) continue;
+          visited[i] = true;
+          std::vector<std::size_t> frontier = neighbours(i);
+          if (frontier.size() < minimumPoints) continue;
+          const int cluster = static_cast<int>(result.clusterCount++);
+          result.labels[i] = cluster;
+          while (!frontier.empty())
+          {
+              const std::size_t j = frontier.back();
+              frontier.pop_back();
+              if (result.labels[j] == Clustering::noise) result.labels[j] = cluster;
+              if (visited[j]) continue;
+              visited[j] = true;
+              const std::vector<std::size_t> more = neighbours(j);
+              if (more.size() >= minimumPoints) frontier.insert(frontier.end(), more.begin(), more.end());
+          }
+      }
+      return result;
+  }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( StopDetectorTests )
+
+BOOST_AUTO_TEST_CASE( InvalidParameters )
+{
+    BOOST_CHECK_THROW( StopDetector(0, 60) , std::invalid_argument );
+    BOOST_CHECK_THROW( StopDetector(50, -1) , std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_CASE( NoStopsWhileMoving )
+{
+    std::vector<Fix> fixes;
+    for (int i = 0; i < 100; ++i) fixes.push_back(fixAt(i * 30, 0, i * 10));
+
+    BOOST_CHECK( stopsFromFixes(fixes, 50, 60).empty() );
+}
+
+BOOST_AUTO_TEST_CASE( FindsStopsLongEnough )
+{
+    std::vector<Fix> fixes;
+    seconds t = 0;
+    auto drive = [&](metres fromEast, metres toEast)
+    {
+        for (metres e = fromEast; e < toEast; e += 100) fixes.push_back(fixAt(e, 0, t += 10));
+    };
+    auto dwell = [&](metres east, seconds duration)
+    {
+        const seconds start = t + 10;
+        for (int i = 0; t + 10 <= start + duration; ++i) fixes.push_back(fixAt(east + (i % 3) * 5, (i % 2) * 5, t += 10));
+    };
+
+    drive(0, 1000);
+    dwell(1000, 600);   // a stop
+    drive(1100, 2000);
+    dwell(2000, 120);   // too short
+    drive(2100, 3000);
+    dwell(3000, 400);   // a stop, ended by finish()
+
+    const std::vector<Stop> stops = stopsFromFixes(fixes, 50, 300);
+
+    BOOST_REQUIRE_EQUAL( stops.size(), 2 );
+    BOOST_CHECK_EQUAL( stops[0].arrival, 110 );
+    BOOST_CHECK_EQUAL( stops[0].departure, 710 );
+    BOOST_CHECK_EQUAL( stops[0].fixCount, 61 );
+    BOOST_CHECK_LT( Position::horizontalDistanceBetween(stops[0].position, fixAt(1005, 2.5, 0).position), 2 );
+    BOOST_CHECK_EQUAL( stops[1].departure, fixes.back().time );
+}
+
+BOOST_AUTO_TEST_CASE( RestartsRunsOnApproach )
+{
+    // Approaching within the radius of the first Fix, then stopping just beyond it.
+    std::vector<Fix> fixes { fixAt(0, 0, 0), fixAt(40, 0, 10) };
+    for (int i = 0; i < 10; ++i) fixes.push_back(fixAt(70, 0, 20 + i * 10));
+
+    const std::vector<Stop> stops = stopsFromFixes(fixes, 50, 60);
+
+    BOOST_REQUIRE_EQUAL( stops.size(), 1 );
+    BOOST_CHECK_EQUAL( stops[0].arrival, 10 );
+    BOOST_CHECK_EQUAL( stops[0].fixCount, 11 );
+}
+
+BOOST_AUTO_TEST_CASE( MatchesQuadraticAlgorithmOnLog )
+{
+    std::string logFilepath = LogFiles::NMEALogsDir + "gga_rmc-1.log";
+    std::ifstream log{logFilepath};
+    BOOST_REQUIRE_MESSAGE( log.good() , "Could not open log file: " + logFilepath );
+    const std::vector<Fix> fixes = NMEA::fixesFromLog(log);
+
+    for (metres radius : {20.0, 50.0, 200.0})
+    {
+        const std::vector<Stop> expected = referenceStops(fixes, radius, 120);
+        const std::vector<Stop> actual = stopsFromFixes(fixes, radius, 120);
+
+        BOOST_REQUIRE_EQUAL( actual.size(), expected.size() );
+        for (std::size_t i = 0; i < actual.size(); ++i)
+        {
+            BOOST_CHECK_EQUAL( actual[i].arrival, expected[i].arrival );
+            BOOST_CHECK_EQUAL( actual[i].departure, expected[i].departure );
+            BOOST_CHECK_EQUAL( actual[i].fixCount, expected[i].fixCount );
+        }
+    }
+    BOOST_CHECK( !stopsFromFixes(fixes, 50, 120).empty() );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( ClusterPositionsTests )
+
+BOOST_AUTO_TEST_CASE( InvalidParameters )
+{
+    BOOST_CHECK_THROW( clusterPositions({}, 0, 3) , std::invalid_argument );
+    BOOST_CHECK_THROW( clusterPositions({Position(89.99999, 0)}, 10, 3) , std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_CASE( EmptyInput )
+{
+    const Clustering clustering = clusterPositions({}, 10, 3);
+
+    BOOST_CHECK( clustering.labels.empty() );
+    BOOST_CHECK_EQUAL( clustering.clusterCount, 0 );
+}
+
+BOOST_AUTO_TEST_CASE( TwoClustersAndNoise )
+{
+    std::vector<Position> positions;
+    for (int i = 0; i < 5; ++i) positions.push_back(fixAt(i * 3, 0, 0).position);
+    positions.push_back(fixAt(500, 500, 0).position);
+    for (int i = 0; i < 5; ++i) positions.push_back(fixAt(1000, i * 3, 0).position);
+
+    const Clustering clustering = clusterPositions(positions, 5, 3);
+
+    BOOST_CHECK_EQUAL( clustering.clusterCount, 2 );
+    for (int i = 0; i < 5; ++i)
+    {
+        BOOST_CHECK_EQUAL( clustering.labels[i], 0 );
+        BOOST_CHECK_EQUAL( clustering.labels[6 + i], 1 );
+    }
+    BOOST_CHECK_EQUAL( clustering.labels[5], Clustering::noise );
+}
+
+BOOST_AUTO_TEST_CASE( MatchesBruteForce )
+{
+    // Clumps of varying density, plus scattered noise, spanning the prime meridian.
+    std::mt19937 random(3);
+    std::normal_distribution<double> spread(0, 40);
+    std::uniform_real_distribution<double> anywhere(-3000, 3000);
+    const LocalFrame greenwich(Position(51.48, 0));
+    std::vector<Position> positions;
+    for (int clump = 0; clump < 8; ++clump)
+    {
+        const metres e = anywhere(random), n = anywhere(random);
+        for (int i = 0; i < 20 + clump * 10; ++i) positions.push_back(greenwich.toPosition({e + spread(random), n + spread(random), 0}));
+    }
+    for (int i = 0; i < 300; ++i) positions.push_back(greenwich.toPosition({anywhere(random), anywhere(random), 0}));
+
+    const Clustering expected = referenceClustering(positions, 25, 5);
+    const Clustering actual = clusterPositions(positions, 25, 5);
+
+    BOOST_CHECK_GT( expected.clusterCount, 4 );
+    BOOST_REQUIRE_EQUAL( actual.clusterCount, expected.clusterCount );
+    // Cluster numbers follow the order of the Positions, so they agree; a border Position
+    // within reach of two clusters may join either.
+    std::size_t disagreements = 0;
+    for (std::size_t i = 0; i < positions.size(); ++i)
+    {
+        BOOST_REQUIRE_EQUAL( actual.labels[i] == Clustering::noise, expected.labels[i] == Clustering::noise );
+        if (actual.labels[i] != expected.labels[i]) ++disagreements;
+    }
+    BOOST_CHECK_LE( disagreements, 2 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
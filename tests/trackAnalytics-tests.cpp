@@ -0,0 +1,125 @@
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "logs.h"
+#include "parseNMEA.h"
+#include "workStealing.h"
+#include "trackAnalytics.h"
+
+using namespace GPS;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( WorkStealingPoolTests )
+
+BOOST_AUTO_TEST_CASE( RunsEveryTask )
+{
+    std::atomic<int> count {0};
+    WorkStealingPool pool(4);
+    for (int i = 0; i < 1000; ++i)
+    {
+        pool.submit([&]{ ++count; });
+    }
+    pool.wait();
+
+    BOOST_CHECK_EQUAL( count.load() , 1000 );
+}
+
+BOOST_AUTO_TEST_CASE( RunsTasksSubmittedByTasks )
+{
+    std::atomic<int> count {0};
+    WorkStealingPool pool(3);
+    for (int i = 0; i < 10; ++i)
+    {
+        pool.submit([&]
+        {
+            for (int j = 0; j < 10; ++j) pool.submit([&]{ ++count; });
+        });
+    }
+    pool.wait();
+
+    BOOST_CHECK_EQUAL( count.load() , 100 );
+}
+
+BOOST_AUTO_TEST_CASE( RethrowsTaskException )
+{
+    WorkStealingPool pool(2);
+    pool.submit([]{ throw std::invalid_argument("task failed"); });
+
+    BOOST_CHECK_THROW( pool.wait() , std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( TrackAnalytics )
+
+const double percentageAccuracy = 0.0001;
+
+BOOST_AUTO_TEST_CASE( EmptyTrack )
+{
+    TrackSummary summary = summariseTrack({});
+
+    BOOST_CHECK_EQUAL( summary.numPositions , 0u );
+    BOOST_CHECK_EQUAL( summary.totalDistance , 0 );
+}
+
+BOOST_AUTO_TEST_CASE( TwoPositions )
+{
+    const Position p1(52.0, -1.5, 10);
+    const Position p2(52.1, -1.2, 40);
+
+    TrackSummary summary = summariseTrack({p1, p2});
+
+    BOOST_CHECK_EQUAL( summary.numPositions , 2u );
+    BOOST_CHECK_CLOSE( summary.totalDistance , Position::horizontalDistanceBetween(p1,p2) , percentageAccuracy );
+    BOOST_CHECK_EQUAL( summary.minLatitude , 52.0 );
+    BOOST_CHECK_EQUAL( summary.maxLatitude , 52.1 );
+    BOOST_CHECK_EQUAL( summary.minLongitude , -1.5 );
+    BOOST_CHECK_EQUAL( summary.maxLongitude , -1.2 );
+    BOOST_CHECK_EQUAL( summary.minElevation , 10 );
+    BOOST_CHECK_EQUAL( summary.maxElevation , 40 );
+}
+
+BOOST_AUTO_TEST_CASE( SummariseLogsMatchesSequential )
+{
+    std::vector<std::string> files;
+    for (int copy = 0; copy < 4; ++copy)
+    {
+        for (std::string name : {"gll.log", "gga_rmc-1.log", "gga_rmc-2.log"})
+        {
+            files.push_back(LogFiles::NMEALogsDir + name);
+        }
+    }
+
+    std::vector<TrackSummary> summaries = summariseLogs(files, 3);
+
+    BOOST_REQUIRE_EQUAL( summaries.size() , files.size() );
+    for (std::size_t i = 0; i < files.size(); ++i)
+    {
+        std::ifstream log{files[i]};
+        TrackSummary expected = summariseTrack(NMEA::positionsFromLog(log));
+
+        BOOST_CHECK_EQUAL( summaries[i].logFile , files[i] );
+        BOOST_CHECK_EQUAL( summaries[i].numPositions , expected.numPositions );
+        BOOST_CHECK_CLOSE( summaries[i].totalDistance , expected.totalDistance , percentageAccuracy );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( MissingLogFile )
+{
+    std::vector<std::string> files = {LogFiles::NMEALogsDir + "no-such-file.log"};
+
+    BOOST_CHECK_THROW( summariseLogs(files, 2) , std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
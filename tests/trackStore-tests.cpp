@@ -0,0 +1,168 @@
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+#include "trackStore.h"
+
+using namespace GPS;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( TrackStoreTests )
+
+// The i'th Fix of a test track: one a second, with a Position derived from i.
+Fix countedFix(std::size_t i)
+{
+    return { Position(std::fmod(i * 1e-4, 90), std::fmod(i * 2e-4, 180), i % 1000), static_cast<seconds>(i) };
+}
+
+bool isCountedFix(const Fix & fix, std::size_t i)
+{
+    const Fix expected = countedFix(i);
+    return fix.time == expected.time
+        && fix.position.latitude() == expected.position.latitude()
+        && fix.position.longitude() == expected.position.longitude()
+        && fix.position.elevation() == expected.position.elevation();
+}
+
+BOOST_AUTO_TEST_CASE( EmptyStore )
+{
+    const TrackStore store;
+    const TrackSnapshot snapshot = store.snapshot();
+
+    BOOST_CHECK_EQUAL( store.size(), 0 );
+    BOOST_CHECK( snapshot.empty() );
+    BOOST_CHECK( snapshot.indicesBetween(0, 86400) == std::make_pair(std::size_t{0}, std::size_t{0}) );
+    BOOST_CHECK( snapshot.fixes(0, 10).empty() );
+}
+
+BOOST_AUTO_TEST_CASE( AppendsAcrossChunksAndDirectories )
+{
+    // Enough chunks to outgrow the initial directory twice.
+    const std::size_t n = TrackStore::chunkSize * 70 + 3;
+    TrackStore store;
+    for (std::size_t i = 0; i < n; ++i) store.append(countedFix(i));
+    const TrackSnapshot snapshot = store.snapshot();
+
+    BOOST_REQUIRE_EQUAL( snapshot.size(), n );
+    bool allCorrect = true;
+    for (std::size_t i = 0; i < n; ++i) allCorrect = allCorrect && isCountedFix(snapshot[i], i);
+    BOOST_CHECK( allCorrect );
+}
+
+BOOST_AUTO_TEST_CASE( SnapshotIsStable )
+{
+    TrackStore store;
+    for (std::size_t i = 0; i < 1000; ++i) store.append(countedFix(i));
+    const TrackSnapshot before = store.snapshot();
+    for (std::size_t i = 1000; i < TrackStore::chunkSize * 40; ++i) store.append(countedFix(i));
+
+    BOOST_CHECK_EQUAL( before.size(), 1000 );
+    BOOST_CHECK( isCountedFix(before[999], 999) );
+    BOOST_CHECK_EQUAL( store.snapshot().size(), TrackStore::chunkSize * 40 );
+}
+
+BOOST_AUTO_TEST_CASE( IndexRanges )
+{
+    TrackStore store;
+    const std::size_t n = TrackStore::chunkSize * 3;
+    for (std::size_t i = 0; i < n; ++i) store.append(countedFix(i));
+    const TrackSnapshot snapshot = store.snapshot();
+
+    // A range across a chunk boundary, visited in chunk-sized spans.
+    const std::size_t first = TrackStore::chunkSize - 5, last = TrackStore::chunkSize * 2 + 5;
+    std::vector<std::size_t> spanLengths;
+    snapshot.forEachSpan(first, last, [&](std::span<const Fix> span) { spanLengths.push_back(span.size()); });
+    BOOST_CHECK( (spanLengths == std::vector<std::size_t>{5, TrackStore::chunkSize, 5}) );
+
+    const std::vector<Fix> fixes = snapshot.fixes(first, last);
+    BOOST_REQUIRE_EQUAL( fixes.size(), last - first );
+    BOOST_CHECK( isCountedFix(fixes.front(), first) );
+    BOOST_CHECK( isCountedFix(fixes.back(), last - 1) );
+
+    std::size_t visited = 0;
+    snapshot.forEach(n - 10, n + 10, [&](const Fix &) { ++visited; });
+    BOOST_CHECK_EQUAL( visited, 10 );
+}
+
+BOOST_AUTO_TEST_CASE( TimeRanges )
+{
+    TrackStore store;
+    for (std::size_t i = 0; i < 10000; ++i) store.append(countedFix(i));
+    // Several Fixes at the same time.
+    for (int i = 0; i < 3; ++i) store.append({Position(0, 0), 10000});
+    store.append({Position(0, 0), 10005});
+    const TrackSnapshot snapshot = store.snapshot();
+
+    using Range = std::pair<std::size_t, std::size_t>;
+    BOOST_CHECK( snapshot.indicesBetween(4095.5, 4100) == Range(4096, 4101) );
+    BOOST_CHECK( snapshot.indicesBetween(-5, 2) == Range(0, 3) );
+    BOOST_CHECK( snapshot.indicesBetween(10000, 10000) == Range(10000, 10003) );
+    BOOST_CHECK( snapshot.indicesBetween(10001, 10004).first == snapshot.indicesBetween(10001, 10004).second );
+    BOOST_CHECK( snapshot.indicesBetween(10004, 20000) == Range(10003, 10004) );
+    BOOST_CHECK( snapshot.indicesBetween(20000, 30000) == Range(10004, 10004) );
+    BOOST_CHECK( snapshot.indicesBetween(200, 100) == Range(0, 0) );
+}
+
+BOOST_AUTO_TEST_CASE( MidnightRollover )
+{
+    // Two and a half days of Fixes a minute apart, from 23:00, with times of day.
+    TrackStore store;
+    const std::size_t n = 60 * 60;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        BOOST_REQUIRE_NO_THROW( store.append({Position(0, 0), std::fmod(82800 + i * 60.0, 86400)}) );
+    }
+    const TrackSnapshot snapshot = store.snapshot();
+    BOOST_REQUIRE_EQUAL( snapshot.size(), n );
+
+    bool increasing = true;
+    for (std::size_t i = 1; i < n; ++i) increasing = increasing && snapshot.trackTime(i) == snapshot.trackTime(i - 1) + 60;
+    BOOST_CHECK( increasing );
+    BOOST_CHECK_EQUAL( snapshot[60].time, 0 );
+    BOOST_CHECK_EQUAL( snapshot.trackTime(60), 86400 );
+
+    using Range = std::pair<std::size_t, std::size_t>;
+    // 00:00 to 01:00 on each of the next two days.
+    BOOST_CHECK( snapshot.indicesBetween(86400, 90000) == Range(60, 121) );
+    BOOST_CHECK( snapshot.indicesBetween(2 * 86400, 2 * 86400 + 3600) == Range(60 + 1440, 121 + 1440) );
+    // Across the first midnight.
+    BOOST_CHECK( snapshot.indicesBetween(86100, 86700) == Range(55, 66) );
+}
+
+BOOST_AUTO_TEST_CASE( ConcurrentReaders )
+{
+    const std::size_t n = TrackStore::chunkSize * 100;
+    TrackStore store;
+    std::atomic<bool> failed {false};
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 3; ++r)
+    {
+        readers.emplace_back([&]
+        {
+            std::size_t previousSize = 0;
+            while (previousSize < n)
+            {
+                const TrackSnapshot snapshot = store.snapshot();
+                if (snapshot.size() < previousSize) failed = true;
+                // Every published Fix is complete, including the newest.
+                if (!snapshot.empty() && !isCountedFix(snapshot[snapshot.size() - 1], snapshot.size() - 1)) failed = true;
+                if (snapshot.size() > 0 && !isCountedFix(snapshot[snapshot.size() / 2], snapshot.size() / 2)) failed = true;
+                previousSize = snapshot.size();
+            }
+        });
+    }
+    for (std::size_t i = 0; i < n; ++i) store.append(countedFix(i));
+    for (std::thread & reader : readers) reader.join();
+
+    BOOST_CHECK( !failed );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
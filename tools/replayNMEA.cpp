@@ -0,0 +1,99 @@
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include "earth.h"
+#include "replay.h"
+
+/* Streams NMEA traffic to standard output (e.g. a pipe) or a UDP destination, at a
+ * controlled rate, for load-testing parsers.
+ *
+ *   replayNMEA [options] LOGFILE     replays the sentences of a log
+ *   replayNMEA [options] --synthetic generates a synthetic drive around CliftonCampus
+ *
+ * Options:
+ *   --rate N         sentences per second (default: as fast as possible)
+ *   --count N        stop after N sentences
+ *   --repeat N       replay the log N times (default 1)
+ *   --udp ADDR:PORT  send UDP datagrams to an IPv4 address instead of writing to stdout
+ *   --datagram N     pack sentences into datagrams of at most N bytes (0: one per sentence)
+ *
+ * A summary is written to standard error.
+ */
+namespace
+{
+  [[noreturn]] void usage(const char * message)
+  {
+      std::fprintf(stderr, "replayNMEA: %s\n"
+                           "usage: replayNMEA [--rate N] [--count N] [--repeat N] [--udp ADDR:PORT] [--datagram N]"
+                           " (LOGFILE | --synthetic)\n", message);
+      std::exit(2);
+  }
+
+  std::string readFile(const std::string & path)
+  {
+      std::ifstream file{path, std::ios::binary};
+      if (!file.good()) throw std::invalid_argument("Could not open log file: " + path);
+      std::ostringstream contents;
+      contents << file.rdbuf();
+      return contents.str();
+  }
+}
+
+int main(int argc, char * argv[])
+{
+  NMEA::ReplayOptions options;
+  unsigned repeats = 1;
+  std::string udp, logFile;
+  std::size_t datagramBytes = 1472;
+  bool synthetic = false;
+
+  for (int i = 1; i < argc; ++i)
+  {
+      const std::string arg = argv[i];
+      auto value = [&]() -> std::string
+      {
+          if (i + 1 >= argc) usage(("missing value for " + arg).c_str());
+          return argv[++i];
+      };
+      try {
+          if (arg == "--rate") options.sentencesPerSecond = std::stod(value());
+          else if (arg == "--count") options.maxSentences = std::stoull(value());
+          else if (arg == "--repeat") repeats = static_cast<unsigned>(std::stoul(value()));
+          else if (arg == "--udp") udp = value();
+          else if (arg == "--datagram") datagramBytes = std::stoul(value());
+          else if (arg == "--synthetic") synthetic = true;
+          else if (!arg.empty() && arg[0] == '-') usage(("unknown option " + arg).c_str());
+          else logFile = arg;
+      }
+      catch (const std::logic_error &) {
+          usage(("invalid value for " + arg).c_str());
+      }
+  }
+  if (synthetic == !logFile.empty()) usage("give either a log file or --synthetic");
+
+  try {
+      const std::size_t colon = udp.rfind(':');
+      if (!udp.empty() && colon == std::string::npos) usage("--udp needs ADDR:PORT");
+      NMEA::ReplaySink sink = udp.empty()
+          ? NMEA::ReplaySink::toFileDescriptor(1)
+          : NMEA::ReplaySink::toUDP(udp.substr(0, colon), static_cast<std::uint16_t>(std::stoul(udp.substr(colon + 1))), datagramBytes);
+
+      const std::string log = synthetic ? std::string() : readFile(logFile);
+      const NMEA::SentenceSource source = synthetic
+          ? NMEA::syntheticSource(GPS::Earth::CliftonCampus, 500, 15, 10)
+          : NMEA::logSource(log, repeats);
+
+      const NMEA::ReplayStats stats = NMEA::replay(source, sink, options);
+      std::fprintf(stderr, "%llu sentences, %llu bytes in %.3f s (%.0f sentences/s)\n",
+                   stats.sentences, stats.bytes, stats.elapsed.count(), stats.sentences / stats.elapsed.count());
+  }
+  catch (const std::exception & e) {
+      std::fprintf(stderr, "replayNMEA: %s\n", e.what());
+      return 1;
+  }
+  return 0;
+}